@@ -0,0 +1,468 @@
+/**
+ * @file kernels.cpp
+ * @brief Micro-benchmarks of the solvers' hot kernels, each measured in isolation.
+ *
+ * Every kernel is run on random instances of several sizes: a warmup that also picks the number of
+ * operations per repetition, then a number of timed repetitions. The report gives the median and the
+ * fastest time per operation, the throughput, and the heap allocations per operation (counted by replacing
+ * the global operator new). The results can be saved as a JSON baseline and compared against one later;
+ * the program exits with status 1 when a kernel got slower or allocates more than the baseline allows.
+ */
+
+#include "Algorithms/BranchAndBound.h"
+#include "Algorithms/GeneticAlgo.h"
+#include "Algorithms/HeldKarpBatch.h"
+#include "Algorithms/TabuSearch.h"
+#include "lib/nlohmann/json.hpp"
+#include "logger.h"
+#include "matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<unsigned long long> allocationCount{0}; ///< Calls of operator new since the start.
+std::atomic<unsigned long long> allocatedBytes{0};  ///< Bytes requested from operator new since the start.
+volatile long long benchmarkSink = 0;               ///< Receives the kernels' results so the calls are not optimised away.
+
+} // namespace
+
+// The replacements pair operator new with malloc and operator delete with free on purpose, so every allocation
+// of the program is counted. GCC cannot see that the pairing is consistent once they are inlined into callers.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @struct BenchmarkOptions
+ * @brief Command-line settings.
+ */
+struct BenchmarkOptions {
+    std::vector<int> sizes{10, 50, 100, 250}; ///< Instance sizes.
+    int repetitions = 15;                     ///< Timed repetitions per kernel and size.
+    double warmupMs = 50;                     ///< Minimum warmup time per kernel and size.
+    double repetitionMs = 20;                 ///< Target duration of one repetition.
+    std::string filter;                       ///< Only kernels whose name contains this.
+    std::string jsonPath;                     ///< Where to write the results (empty for none).
+    std::string baselinePath;                 ///< Baseline to compare with (empty for none).
+    double threshold = 10;                    ///< Allowed slowdown against the baseline in percent.
+    unsigned int seed = 1;                    ///< Seed of the random instances.
+};
+
+/**
+ * @struct Measurement
+ * @brief Result of one kernel at one size.
+ */
+struct Measurement {
+    std::string kernel;      ///< Kernel name, e.g. "ga.calculatePathCost".
+    int size;                ///< Number of cities.
+    double nsPerOp;          ///< Median time per operation over the repetitions.
+    double minNsPerOp;       ///< Fastest repetition.
+    double opsPerSecond;     ///< Throughput at the median time.
+    double allocationsPerOp; ///< Heap allocations per operation.
+    double bytesPerOp;       ///< Heap bytes requested per operation.
+    long long opsPerRepetition; ///< Operations per timed repetition.
+};
+
+/**
+ * @class KernelBenchmark
+ * @brief Sets up the solvers' internal state and times their private kernels (it is their friend).
+ */
+class KernelBenchmark {
+public:
+    explicit KernelBenchmark(const BenchmarkOptions& options) : options(options) {}
+
+    /**
+     * @brief Runs every kernel at every size.
+     */
+    void run() {
+        std::cout << std::left << std::setw(28) << "kernel" << std::right << std::setw(6) << "n" << std::setw(14) << "ns/op"
+                  << std::setw(14) << "min ns/op" << std::setw(14) << "ops/s" << std::setw(12) << "allocs/op" << std::setw(12)
+                  << "bytes/op" << std::endl;
+        for (int size : options.sizes) {
+            Matrix matrix(0);
+            matrix.setCosts(size, randomCosts(size));
+            matrix.buildTransposed();
+            benchGenetic(matrix);
+            benchBranchAndBound(matrix);
+            benchTabu(matrix);
+            benchReadFromFile(matrix);
+            if (size <= HeldKarpBatch::MAX_SIZE) {
+                benchHeldKarpBatch(size);
+            }
+        }
+    }
+
+    /**
+     * @brief The measurements so far.
+     */
+    const std::vector<Measurement>& getResults() const { return results; }
+
+private:
+    const BenchmarkOptions& options;  ///< Settings.
+    std::vector<Measurement> results; ///< Measurements so far.
+
+    std::vector<int> randomCosts(int size) const {
+        std::mt19937 rng(options.seed + size);
+        std::uniform_int_distribution<int> cost(1, 1000);
+        std::vector<int> costs(static_cast<size_t>(size) * size);
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                costs[static_cast<size_t>(i) * size + j] = i == j ? 0 : cost(rng);
+            }
+        }
+        return costs;
+    }
+
+    /**
+     * @brief Runs operation(0 .. count - 1) and returns the elapsed milliseconds.
+     */
+    template <typename Operation>
+    static double timeBatch(Operation& operation, long long count) {
+        long long sink = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < count; ++i) {
+            sink += operation(i);
+        }
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        benchmarkSink = benchmarkSink + sink; // A volatile read and write the compiler cannot drop
+        return elapsed;
+    }
+
+    /**
+     * @brief Warms a kernel up, times its repetitions and records the measurement.
+     */
+    template <typename Operation>
+    void measure(const std::string& kernel, int size, Operation operation) {
+        if (!options.filter.empty() && kernel.find(options.filter) == std::string::npos) {
+            return;
+        }
+
+        // The warmup grows the batch until one batch lasts about repetitionMs
+        long long batch = 1;
+        std::chrono::steady_clock::time_point warmupStart = std::chrono::steady_clock::now();
+        for (;;) {
+            double elapsed = timeBatch(operation, batch);
+            bool warm = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - warmupStart).count() >= options.warmupMs;
+            if (elapsed >= options.repetitionMs * 0.9) {
+                if (warm) break;
+                continue;
+            }
+            batch = elapsed <= 0.01 ? batch * 10 : std::max(batch + 1, static_cast<long long>(batch * options.repetitionMs / elapsed));
+        }
+
+        std::vector<double> nsPerOp;
+        unsigned long long allocationsBefore = allocationCount.load(), bytesBefore = allocatedBytes.load();
+        for (int r = 0; r < options.repetitions; ++r) {
+            nsPerOp.push_back(timeBatch(operation, batch) * 1e6 / batch);
+        }
+        double operations = static_cast<double>(batch) * options.repetitions;
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+
+        Measurement measurement;
+        measurement.kernel = kernel;
+        measurement.size = size;
+        measurement.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+        measurement.minNsPerOp = nsPerOp.front();
+        measurement.opsPerSecond = 1e9 / measurement.nsPerOp;
+        measurement.allocationsPerOp = (allocationCount.load() - allocationsBefore) / operations;
+        measurement.bytesPerOp = (allocatedBytes.load() - bytesBefore) / operations;
+        measurement.opsPerRepetition = batch;
+        results.push_back(measurement);
+
+        std::cout << std::left << std::setw(28) << kernel << std::right << std::setw(6) << size << std::fixed << std::setprecision(1)
+                  << std::setw(14) << measurement.nsPerOp << std::setw(14) << measurement.minNsPerOp << std::setprecision(0)
+                  << std::setw(14) << measurement.opsPerSecond << std::setprecision(2) << std::setw(12) << measurement.allocationsPerOp
+                  << std::setprecision(1) << std::setw(12) << measurement.bytesPerOp << std::endl;
+    }
+
+    void benchGenetic(const Matrix& matrix) {
+        nlohmann::json config = {{"geneticAlgorithmConfiguration",
+                                  {{"crossingSegmentSizeRate", 40}, {"mutationSegmentSizeRate", 40}, {"mutationType", "i"},
+                                   {"populationSize", 100}, {"iterationNum", 1}, {"mutationRate", 20}, {"randomRate", 30},
+                                   {"randomRateNewGen", 20}}}};
+        GeneticAlgorithm ga(matrix, config, options.seed);
+        int length = matrix.getSize() - 1;
+        int population = ga.populationSize;
+        ga.generateOffspring(length); // Fills the offspring buffers that selection() ranks
+
+        measure("ga.calculatePathCost", matrix.getSize(), [&](long long i) { return ga.calculatePathCost(ga.population[i % population]); });
+        measure("ga.performCrossing", matrix.getSize(), [&](long long i) {
+            ga.performCrossing(static_cast<int>(i % population), static_cast<int>((i * 7 + 3) % population), 0, length, ga.crossingSegmentSizeRate);
+            return ga.offspringPopulation[0][0];
+        });
+        std::vector<int> chromosome(ga.population[0], ga.population[0] + length);
+        measure("ga.inversionMutation", matrix.getSize(), [&](long long) {
+            ga.performInversionMutation(chromosome.data(), length, ga.mutationSegmentSizeRate);
+            return chromosome[0];
+        });
+        measure("ga.shuffleMutation", matrix.getSize(), [&](long long) {
+            ga.performShuffleMutation(chromosome.data(), length, ga.mutationSegmentSizeRate);
+            return chromosome[0];
+        });
+        measure("ga.selection", matrix.getSize(), [&](long long) {
+            ga.selection(length);
+            return ga.population[0][0];
+        });
+    }
+
+    void benchBranchAndBound(const Matrix& matrix) {
+        BranchAndBound bnb(matrix);
+        BranchAndBound::Subproblem root(matrix.getSize());
+        measure("bnb.calculateLowerBound", matrix.getSize(), [&](long long) { return bnb.calculateLowerBound(root); });
+    }
+
+    void benchTabu(const Matrix& matrix) {
+        const int tabuSize = 50;
+        TabuSearch tabu(matrix, tabuSize, 1000, options.seed);
+        std::vector<std::pair<int, int>> moves;
+        for (int i = 1; i < matrix.getSize() - 1; ++i) {
+            for (int j = i + 1; j < matrix.getSize(); ++j) {
+                moves.emplace_back(i, j);
+            }
+        }
+        for (int k = 0; k < tabuSize; ++k) {
+            const std::pair<int, int>& move = moves[(k * 31) % moves.size()];
+            tabu.updateTabuList(move.first, move.second); // A full list, as during the search
+        }
+        long long currentCost = tabu.calculateCost(tabu.currentPath);
+
+        measure("tabu.isTabu", matrix.getSize(), [&](long long i) {
+            const std::pair<int, int>& move = moves[i % moves.size()];
+            return static_cast<int>(tabu.isTabu(move.first, move.second));
+        });
+        measure("tabu.evaluateMove", matrix.getSize(), [&](long long i) {
+            const std::pair<int, int>& move = moves[i % moves.size()];
+            long long bestNeighborCost = LLONG_MAX;
+            int bestMove[2] = {-1, -1};
+            tabu.evaluateMove(move.first, move.second, currentCost, bestNeighborCost, bestMove);
+            return bestMove[0];
+        });
+    }
+
+    /**
+     * @brief Checks one group of the batch solver against Branch and Bound, then times it (one operation solves LANES instances).
+     *
+     * Every other instance has edge weights close to Matrix::FORBIDDEN_COST, so its optimal tour costs many times
+     * the sentinel although it uses no forbidden edge.
+     * @throws std::runtime_error If a cost differs from Branch and Bound's.
+     */
+    void benchHeldKarpBatch(int size) {
+        const int count = HeldKarpBatch::LANES;
+        size_t cells = static_cast<size_t>(size) * size;
+        std::mt19937 rng(options.seed + size);
+        std::uniform_int_distribution<int> small(1, 1000), large(Matrix::FORBIDDEN_COST / 2, Matrix::FORBIDDEN_COST - 1);
+        std::vector<int> costs(count * cells);
+        for (int k = 0; k < count; ++k) {
+            for (size_t cell = 0; cell < cells; ++cell) {
+                costs[k * cells + cell] = cell % (size + 1) == 0 ? 0 : (k % 2 == 1 ? large(rng) : small(rng));
+            }
+        }
+        std::vector<int> tourCosts(count), tours(count * size);
+        HeldKarpBatch batch(size);
+        batch.solve(costs.data(), count, tourCosts.data(), tours.data());
+
+        for (int k = 0; k < count; ++k) {
+            Matrix instance(0);
+            instance.setCosts(size, std::vector<int>(costs.begin() + k * cells, costs.begin() + (k + 1) * cells));
+            BranchAndBound bnb(instance);
+            bnb.runBranchAndBound();
+            if (bnb.getBestCost() != tourCosts[k]) {
+                throw std::runtime_error("Batch solver returned " + std::to_string(tourCosts[k]) + " for instance " + std::to_string(k) +
+                                         " of size " + std::to_string(size) + ", Branch and Bound " + std::to_string(bnb.getBestCost()));
+            }
+        }
+
+        measure("batch.solveGroup", size, [&](long long) {
+            batch.solve(costs.data(), count, tourCosts.data(), tours.data());
+            return tourCosts[0];
+        });
+    }
+
+    void benchReadFromFile(const Matrix& matrix) {
+        std::string path = (std::filesystem::temp_directory_path() / ("atsp_bench_" + std::to_string(matrix.getSize()) + ".txt")).string();
+        {
+            std::ofstream file(path);
+            file << matrix.getSize() << "\n";
+            for (int i = 0; i < matrix.getSize(); ++i) {
+                for (int j = 0; j < matrix.getSize(); ++j) {
+                    file << matrix.getCost(i, j) << (j + 1 < matrix.getSize() ? " " : "\n");
+                }
+            }
+        }
+        measure("matrix.readFromFile", matrix.getSize(), [&](long long) {
+            Matrix loaded(0);
+            loaded.readFromFile(path);
+            return loaded.getSize();
+        });
+        std::remove(path.c_str());
+    }
+};
+
+namespace {
+
+void writeJson(const std::string& path, const std::vector<Measurement>& results, const BenchmarkOptions& options) {
+    nlohmann::json json = {{"version", 1}, {"repetitions", options.repetitions}, {"seed", options.seed}, {"results", nlohmann::json::array()}};
+    for (const Measurement& m : results) {
+        json["results"].push_back({{"kernel", m.kernel}, {"n", m.size}, {"nsPerOp", m.nsPerOp}, {"minNsPerOp", m.minNsPerOp},
+                                   {"opsPerSecond", m.opsPerSecond}, {"allocationsPerOp", m.allocationsPerOp},
+                                   {"bytesPerOp", m.bytesPerOp}, {"opsPerRepetition", m.opsPerRepetition}});
+    }
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not write " + path);
+    }
+    file << json.dump(2) << std::endl;
+}
+
+/**
+ * @brief Compares the results with a baseline file and prints the differences.
+ *
+ * @return The number of regressions: kernels more than threshold percent slower (by median), or allocating more.
+ */
+int compareWithBaseline(const std::string& path, const std::vector<Measurement>& results, double threshold) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open baseline " + path);
+    }
+    nlohmann::json baseline = nlohmann::json::parse(file);
+    std::map<std::pair<std::string, int>, nlohmann::json> entries;
+    for (const nlohmann::json& entry : baseline.at("results")) {
+        entries[{entry.at("kernel").get<std::string>(), entry.at("n").get<int>()}] = entry;
+    }
+
+    int regressions = 0;
+    std::cout << "\nComparison with " << path << " (threshold " << threshold << "%)" << std::endl;
+    for (const Measurement& m : results) {
+        auto it = entries.find({m.kernel, m.size});
+        if (it == entries.end()) {
+            std::cout << std::left << std::setw(28) << m.kernel << std::right << std::setw(6) << m.size << "  not in baseline" << std::endl;
+            continue;
+        }
+        double baseNs = it->second.at("nsPerOp").get<double>();
+        double baseAllocations = it->second.at("allocationsPerOp").get<double>();
+        double change = (m.nsPerOp / baseNs - 1) * 100;
+        bool slower = change > threshold;
+        bool allocates = m.allocationsPerOp > baseAllocations + 0.01; // Allocation counts are deterministic up to rounding
+        regressions += slower || allocates;
+        std::cout << std::left << std::setw(28) << m.kernel << std::right << std::setw(6) << m.size << std::fixed << std::setprecision(1)
+                  << std::setw(10) << std::showpos << change << "%" << std::noshowpos << std::setprecision(2) << "  allocs "
+                  << baseAllocations << " -> " << m.allocationsPerOp << (slower ? "  SLOWER" : "") << (allocates ? "  MORE ALLOCATIONS" : "")
+                  << std::endl;
+    }
+    return regressions;
+}
+
+std::vector<int> parseSizes(const std::string& list) {
+    std::vector<int> sizes;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int size = std::stoi(item);
+        if (size < 3) {
+            throw std::invalid_argument("Sizes must be at least 3");
+        }
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--sizes" && hasValue) {
+                options.sizes = parseSizes(argv[++i]);
+            } else if (argument == "--repetitions" && hasValue) {
+                options.repetitions = std::max(1, std::stoi(argv[++i]));
+            } else if (argument == "--warmup-ms" && hasValue) {
+                options.warmupMs = std::stod(argv[++i]);
+            } else if (argument == "--repetition-ms" && hasValue) {
+                options.repetitionMs = std::max(0.1, std::stod(argv[++i]));
+            } else if (argument == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            } else if (argument == "--json" && hasValue) {
+                options.jsonPath = argv[++i];
+            } else if (argument == "--baseline" && hasValue) {
+                options.baselinePath = argv[++i];
+            } else if (argument == "--threshold" && hasValue) {
+                options.threshold = std::stod(argv[++i]);
+            } else if (argument == "--seed" && hasValue) {
+                options.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--sizes 10,50,100,250] [--repetitions 15] [--warmup-ms 50] [--repetition-ms 20] [--filter text]"
+                             " [--json out.json] [--baseline baseline.json] [--threshold 10] [--seed 1]"
+                          << std::endl;
+                return 2;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+
+    Logger::instance().setLevel(LogLevel::Warning); // The solvers' constructors log at info level
+
+    try {
+        KernelBenchmark benchmark(options);
+        benchmark.run();
+        if (!options.jsonPath.empty()) {
+            writeJson(options.jsonPath, benchmark.getResults(), options);
+            std::cout << "Results written to " << options.jsonPath << std::endl;
+        }
+        if (!options.baselinePath.empty()) {
+            int regressions = compareWithBaseline(options.baselinePath, benchmark.getResults(), options.threshold);
+            if (regressions > 0) {
+                std::cout << regressions << " regression(s) against the baseline" << std::endl;
+                return 1;
+            }
+            std::cout << "No regressions against the baseline" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
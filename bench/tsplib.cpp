@@ -0,0 +1,421 @@
+/**
+ * @file tsplib.cpp
+ * @brief Quality and time regression benchmark of the solvers on the TSPLIB ATSP instances.
+ *
+ * Every solver runs on every instance with a known optimum (best_known.h) once per seed, with a time limit.
+ * Per instance and solver it reports the gap to the optimum, the time to reach a target gap
+ * (time-to-target) and the time of the last improvement (time-to-best), as means with 95% confidence
+ * intervals over the seeds. The results can be saved as a JSON baseline; a later run compared against it
+ * exits with status 1 when a solver's gap or time-to-target got worse by more than the thresholds.
+ */
+
+#include "Algorithms/GeneticAlgo.h"
+#include "Algorithms/Solver.h"
+#include "best_known.h"
+#include "incumbent.h"
+#include "lib/nlohmann/json.hpp"
+#include "logger.h"
+#include "matrix.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RegressionOptions
+ * @brief Command-line settings.
+ */
+struct RegressionOptions {
+    std::vector<std::string> dataDirectories;          ///< Directories with the instances.
+    std::vector<std::string> solvers;                  ///< Solvers to run (empty = every registered one).
+    std::map<std::string, nlohmann::json> parameters;  ///< Parameters per solver.
+    std::string gaConfigPath = "config/ga_config.json"; ///< GA configuration file.
+    std::string filter;                                ///< Only instances whose name contains this.
+    int seeds = 3;                                     ///< Runs per instance and solver, with seeds 1..seeds.
+    double timeLimitSeconds = 2;                       ///< Time limit per run.
+    double targetGap = 1;                              ///< Gap in percent that counts as reaching the target.
+    int candidateListSize = 0;                         ///< Candidate lists the instances are prepared with.
+    std::string jsonPath;                              ///< Where to write the results (empty for none).
+    std::string baselinePath;                          ///< Baseline to compare with (empty for none).
+    double gapThreshold = 0.5;                         ///< Allowed increase of the mean gap in percentage points.
+    double timeThreshold = 25;                         ///< Allowed increase of the mean time-to-target in percent.
+    double timeFloorMs = 10;                           ///< Time-to-target changes below this are ignored as noise.
+};
+
+/**
+ * @struct Interval
+ * @brief Mean with the half-width of its 95% confidence interval.
+ */
+struct Interval {
+    double mean = 0;      ///< Sample mean.
+    double halfWidth = 0; ///< t quantile times the standard error (0 for fewer than two samples).
+};
+
+/**
+ * @struct Summary
+ * @brief Results of one solver on one instance over all seeds.
+ */
+struct Summary {
+    std::string instance; ///< Instance name.
+    std::string solver;   ///< Solver name.
+    int size = 0;         ///< Number of cities.
+    int bestKnown = 0;    ///< Optimal cost.
+    int runs = 0;         ///< Runs (seeds).
+    Interval gap;         ///< Gap to the optimum in percent.
+    double minGap = 0;    ///< Best gap over the seeds.
+    int reached = 0;      ///< Runs that reached the target gap.
+    Interval timeToTarget; ///< Milliseconds until the target gap was reached, over the runs that reached it.
+    Interval timeToBest;  ///< Milliseconds until the final tour was found.
+    int timedOut = 0;     ///< Runs stopped by the time limit.
+};
+
+namespace {
+
+Interval meanInterval(const std::vector<double>& values) {
+    // Two-sided 97.5% quantiles of Student's t distribution for 1..30 degrees of freedom
+    static const double T_QUANTILES[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                         2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                         2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    Interval interval;
+    if (values.empty()) {
+        return interval;
+    }
+    for (double value : values) {
+        interval.mean += value;
+    }
+    interval.mean /= values.size();
+    if (values.size() > 1) {
+        double squares = 0;
+        for (double value : values) {
+            squares += (value - interval.mean) * (value - interval.mean);
+        }
+        size_t degrees = values.size() - 1;
+        double t = degrees <= 30 ? T_QUANTILES[degrees - 1] : 1.96;
+        interval.halfWidth = t * std::sqrt(squares / degrees / values.size());
+    }
+    return interval;
+}
+
+std::string formatInterval(const Interval& interval, int precision) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(precision) << interval.mean << " ±" << interval.halfWidth;
+    return text.str();
+}
+
+nlohmann::json intervalJson(const Interval& interval) {
+    return {{"mean", interval.mean}, {"ci95", interval.halfWidth}};
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+/**
+ * @brief Default parameters: the repository's configuration for Tabu Search and the GA, solver defaults otherwise.
+ */
+nlohmann::json defaultParameters(const std::string& solver, const RegressionOptions& options) {
+    if (options.parameters.count(solver)) {
+        return options.parameters.at(solver);
+    }
+    if (solver == "tabu") {
+        return {{"tabuSize", 55}, {"maxIterations", 100000}};
+    }
+    if (solver == "ga") {
+        return GeneticAlgorithm::readConfigFile(options.gaConfigPath);
+    }
+    if (solver == "portfolio") {
+        return {{"solvers", {"bnb", "tabu", "ga"}}, {"tabu", defaultParameters("tabu", options)}, {"ga", defaultParameters("ga", options)}};
+    }
+    return nlohmann::json::object();
+}
+
+/**
+ * @brief Runs every seed of one solver on one instance.
+ */
+Summary runSolver(const Matrix& matrix, const std::string& instance, int bestKnown, const std::string& solver,
+                  const nlohmann::json& parameters, const RegressionOptions& options, nlohmann::json& runs) {
+    Summary summary;
+    summary.instance = instance;
+    summary.solver = solver;
+    summary.size = matrix.getSize();
+    summary.bestKnown = bestKnown;
+    summary.runs = options.seeds;
+    long long target = static_cast<long long>(std::floor(bestKnown * (1 + options.targetGap / 100)));
+
+    std::vector<double> gaps, timesToTarget, timesToBest;
+    for (int seed = 1; seed <= options.seeds; ++seed) {
+        // Improvements are timed through the incumbent; solvers that only report at the end get their total time
+        SharedIncumbent incumbent;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&] { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
+        int lastCost = INT_MAX;
+        double timeToBest = 0, timeToTarget = -1;
+        incumbent.setListener([&](int cost, const std::vector<int>&, const std::string&) {
+            double now = elapsedMs();
+            lastCost = cost;
+            timeToBest = now;
+            if (timeToTarget < 0 && cost <= target) timeToTarget = now;
+        });
+
+        SolveRequest request;
+        request.matrix = &matrix;
+        request.parameters = parameters;
+        request.seed = static_cast<unsigned int>(seed);
+        request.incumbent = &incumbent;
+        request.deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.timeLimitSeconds));
+        SolveResult result = SolverRegistry::instance().create(solver)->solve(request);
+        double total = elapsedMs();
+        if (result.cost < lastCost) {
+            timeToBest = total;
+            if (timeToTarget < 0 && result.cost <= target) timeToTarget = total;
+        }
+
+        double gap = result.cost == INT_MAX ? 100.0 * Matrix::FORBIDDEN_COST / bestKnown : gapPercent(result.cost, bestKnown);
+        gaps.push_back(gap);
+        timesToBest.push_back(timeToBest);
+        if (timeToTarget >= 0) {
+            timesToTarget.push_back(timeToTarget);
+        }
+        summary.timedOut += result.timedOut;
+        runs.push_back({{"instance", instance}, {"solver", solver}, {"seed", seed}, {"cost", result.cost == INT_MAX ? nlohmann::json() : nlohmann::json(result.cost)},
+                        {"gap", gap}, {"timeToTargetMs", timeToTarget >= 0 ? nlohmann::json(timeToTarget) : nlohmann::json()},
+                        {"timeToBestMs", timeToBest}, {"totalMs", total}, {"timedOut", result.timedOut}});
+    }
+
+    summary.gap = meanInterval(gaps);
+    summary.minGap = *std::min_element(gaps.begin(), gaps.end());
+    summary.reached = static_cast<int>(timesToTarget.size());
+    summary.timeToTarget = meanInterval(timesToTarget);
+    summary.timeToBest = meanInterval(timesToBest);
+    return summary;
+}
+
+void printSummary(const Summary& s) {
+    std::cout << std::left << std::setw(10) << s.instance << std::right << std::setw(5) << s.size << std::setw(8) << s.bestKnown << "  "
+              << std::left << std::setw(10) << s.solver << std::right << std::setw(18) << formatInterval(s.gap, 2) << std::setw(9)
+              << std::fixed << std::setprecision(2) << s.minGap << std::setw(5) << s.reached << "/" << std::left << std::setw(3) << s.runs
+              << std::right << std::setw(20) << (s.reached > 0 ? formatInterval(s.timeToTarget, 1) : std::string("-")) << std::setw(20)
+              << formatInterval(s.timeToBest, 1) << std::setw(5) << s.timedOut << std::endl;
+}
+
+/**
+ * @brief Compares the summaries with a baseline file and prints the differences.
+ *
+ * @return The number of regressions.
+ */
+int compareWithBaseline(const std::vector<Summary>& summaries, const RegressionOptions& options) {
+    std::ifstream file(options.baselinePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open baseline " + options.baselinePath);
+    }
+    nlohmann::json baseline = nlohmann::json::parse(file);
+    std::map<std::pair<std::string, std::string>, nlohmann::json> entries;
+    for (const nlohmann::json& entry : baseline.at("summaries")) {
+        entries[{entry.at("instance").get<std::string>(), entry.at("solver").get<std::string>()}] = entry;
+    }
+
+    int regressions = 0;
+    std::cout << "\nComparison with " << options.baselinePath << " (gap +" << options.gapThreshold << " points, time-to-target +"
+              << options.timeThreshold << "%)" << std::endl;
+    for (const Summary& s : summaries) {
+        auto it = entries.find({s.instance, s.solver});
+        if (it == entries.end()) {
+            continue;
+        }
+        const nlohmann::json& base = it->second;
+        double baseGap = base.at("gap").at("mean").get<double>();
+        int baseReached = base.at("reached").get<int>();
+        double baseTime = base.at("timeToTargetMs").at("mean").get<double>();
+
+        std::vector<std::string> problems;
+        if (s.gap.mean > baseGap + options.gapThreshold) {
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(2) << "gap " << baseGap << "% -> " << s.gap.mean << "%";
+            problems.push_back(text.str());
+        }
+        if (s.reached < baseReached) {
+            problems.push_back("target reached " + std::to_string(baseReached) + " -> " + std::to_string(s.reached) + " times");
+        } else if (baseReached > 0 && s.reached > 0 && s.timeToTarget.mean > baseTime * (1 + options.timeThreshold / 100) &&
+                   s.timeToTarget.mean - baseTime > options.timeFloorMs) {
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(1) << "time-to-target " << baseTime << " -> " << s.timeToTarget.mean << " ms";
+            problems.push_back(text.str());
+        }
+        if (!problems.empty()) {
+            ++regressions;
+            std::cout << "REGRESSION " << s.instance << " " << s.solver << ":";
+            for (const std::string& problem : problems) {
+                std::cout << " " << problem << ";";
+            }
+            std::cout << std::endl;
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    RegressionOptions options;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (argument == "--data" && hasValue) {
+                options.dataDirectories.push_back(argv[++i]);
+            } else if (argument == "--solvers" && hasValue) {
+                options.solvers = split(argv[++i]);
+            } else if (argument == "--parameters" && hasValue) {
+                std::string assignment = argv[++i];
+                size_t equals = assignment.find('=');
+                if (equals == std::string::npos) {
+                    throw std::invalid_argument("--parameters expects solver=json");
+                }
+                options.parameters[assignment.substr(0, equals)] = nlohmann::json::parse(assignment.substr(equals + 1));
+            } else if (argument == "--ga-config" && hasValue) {
+                options.gaConfigPath = argv[++i];
+            } else if (argument == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            } else if (argument == "--seeds" && hasValue) {
+                options.seeds = std::max(1, std::stoi(argv[++i]));
+            } else if (argument == "--time-limit" && hasValue) {
+                options.timeLimitSeconds = std::stod(argv[++i]);
+            } else if (argument == "--target-gap" && hasValue) {
+                options.targetGap = std::stod(argv[++i]);
+            } else if (argument == "--candidates" && hasValue) {
+                options.candidateListSize = std::stoi(argv[++i]);
+            } else if (argument == "--json" && hasValue) {
+                options.jsonPath = argv[++i];
+            } else if (argument == "--baseline" && hasValue) {
+                options.baselinePath = argv[++i];
+            } else if (argument == "--gap-threshold" && hasValue) {
+                options.gapThreshold = std::stod(argv[++i]);
+            } else if (argument == "--time-threshold" && hasValue) {
+                options.timeThreshold = std::stod(argv[++i]);
+            } else if (argument == "--time-floor-ms" && hasValue) {
+                options.timeFloorMs = std::stod(argv[++i]);
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--data dir]... [--solvers nn,tabu,...] [--parameters solver=json]... [--ga-config path]"
+                             " [--filter text] [--seeds 3] [--time-limit 2] [--target-gap 1] [--candidates k] [--json out.json]"
+                             " [--baseline baseline.json] [--gap-threshold 0.5] [--time-threshold 25] [--time-floor-ms 10]"
+                          << std::endl;
+                return 2;
+            }
+        }
+        if (!(options.timeLimitSeconds > 0)) {
+            throw std::invalid_argument("--time-limit must be positive");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    if (options.dataDirectories.empty()) {
+        options.dataDirectories = {"data/TSPLib_ATSP", "data/Archives"};
+    }
+    if (options.solvers.empty()) {
+        options.solvers = SolverRegistry::instance().names();
+    }
+
+    Logger::instance().setLevel(LogLevel::Warning); // The solvers log their settings at info level
+
+    try {
+        std::map<std::string, nlohmann::json> parameters;
+        for (const std::string& solver : options.solvers) {
+            if (!SolverRegistry::instance().contains(solver)) {
+                throw std::invalid_argument("Unknown solver '" + solver + "'");
+            }
+            parameters[solver] = defaultParameters(solver, options);
+        }
+
+        // Instances by name; the same instance in two directories runs once
+        std::map<std::string, std::string> instances;
+        for (const std::string& directory : options.dataDirectories) {
+            if (!std::filesystem::is_directory(directory)) {
+                throw std::runtime_error("No data directory " + directory + " (run from the repository root or pass --data)");
+            }
+            for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                std::string name = instanceName(entry.path().string());
+                if (entry.is_regular_file() && bestKnownCost(name) > 0 && name.find(options.filter) != std::string::npos) {
+                    instances.emplace(name, entry.path().string());
+                }
+            }
+        }
+        if (instances.empty()) {
+            throw std::runtime_error("No instance with a known optimum found");
+        }
+
+        std::cout << "TSPLIB regression: " << instances.size() << " instances, " << options.solvers.size() << " solvers, "
+                  << options.seeds << " seeds, " << options.timeLimitSeconds << " s per run, target gap " << options.targetGap << "%\n"
+                  << std::endl;
+        std::cout << std::left << std::setw(10) << "instance" << std::right << std::setw(5) << "n" << std::setw(8) << "opt" << "  "
+                  << std::left << std::setw(10) << "solver" << std::right << std::setw(18) << "gap % (95% CI)" << std::setw(9)
+                  << "min gap" << std::setw(9) << "target" << std::setw(20) << "TTT ms (95% CI)" << std::setw(20) << "TTB ms (95% CI)"
+                  << std::setw(5) << "t/o" << std::endl;
+
+        std::vector<Summary> summaries;
+        nlohmann::json runs = nlohmann::json::array();
+        for (const auto& instance : instances) {
+            Matrix matrix(0);
+            try {
+                matrix.readFromFile(instance.second);
+            } catch (const std::exception& e) {
+                std::cout << std::left << std::setw(10) << instance.first << " skipped: " << e.what() << std::endl;
+                continue;
+            }
+            matrix.buildTransposed();
+            if (options.candidateListSize > 0) {
+                matrix.buildCandidateLists(options.candidateListSize);
+            }
+            for (const std::string& solver : options.solvers) {
+                summaries.push_back(runSolver(matrix, instance.first, bestKnownCost(instance.first), solver, parameters[solver], options, runs));
+                printSummary(summaries.back());
+            }
+        }
+
+        if (!options.jsonPath.empty()) {
+            nlohmann::json json = {{"version", 1}, {"seeds", options.seeds}, {"timeLimitSeconds", options.timeLimitSeconds},
+                                   {"targetGap", options.targetGap}, {"summaries", nlohmann::json::array()}, {"runs", runs}};
+            for (const Summary& s : summaries) {
+                json["summaries"].push_back({{"instance", s.instance}, {"solver", s.solver}, {"size", s.size}, {"bestKnown", s.bestKnown},
+                                             {"runs", s.runs}, {"gap", intervalJson(s.gap)}, {"minGap", s.minGap}, {"reached", s.reached},
+                                             {"timeToTargetMs", intervalJson(s.timeToTarget)}, {"timeToBestMs", intervalJson(s.timeToBest)},
+                                             {"timedOut", s.timedOut}});
+            }
+            std::ofstream file(options.jsonPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Could not write " + options.jsonPath);
+            }
+            file << json.dump(2) << std::endl;
+            std::cout << "\nResults written to " << options.jsonPath << std::endl;
+        }
+        if (!options.baselinePath.empty()) {
+            int regressions = compareWithBaseline(summaries, options);
+            if (regressions > 0) {
+                std::cout << regressions << " regression(s) against the baseline" << std::endl;
+                return 1;
+            }
+            std::cout << "No regressions against the baseline" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
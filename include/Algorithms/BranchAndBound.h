@@ -1,22 +1,46 @@
 #ifndef BRANCHANDBOUND_H
 #define BRANCHANDBOUND_H
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <chrono>
+#include <string>
 #include "../matrix.h"
 #include "../node.h"
+#include "../checkpoint.h"
+#include "../incumbent.h"
+#include "../search_counters.h"
 
 /**
  * @class BranchAndBound
  * @brief Class implementing the Branch and Bound algorithm for solving the Traveling Salesman Problem (TSP).
  */
 class BranchAndBound {
+    friend class KernelBenchmark; // bench/kernels.cpp times the private kernels
+
 private:
     const Matrix& matrix; ///< The distance matrix.
     int bestCost; ///< The best cost found during the search.
     std::vector<int> bestPath; ///< The best path found during the search.
 
+    Checkpointer* checkpointer; ///< Checkpoint writer (nullptr if disabled).
+
+    std::string checkpointRun;  ///< Run identifier appended to the checkpoint file name.
+    std::string checkpointPath; ///< Checkpoint file of the current run.
+    std::chrono::steady_clock::time_point lastCheckpoint; ///< Time of the last checkpoint of this run.
+    unsigned long long nodeCount; ///< Number of processed subproblems, also used to throttle clock reads.
+    SearchCounters counters; ///< Nodes expanded and pruned by the last run.
+    std::chrono::steady_clock::time_point deadline; ///< The search stops once this passes.
+    bool stopped; ///< Set when the search stopped at the deadline.
+    int rootBound; ///< Lower bound of the root subproblem.
+    SharedIncumbent* incumbent; ///< Tour shared with concurrent solvers (nullptr if running alone).
+    std::vector<int> branchStack; ///< Index of the branch taken at each depth of the current subproblem.
+    std::vector<int> resumeStack; ///< Branch indices restored from a checkpoint.
+    bool resuming; ///< Whether the search is still descending to the restored subproblem.
+
     /**
      * @class Subproblem
      * @brief Class representing a subproblem in the Branch and Bound algorithm.
@@ -44,6 +68,42 @@ private:
      */
     int calculateLowerBound(const Subproblem& subproblem) const;
 
+    /**
+     * @brief Calculate the cheapest edge leaving a city.
+     * 
+     * @param city The city.
+     * @return int The minimum cost from city to any other city.
+     */
+    int minOutgoingCost(int city) const;
+
+    /**
+     * @brief Calculate the cheapest edge entering a city.
+     * 
+     * @param city The city.
+     * @return int The minimum cost from any other city to city.
+     */
+    int minIncomingCost(int city) const;
+
+    /**
+     * @brief Check whether a subproblem is the mirrored duplicate of another tour on a symmetric instance.
+     * 
+     * A tour and its reverse cost the same when the matrix is symmetric, so only tours whose
+     * last city has a larger index than the second one are explored.
+     * 
+     * @param subproblem The subproblem to check.
+     * @return bool True if every completion of the subproblem is a mirrored duplicate.
+     */
+    bool isMirroredDuplicate(const Subproblem& subproblem) const;
+
+    /**
+     * @brief Cost a subproblem's bound must stay below to be explored.
+     * 
+     * @return int The cheaper of the own best tour and the shared incumbent.
+     */
+    int pruningBound() const {
+        return incumbent != nullptr ? std::min(bestCost, incumbent->getCost()) : bestCost;
+    }
+
     /**
      * @brief Process a given subproblem.
      * 
@@ -55,6 +115,28 @@ private:
      */
     void processSubproblem(Subproblem& subproblem);
 
+    /**
+     * @brief Queue a checkpoint of the incumbent and the current search position.
+     * 
+     * The depth-first search explores branches in index order, so the branch indices leading to the current
+     * subproblem describe the whole frontier: everything before them is done, everything after is pending.
+     */
+    void saveCheckpoint();
+
+    /**
+     * @brief Format the settings that decide the branch order, for the checkpoint's parameter hash.
+     *
+     * @return std::string The settings as "name=value" pairs.
+     */
+    std::string checkpointParameters() const;
+
+    /**
+     * @brief Restore the incumbent and search position saved by saveCheckpoint().
+     * 
+     * @return bool False if there is no usable checkpoint for this instance and configuration.
+     */
+    bool loadCheckpoint();
+
 public:
     /**
      * @brief Constructor for the BranchAndBound class.
@@ -68,10 +150,100 @@ public:
      */
     void runBranchAndBound();
 
+    /**
+     * @brief Use a known tour as the initial incumbent, so that pruning starts at the root.
+     * 
+     * The tour is only kept if it is cheaper than the current incumbent and costs less than Matrix::FORBIDDEN_COST,
+     * so a heuristic tour through a missing edge never becomes the incumbent.
+     * 
+     * @param tour The visiting order of all cities without the return to the start; it may start at any city.
+     * @throws std::invalid_argument If the tour is not a permutation of the cities.
+     */
+    void setInitialTour(const std::vector<int>& tour);
+
+    /**
+     * @brief Compute an initial incumbent with a nearest neighbour tour improved by a short Tabu Search.
+     * 
+     * @param iterations Tabu Search iterations (0 keeps the plain nearest neighbour tour).
+     * @param tabuSize Size of the tabu list.
+     * @param seed Seed of the Tabu Search.
+     * @return int The cost of the initial incumbent (INT_MAX if the heuristics only found tours through missing edges).
+     */
+    int warmStart(int iterations, int tabuSize, unsigned int seed);
+
+    /**
+     * @brief Enable periodic checkpoints and resuming from an existing checkpoint.
+     * 
+     * @param checkpointer The checkpoint writer, or nullptr to disable checkpoints.
+     * @param run Identifies the run when several runs of the solver share an instance (e.g. "s2").
+     */
+    void setCheckpointer(Checkpointer* checkpointer, const std::string& run = "");
+
+    /**
+     * @brief Stop the search at a point in time, keeping the best tour found so far.
+     * 
+     * With checkpoints enabled, the position at the deadline is saved so that a later run can resume from it.
+     * 
+     * @param deadline The deadline.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Share tours with solvers running concurrently on the same instance.
+     * 
+     * Subproblems are pruned against the cheaper of the own best tour and the shared incumbent, own
+     * improvements are published, and the search stops like at a deadline once the incumbent is cancelled.
+     * 
+     * @param incumbent The shared incumbent, or nullptr to run alone.
+     */
+    void setIncumbent(SharedIncumbent* incumbent);
+
+    /**
+     * @brief Check whether the last run explored the whole search tree.
+     * 
+     * @return bool False if the run stopped at the deadline or was cancelled.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Get the best proven lower bound on the optimal cost.
+     * 
+     * @return int The optimal cost after a complete run (which may be the shared incumbent's), otherwise the bound of the root subproblem.
+     */
+    int getLowerBound() const;
+
+    /**
+     * @brief Get the number of subproblems processed by the last run.
+     * 
+     * @return unsigned long long The node count.
+     */
+    unsigned long long getNodeCount() const;
+
+    /**
+     * @brief Get the search counters of the last run.
+     * 
+     * @return const SearchCounters& The counters.
+     */
+    const SearchCounters& getSearchCounters() const;
+
     /**
      * @brief Print the best solution found by the Branch and Bound algorithm.
      */
     void printSolution() const;
+
+    /**
+     * @brief Get the cost of the best tour found.
+     *
+     * @return int The best cost.
+     */
+    int getBestCost() const;
+
+    /**
+     * @brief Get the best tour found.
+     *
+     * @return const std::vector<int>& The visiting order, ending with the return to the start city.
+     */
+    const std::vector<int>& getBestPath() const;
 };
 
 #endif // BRANCHANDBOUND_H
\ No newline at end of file
@@ -2,10 +2,13 @@
 #define BRUTEFORCE_H
 #define INF 9999  // Define infinity as 9999
 
+#include <chrono>
 #include <iostream>
 #include <limits>
+#include <vector>
 #include "../matrix.h"
 #include "../node.h"
+#include "../incumbent.h"
 
 /**
  * @class BruteForce
@@ -30,17 +33,65 @@ public:
      */
     void runBruteForce();
 
+    /**
+     * @brief Stop the enumeration at a point in time, keeping the best tour found so far.
+     * 
+     * @param deadline The deadline.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Share tours with solvers running concurrently on the same instance.
+     * 
+     * Improvements are published to the incumbent and the run stops like at a deadline once it is cancelled.
+     * 
+     * @param incumbent The shared incumbent, or nullptr to run alone.
+     */
+    void setIncumbent(SharedIncumbent* incumbent);
+
+    /**
+     * @brief Check whether the last run enumerated every tour.
+     * 
+     * @return bool False if the run stopped at the deadline.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Get the number of complete tours evaluated by the last run.
+     * 
+     * @return unsigned long long The tour count.
+     */
+    unsigned long long getTourCount() const;
+
     /**
      * @brief Print the best solution found by the Brute Force algorithm.
      */
     void printSolution() const;
 
+    /**
+     * @brief Get the cost of the best tour found.
+     *
+     * @return int The best cost.
+     */
+    int getBestCost() const;
+
+    /**
+     * @brief Get the best tour found.
+     *
+     * @return std::vector<int> The visiting order of all cities, without the return to the start.
+     */
+    std::vector<int> getBestPath() const;
+
 private:
     const Matrix& matrix;  ///< Reference to the matrix initialized in main
     int n;                 ///< Number of cities (size of the matrix)
     int bestCost;          ///< Best cost found
     int* bestPath;         ///< Best path found
     int* currentPath;      ///< Current path during permutation
+    unsigned long long tourCount; ///< Number of evaluated tours, also used to throttle clock reads
+    std::chrono::steady_clock::time_point deadline; ///< The enumeration stops once this passes
+    bool stopped;          ///< Set when the enumeration stopped at the deadline
+    SharedIncumbent* incumbent; ///< Tour shared with concurrent solvers (nullptr if running alone)
 
     /**
      * @brief Calculate the cost of a given path.
@@ -11,8 +11,13 @@
 #include <string>
 #include <fstream>
 #include <stdexcept>
+#include <chrono>
+#include <random>
 #include "../lib/nlohmann/json.hpp"
 #include "../matrix.h"
+#include "../checkpoint.h"
+#include "../incumbent.h"
+#include "../search_counters.h"
 
 /**
  * @class GeneticAlgorithm
@@ -27,8 +32,17 @@ public:
      * @brief Constructs a GeneticAlgorithm object.
      * @param matrix A reference to the cost matrix for the TSP.
      * @param geneticConfigFilePath Path to the JSON configuration file containing algorithm parameters.
+     * @param seed Seed of the random engine.
      */
-    GeneticAlgorithm(const Matrix& matrix, std::string geneticConfigFilePath);
+    GeneticAlgorithm(const Matrix& matrix, std::string geneticConfigFilePath, unsigned int seed = std::random_device{}());
+
+    /**
+     * @brief Constructs a GeneticAlgorithm object from parameters that are already parsed.
+     * @param matrix A reference to the cost matrix for the TSP.
+     * @param config JSON object with a "geneticAlgorithmConfiguration" member, as in the configuration file.
+     * @param seed Seed of the random engine.
+     */
+    GeneticAlgorithm(const Matrix& matrix, const nlohmann::json& config, unsigned int seed = std::random_device{}());
 
     /**
      * @brief Destructor to clean up dynamically allocated memory.
@@ -42,6 +56,66 @@ public:
      */
     void runGeneticAlgorithm();
 
+    /**
+     * @brief Prepares another run on the same matrix with new parameters, reusing the chromosome buffers.
+     *
+     * The buffers are only reallocated when the population is larger than any before, which makes
+     * parameter sweeps cheap. The run that follows equals that of an object constructed with the same
+     * arguments.
+     * @param config JSON object with a "geneticAlgorithmConfiguration" member, as in the configuration file.
+     * @param seed Seed of the random engine.
+     */
+    void reconfigure(const nlohmann::json& config, unsigned int seed);
+
+    /**
+     * @brief Reads a JSON configuration file.
+     * @param path Path to the file.
+     * @return The parsed file.
+     * @throws std::runtime_error If the file cannot be opened.
+     */
+    static nlohmann::json readConfigFile(const std::string& path);
+
+    /**
+     * @brief Enables periodic checkpoints and resuming from an existing checkpoint.
+     * @param checkpointer The checkpoint writer, or nullptr to disable checkpoints.
+     * @param run Identifies the run when several runs of the solver share an instance (e.g. "s2").
+     */
+    void setCheckpointer(Checkpointer* checkpointer, const std::string& run = "");
+
+    /**
+     * @brief Stops the run at a point in time, keeping the best chromosome found so far.
+     *
+     * The deadline is checked once per generation.
+     * @param deadline The deadline.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Shares tours with solvers running concurrently on the same instance.
+     *
+     * Improvements are published to the incumbent and the run stops like at a deadline once it is cancelled.
+     * @param incumbent The shared incumbent, or nullptr to run alone.
+     */
+    void setIncumbent(SharedIncumbent* incumbent);
+
+    /**
+     * @brief Checks whether the last run stopped at the deadline.
+     * @return True if the deadline ended the run before iterationNum generations.
+     */
+    bool isStopped() const;
+
+    /**
+     * @brief Retrieves the number of generations completed by the last run, including those before a resumed checkpoint.
+     * @return The generation count.
+     */
+    int getGenerationCount() const;
+
+    /**
+     * @brief Retrieves the search counters of the last run.
+     * @return The counters.
+     */
+    const SearchCounters& getSearchCounters() const;
+
     /**
      * @brief Retrieves the best path found by the algorithm.
      * @return A dynamically allocated array representing the best path.
@@ -70,6 +144,8 @@ public:
     int getIterationNum();
     int getRandomRateNewGen();
 
+    friend class KernelBenchmark; // bench/kernels.cpp times the private kernels
+
 private:
     // Problem Data and Configuration
 
@@ -77,7 +153,9 @@ private:
     int problemSize;                    ///< Total number of cities in the problem.
     int** population;                   ///< 2D array of chromosomes representing the current population.
     int** offspring;                    ///< 2D array of offspring generated during each generation.
-    int** offspringPopulation;          ///< Combined array of current population and offspring.
+    int** offspringPopulation;          ///< Offspring of the current generation (one spare slot for an odd crossover count).
+    int* scratchChromosome;             ///< Replacement parent built when crossover parents are too similar.
+    int capacity;                       ///< Chromosome slots allocated in population and offspringPopulation (at least populationSize).
     int* bestPath;                      ///< Array representing the best path found.
     int bestSolution;                   ///< Cost of the best path found.
     std::string geneticConfigFilePath;  ///< Path to the JSON configuration file.
@@ -93,14 +171,48 @@ private:
     int randomRate;                     ///< Percentage of random mutations introduced into the population.
     int randomRateNewGen;               ///< Percentage of new diverse chromosomes added each generation.
 
+    // Run State
+
+    std::mt19937 rng;                   ///< Random engine; part of the checkpoint so a resumed run draws the same numbers.
+    Checkpointer* checkpointer;         ///< Checkpoint writer (nullptr if disabled).
+    std::string checkpointRun;          ///< Run identifier appended to the checkpoint file name.
+    std::chrono::steady_clock::time_point lastCheckpoint; ///< Time of the last checkpoint of this run.
+    std::chrono::steady_clock::time_point deadline;       ///< The run stops once this passes.
+    bool stopped;                       ///< Set when the run stopped at the deadline.
+    SharedIncumbent* incumbent;         ///< Tour shared with concurrent solvers (nullptr if running alone).
+    int completedGenerations;           ///< Generations completed by the last run.
+    SearchCounters counters;            ///< Crossovers, mutations, duplicate offspring and diversity retries of the last run.
+
     // Private Methods
 
     /**
      * @brief Parses algorithm parameters from a JSON configuration file.
+     *
+     * If the configuration has tuned "profiles", the profile of the instance's size class overrides the
+     * values of "geneticAlgorithmConfiguration" (see sizeProfile()).
+     *
      * @param configJson JSON object containing algorithm parameters.
      */
     void parseParametersFromJSON(const nlohmann::json& configJson);
 
+    /**
+     * @brief Allocates the population and offspring buffers.
+     * @param slots Number of chromosomes they hold (becomes the capacity).
+     */
+    void allocateBuffers(int slots);
+
+    /**
+     * @brief Frees the population and offspring buffers.
+     */
+    void freeBuffers();
+
+    /**
+     * @brief Draws a uniformly distributed integer in [0, bound).
+     * @param bound Exclusive upper bound.
+     * @return The random integer.
+     */
+    int randomInt(int bound);
+
     /**
      * @brief Generates a random chromosome.
      * @param chromosomeLength Length of the chromosome.
@@ -108,6 +220,13 @@ private:
      */
     int* generateChromosome(int chromosomeLength);
 
+    /**
+     * @brief Overwrites a chromosome with a random permutation of the cities 1..chromosomeLength.
+     * @param chromosome The chromosome to fill.
+     * @param chromosomeLength Length of the chromosome.
+     */
+    void fillRandomChromosome(int* chromosome, int chromosomeLength);
+
     /**
      * @brief Initializes the population with random chromosomes.
      * @param populationSize Number of chromosomes in the population.
@@ -123,19 +242,21 @@ private:
 
     /**
      * @brief Applies inversion mutation to a chromosome.
-     * @param currentChromosome Index of the chromosome to mutate.
+     * @param chromosome The chromosome to mutate in place.
      * @param chromosomeLength Length of the chromosome.
      * @param mutationSegmentSizeRate Percentage of the chromosome to invert.
+     * @return False if the chromosome is unchanged (a segment of one gene).
      */
-    void performInversionMutation(int currentChromosome, int chromosomeLength, int mutationSegmentSizeRate);
+    bool performInversionMutation(int* chromosome, int chromosomeLength, int mutationSegmentSizeRate);
 
     /**
      * @brief Applies shuffle mutation to a chromosome.
-     * @param currentChromosome Index of the chromosome to mutate.
+     * @param chromosome The chromosome to mutate in place.
      * @param chromosomeLength Length of the chromosome.
      * @param mutationSegmentSizeRate Percentage of the chromosome to shuffle.
+     * @return False if the chromosome is unchanged (every swap drew its own position).
      */
-    void performShuffleMutation(int currentChromosome, int chromosomeLength, int mutationSegmentSizeRate);
+    bool performShuffleMutation(int* chromosome, int chromosomeLength, int mutationSegmentSizeRate);
 
     /**
      * @brief Performs crossover between two parent chromosomes to produce offspring.
@@ -149,6 +270,8 @@ private:
 
     /**
      * @brief Selects the best chromosomes for the next generation.
+     *
+     * Chromosome buffers are exchanged between population and offspringPopulation rather than copied.
      * @param chromosomeLength Length of each chromosome.
      */
     void selection(int chromosomeLength);
@@ -167,7 +290,30 @@ private:
      * @param length Length of the chromosomes.
      * @return Diversity score.
      */
-    int calculateDiversity(int* chromosome1, int* chromosome2, int length);
+    int calculateDiversity(const int* chromosome1, const int* chromosome2, int length);
+
+    /**
+     * @brief Queues a checkpoint of the population, random engine and generation counter.
+     * @param path The checkpoint path.
+     * @param nextIteration The generation the resumed run starts with.
+     * @param bestCost The best cost found so far.
+     */
+    void saveCheckpoint(const std::string& path, int nextIteration, int bestCost);
+
+    /**
+     * @brief Formats every parameter of the run for the checkpoint's parameter hash.
+     * @return The parameters as "name=value" pairs.
+     */
+    std::string checkpointParameters() const;
+
+    /**
+     * @brief Restores the state saved by saveCheckpoint().
+     * @param path The checkpoint path.
+     * @param nextIteration Receives the generation to continue with.
+     * @param bestCost Receives the best cost found so far.
+     * @return False if there is no usable checkpoint for this instance and configuration.
+     */
+    bool loadCheckpoint(const std::string& path, int& nextIteration, int& bestCost);
 };
 
 #endif // GENETICALGO_H
@@ -0,0 +1,84 @@
+/**
+ * @file HeldKarpBatch.h
+ * @brief Exact solver for many small instances at once, running Held-Karp on several instances per vector lane.
+ */
+
+#ifndef HELDKARPBATCH_H
+#define HELDKARPBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HeldKarpBatch
+ * @brief Held-Karp dynamic programming over a batch of instances of equal size.
+ *
+ * Instances are processed in groups of LANES. The costs and the DP table of a group are interleaved so that
+ * each (subset, last city) state holds one value per instance, and every relaxation is a single lane-wise
+ * add and min (one AVX2 instruction each when built with ATSP_BATCH_AVX2). All instances of a group take
+ * the same branches, so the kernel has no per-instance control flow. The DP table is allocated once per
+ * object and reused for every group; create one object per thread.
+ *
+ * Time is O(2^n * n^2) per group and memory O(2^n * n * LANES), so sizes are limited to MAX_SIZE cities.
+ */
+class HeldKarpBatch {
+public:
+    static const int LANES = 8;     ///< Instances per group (eight 32-bit lanes fill a 256-bit register).
+    static const int MAX_SIZE = 16; ///< Largest supported instance.
+
+    /**
+     * @brief Allocates the buffers for instances of one size.
+     *
+     * @param size The number of cities of every instance.
+     * @throws std::invalid_argument If size is not between 1 and MAX_SIZE.
+     */
+    explicit HeldKarpBatch(int size);
+
+    /**
+     * @brief Solves consecutive instances.
+     *
+     * Costs at or above Matrix::FORBIDDEN_COST are forbidden edges; an instance has no feasible tour when every
+     * tour uses one. Tours of allowed edges may cost more than Matrix::FORBIDDEN_COST in total. Diagonal entries
+     * are ignored.
+     *
+     * @param costs count * size * size non-negative costs, one row-major matrix after the other.
+     * @param count The number of instances.
+     * @param tourCosts Receives count optimal costs (INT_MAX for instances without a feasible tour).
+     * @param tours Receives count * size cities, each tour starting at city 0 without the return
+     *              (all -1 for instances without a feasible tour); may be nullptr if only costs are needed.
+     * @throws std::invalid_argument If a cost is negative.
+     */
+    void solve(const int* costs, size_t count, int* tourCosts, int* tours);
+
+private:
+    /**
+     * @brief Solves up to LANES instances; the remaining lanes repeat the first instance and are discarded.
+     */
+    void solveGroup(const int* costs, int used, int* tourCosts, int* tours);
+
+    /**
+     * @brief Rebuilds the optimal tour of one lane from the filled DP table.
+     */
+    void reconstruct(int lane, int last, int* tour) const;
+
+    int size;                ///< Cities per instance.
+    int free;                ///< Cities other than the start city 0 (size - 1).
+    std::vector<uint32_t> lanes; ///< size * size * LANES interleaved costs of the current group; forbidden edges hold a sentinel above every feasible tour.
+    std::vector<uint32_t> table; ///< 2^free * free * LANES interleaved DP values: cheapest path from 0 through a subset ending at a city.
+};
+
+/**
+ * @brief Solves a batch of equal-size instances exactly, splitting the groups between threads.
+ *
+ * @param costs count * size * size costs, see HeldKarpBatch::solve().
+ * @param size The number of cities of every instance.
+ * @param count The number of instances.
+ * @param tourCosts Receives count optimal costs.
+ * @param tours Receives count * size cities (may be nullptr).
+ * @param threads The number of threads (0 = hardware concurrency).
+ * @throws std::invalid_argument If the size or a cost is invalid.
+ */
+void solveBatch(const int* costs, int size, size_t count, int* tourCosts, int* tours, int threads);
+
+#endif // HELDKARPBATCH_H
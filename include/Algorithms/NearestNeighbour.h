@@ -0,0 +1,51 @@
+#ifndef NEARESTNEIGHBOUR_H
+#define NEARESTNEIGHBOUR_H
+
+#include <vector>
+#include "../matrix.h"
+
+/**
+ * @class NearestNeighbour
+ * @brief Greedy construction heuristic: always travel to the cheapest unvisited city.
+ *
+ * Runs in O(n^2) and is used to seed other solvers with a first tour, e.g. the warm start of Branch and Bound.
+ */
+class NearestNeighbour {
+public:
+    /**
+     * @brief Constructor for the NearestNeighbour class.
+     *
+     * @param matrix The distance matrix.
+     */
+    NearestNeighbour(const Matrix& matrix);
+
+    /**
+     * @brief Build a tour starting at a city.
+     *
+     * Forbidden edges are only taken when every unvisited city is behind one.
+     *
+     * @param start The start city.
+     */
+    void run(int start = 0);
+
+    /**
+     * @brief Get the cost of the tour.
+     *
+     * @return int The cost, including the return to the start city.
+     */
+    int getBestCost() const;
+
+    /**
+     * @brief Get the tour.
+     *
+     * @return const std::vector<int>& The visiting order of all cities, without the return to the start.
+     */
+    const std::vector<int>& getBestPath() const;
+
+private:
+    const Matrix& matrix;  ///< The distance matrix.
+    int bestCost;          ///< Cost of the tour.
+    std::vector<int> tour; ///< The tour.
+};
+
+#endif // NEARESTNEIGHBOUR_H
@@ -0,0 +1,41 @@
+/**
+ * @file Portfolio.h
+ * @brief Runs several registered solvers concurrently on one instance against a shared incumbent.
+ */
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "Solver.h"
+
+/**
+ * @class PortfolioSolver
+ * @brief ISolver that races other solvers, registered as "portfolio".
+ *
+ * Every member solver runs on its own thread with the same deadline and a SharedIncumbent. Heuristic
+ * improvements are published as they are found, so Branch and Bound prunes against them immediately.
+ * The first member that proves its tour optimal cancels the others; otherwise the portfolio returns the
+ * incumbent once every member has finished or reached the deadline.
+ *
+ * Parameters: "solvers", the member names (default ["bnb", "tabu", "ga"]), and one object per member
+ * holding that member's parameters, e.g. {"solvers": ["bnb", "tabu"], "tabu": {"tabuSize": 20}}.
+ * Statistics of the members are reported with the member name as prefix, e.g. "bnb.nodes".
+ */
+class PortfolioSolver : public ISolver {
+public:
+    std::string name() const override { return "portfolio"; }
+    std::string description() const override { return "Portfolio"; }
+    bool isExact() const override { return false; }
+
+    /**
+     * @brief Races the member solvers.
+     *
+     * @param request The instance, deadline and seed; member i is seeded with seed + i when a seed is given.
+     * @return The best tour of all members; optimal if a member proved it.
+     * @throws std::invalid_argument If the member list is empty or contains "portfolio".
+     * @throws std::runtime_error If a member is unknown; exceptions of members are rethrown after all stopped.
+     */
+    SolveResult solve(const SolveRequest& request) override;
+};
+
+#endif // PORTFOLIO_H
@@ -0,0 +1,224 @@
+/**
+ * @file Solver.h
+ * @brief Common interface of all solvers, their request and result records, and the solver registry.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../lib/nlohmann/json.hpp"
+#include "../matrix.h"
+#include "../checkpoint.h"
+#include "../incumbent.h"
+#include "../search_counters.h"
+
+/**
+ * @struct SolveRequest
+ * @brief Input of one solver run.
+ */
+struct SolveRequest {
+    const Matrix* matrix = nullptr;                        ///< The instance (not owned).
+    nlohmann::json parameters = nlohmann::json::object();  ///< Solver parameters; unknown keys are ignored.
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); ///< The run stops with its best tour so far once this passes.
+    unsigned int seed = 0;                                 ///< Seed of the random engine (0 = draw one from std::random_device).
+    Checkpointer* checkpointer = nullptr;                  ///< Checkpoint writer (nullptr if disabled).
+    std::string run;                                       ///< Checkpoint run identifier, see Checkpointer::pathFor().
+    SharedIncumbent* incumbent = nullptr;                  ///< Tour shared with concurrently running solvers (nullptr if running alone).
+};
+
+/**
+ * @struct SolveTimings
+ * @brief Wall-clock time spent in the phases of a run.
+ */
+struct SolveTimings {
+    double setupMs = 0; ///< Constructing the solver (parsing parameters, allocating, initial solutions).
+    double solveMs = 0; ///< The search itself; this is the time reported in the results files.
+};
+
+/**
+ * @struct SolveResult
+ * @brief Output of one solver run.
+ */
+struct SolveResult {
+    std::string solver;                              ///< Registry name of the solver.
+    std::vector<int> tour;                           ///< Visiting order of all cities without the return to the start (empty if none was found).
+    int cost = INT_MAX;                              ///< Cost of the tour (INT_MAX if none was found).
+    int bound = 0;                                   ///< Proven lower bound on the optimal cost (0 if the solver proves none).
+    bool optimal = false;                            ///< Whether the tour is proven optimal.
+    bool timedOut = false;                           ///< Whether the run stopped at the deadline or was cancelled.
+    nlohmann::json parameters;                       ///< Effective parameters, including defaults.
+    std::map<std::string, unsigned long long> stats; ///< Search statistics, e.g. "nodes" or "iterations", and the non-zero SearchCounters.
+    SolveTimings timings;                            ///< Phase timings.
+};
+
+/**
+ * @class ISolver
+ * @brief Interface implemented by every solver.
+ *
+ * A solver object handles one request at a time; create one per thread.
+ */
+class ISolver {
+public:
+    virtual ~ISolver() = default;
+
+    /**
+     * @brief Short registry name, e.g. "bnb".
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * @brief Human-readable name, e.g. "Branch and Bound".
+     */
+    virtual std::string description() const = 0;
+
+    /**
+     * @brief Whether a run that does not time out proves its tour optimal.
+     */
+    virtual bool isExact() const = 0;
+
+    /**
+     * @brief Solves an instance.
+     *
+     * @param request The instance, parameters, deadline and seed.
+     * @return The result record.
+     * @throws std::invalid_argument If the request has no matrix or invalid parameters.
+     */
+    virtual SolveResult solve(const SolveRequest& request) = 0;
+
+protected:
+    /**
+     * @brief The request's seed, or a fresh one from std::random_device if it is 0.
+     */
+    static unsigned int seedFor(const SolveRequest& request);
+
+    /**
+     * @brief Milliseconds elapsed since a time point.
+     */
+    static double millisecondsSince(std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief Throws std::invalid_argument if the request has no matrix.
+     */
+    static const Matrix& requireMatrix(const SolveRequest& request);
+};
+
+/**
+ * @class SolverRegistry
+ * @brief Maps solver names to factories.
+ *
+ * Solvers register themselves from their translation unit with REGISTER_SOLVER, so adding a solver
+ * does not require changes to the code that runs it.
+ */
+class SolverRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<ISolver>()>; ///< Creates a solver.
+
+    /**
+     * @brief Returns the process-wide registry.
+     */
+    static SolverRegistry& instance();
+
+    /**
+     * @brief Registers a factory.
+     *
+     * @param name The solver name.
+     * @param factory The factory.
+     * @throws std::logic_error If the name is already registered.
+     */
+    void add(const std::string& name, Factory factory);
+
+    /**
+     * @brief Creates a solver.
+     *
+     * @param name The solver name.
+     * @return The new solver.
+     * @throws std::runtime_error If no solver of that name is registered.
+     */
+    std::unique_ptr<ISolver> create(const std::string& name) const;
+
+    /**
+     * @brief Checks whether a solver is registered.
+     */
+    bool contains(const std::string& name) const;
+
+    /**
+     * @brief Names of all registered solvers in alphabetical order.
+     */
+    std::vector<std::string> names() const;
+
+private:
+    SolverRegistry() = default;
+
+    std::map<std::string, Factory> factories; ///< Registered factories by name.
+};
+
+/**
+ * @class SolverPool
+ * @brief Solver objects of one kind handed from run to run.
+ *
+ * Each concurrent run takes an idle solver (or creates one) and returns it afterwards, so at most one solver
+ * per concurrent run is ever created and solvers that keep buffers between runs reuse them.
+ */
+class SolverPool {
+public:
+    /**
+     * @param solver Registry name of the solver.
+     */
+    explicit SolverPool(std::string solver);
+
+    /**
+     * @brief Solves a request with an idle solver; safe to call from several threads.
+     *
+     * A solver whose run throws is dropped instead of being reused.
+     */
+    SolveResult solve(const SolveRequest& request);
+
+private:
+    std::string solver;                       ///< Registry name of the solver.
+    std::mutex mutex;                         ///< Guards idle.
+    std::vector<std::unique_ptr<ISolver>> idle; ///< Solvers not running.
+};
+
+/**
+ * @brief Picks the tuned profile of an instance size from the "profiles" parameter (see the tuner).
+ *
+ * Profiles are ordered by size class: the first one whose "maxSize" is at least size applies, and one without
+ * "maxSize" applies to every size.
+ *
+ * @param parameters Solver parameters.
+ * @param size The number of cities.
+ * @return The profile, or an empty object if there are no profiles or none applies.
+ */
+nlohmann::json sizeProfile(const nlohmann::json& parameters, int size);
+
+/**
+ * @struct SolverRegistration
+ * @brief Registers a solver type during static initialization.
+ */
+template <typename SolverType>
+struct SolverRegistration {
+    explicit SolverRegistration(const std::string& name) {
+        SolverRegistry::instance().add(name, [] { return std::unique_ptr<ISolver>(new SolverType()); });
+    }
+};
+
+/**
+ * @brief Registers SolverType under a name, e.g. REGISTER_SOLVER(BranchAndBoundSolver, "bnb").
+ *
+ * It also defines the symbol SolverType##Anchor; the registry refers to the anchors of the built-in solvers so
+ * that linking the static libatsp keeps their translation units, which nothing else refers to.
+ */
+#define REGISTER_SOLVER(SolverType, name)                                            \
+    static SolverRegistration<SolverType> SolverType##Registration(name);            \
+    extern int SolverType##Anchor;                                                   \
+    int SolverType##Anchor = 0
+
+#endif // SOLVER_H
@@ -4,9 +4,15 @@
 #include <iostream>
 #include "../matrix.h"
 #include "../node.h"
+#include "../checkpoint.h"
+#include "../incumbent.h"
+#include "../search_counters.h"
 #include <limits>
 #include <ctime>
+#include <chrono>
 #include <random>
+#include <string>
+#include <vector>
 
 /**
  * @class TabuSearch
@@ -20,8 +26,9 @@ public:
      * @param matrix The distance matrix.
      * @param tabuListSize The size of the tabu list.
      * @param maxIterations The maximum number of iterations for the search.
+     * @param seed Seed of the random engine that builds the initial path and samples moves.
      */
-    TabuSearch(const Matrix& matrix, int tabuListSize, int maxIterations);
+    TabuSearch(const Matrix& matrix, int tabuListSize, int maxIterations, unsigned int seed = std::random_device{}());
 
     /**
      * @brief Destructor for the TabuSearch class.
@@ -35,6 +42,61 @@ public:
      */
     const int* runTabuSearch();
 
+    /**
+     * @brief Start the search from a given tour instead of the random one built by the constructor.
+     * 
+     * @param tour The visiting order of all cities without the return to the start; it may start at any city.
+     * @throws std::invalid_argument If the tour is not a permutation of the cities.
+     */
+    void setInitialPath(const std::vector<int>& tour);
+
+    /**
+     * @brief Enable periodic checkpoints and resuming from an existing checkpoint.
+     * 
+     * @param checkpointer The checkpoint writer, or nullptr to disable checkpoints.
+     * @param run Identifies the run when several runs of the solver share an instance (e.g. "s2").
+     */
+    void setCheckpointer(Checkpointer* checkpointer, const std::string& run = "");
+
+    /**
+     * @brief Stop the search at a point in time, keeping the best path found so far.
+     * 
+     * The deadline is checked once per iteration.
+     * 
+     * @param deadline The deadline.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Share tours with solvers running concurrently on the same instance.
+     * 
+     * Improvements are published to the incumbent and the run stops like at a deadline once it is cancelled.
+     * 
+     * @param incumbent The shared incumbent, or nullptr to run alone.
+     */
+    void setIncumbent(SharedIncumbent* incumbent);
+
+    /**
+     * @brief Check whether the last run stopped at the deadline.
+     * 
+     * @return bool True if the deadline ended the run before maxIterations.
+     */
+    bool isStopped() const;
+
+    /**
+     * @brief Get the number of iterations completed by the last run, including those before a resumed checkpoint.
+     * 
+     * @return int The iteration count.
+     */
+    int getIterationCount() const;
+
+    /**
+     * @brief Get the search counters of the last run.
+     * 
+     * @return const SearchCounters& The counters.
+     */
+    const SearchCounters& getSearchCounters() const;
+
     /**
      * @brief Print the best solution found by the Tabu Search algorithm.
      */
@@ -54,15 +116,28 @@ public:
      */
     int getBestCost() const;
 
+    friend class KernelBenchmark; // bench/kernels.cpp times the private kernels
+
 private:
     const Matrix& matrix;       ///< The distance matrix.
     int size;                   ///< Number of cities (size of the matrix).
-    int bestCost;               ///< Best cost found during the search.
+    long long bestCost;         ///< Best cost found during the search (64-bit, forbidden edges may exceed int).
     int* bestPath;              ///< Best path found during the search.
     int* currentPath;           ///< Current path being evaluated.
+    int* position;              ///< Index of each city in currentPath.
+    bool useReversal;           ///< Use 2-opt segment reversals instead of swaps (symmetric instances).
     int tabuListSize;           ///< Size of the tabu list.
     int** tabuList;             ///< The tabu list to store moves.
     int maxIterations;          ///< Max number of iterations for the search.
+    std::mt19937 rng;           ///< Random engine; part of the checkpoint so a resumed run draws the same numbers.
+    Checkpointer* checkpointer; ///< Checkpoint writer (nullptr if disabled).
+    std::string checkpointRun;  ///< Run identifier appended to the checkpoint file name.
+    std::chrono::steady_clock::time_point lastCheckpoint; ///< Time of the last checkpoint of this run.
+    std::chrono::steady_clock::time_point deadline; ///< The search stops once this passes.
+    bool stopped;               ///< Set when the search stopped at the deadline.
+    SharedIncumbent* incumbent; ///< Tour shared with concurrent solvers (nullptr if running alone).
+    int completedIterations;    ///< Iterations completed by the last run.
+    SearchCounters counters;    ///< Moves evaluated and rejected as tabu by the last run.
 
     /**
      * @brief Initialize the tabu list.
@@ -95,13 +170,94 @@ private:
      */
     void swapCities(int* path, int i, int j);
 
+    /**
+     * @brief Calculate the change in path cost caused by swapping two positions.
+     *
+     * Only the (up to four) edges adjacent to the swapped positions are re-evaluated.
+     *
+     * @param path The path in which the swap is evaluated.
+     * @param i The first position.
+     * @param j The second position.
+     * @return long long The cost of the swapped path minus the cost of the current path.
+     */
+    long long swapDelta(const int* path, int i, int j) const;
+
+    /**
+     * @brief Calculate the change in path cost caused by reversing the segment between two positions.
+     *
+     * On symmetric instances only the two edges at the segment ends change, so this is O(1).
+     *
+     * @param path The path in which the reversal is evaluated.
+     * @param i The first position of the segment.
+     * @param j The last position of the segment.
+     * @return long long The cost of the reversed path minus the cost of the current path.
+     */
+    long long reversalDelta(const int* path, int i, int j) const;
+
+    /**
+     * @brief Check whether a move would add a forbidden edge to the path.
+     *
+     * @param path The path in which the move is evaluated.
+     * @param i The first position.
+     * @param j The second position.
+     * @return bool True if one of the edges created by the move is forbidden.
+     */
+    bool createsForbiddenEdge(const int* path, int i, int j) const;
+
+    /**
+     * @brief Evaluate a move and remember it if it is the best admissible neighbour so far.
+     *
+     * The move is a swap of two positions, or a reversal of the segment between them when useReversal is set.
+     *
+     * @param i The first position.
+     * @param j The second position.
+     * @param currentCost The cost of the current path.
+     * @param bestNeighborCost The best neighbour cost found in this iteration (updated).
+     * @param bestMove The positions of the best neighbour move (updated).
+     */
+    void evaluateMove(int i, int j, long long currentCost, long long& bestNeighborCost, int* bestMove);
+
+    /**
+     * @brief Apply a move to the current path and keep the position index up to date.
+     *
+     * @param i The first position.
+     * @param j The second position.
+     */
+    void applyMove(int i, int j);
+
     /**
      * @brief Calculate the cost of a given path.
      * 
      * @param path The path for which to calculate the cost.
-     * @return int The cost of the path.
+     * @return long long The cost of the path.
+     */
+    long long calculateCost(const int* path);
+
+    /**
+     * @brief Queue a checkpoint of the paths, tabu list and random engine.
+     * 
+     * @param path The checkpoint path.
+     * @param iterations The number of completed iterations.
+     * @param currentCost The cost of the current path.
+     */
+    void saveCheckpoint(const std::string& path, int iterations, long long currentCost);
+
+    /**
+     * @brief Format every parameter of the search for the checkpoint's parameter hash.
+     *
+     * @return std::string The parameters as "name=value" pairs.
+     */
+    std::string checkpointParameters() const;
+
+    /**
+     * @brief Restore the state saved by saveCheckpoint().
+     * 
+     * @param path The checkpoint path.
+     * @param iterations Receives the number of completed iterations.
+     * @param currentCost Receives the cost of the current path.
+     * @return bool False if there is no usable checkpoint for this instance and configuration.
      */
-    int calculateCost(const int* path);
+    bool loadCheckpoint(const std::string& path, int& iterations, long long& currentCost);
 };
 
 #endif // TABUSEARCH_H
\ No newline at end of file
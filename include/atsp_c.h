@@ -0,0 +1,218 @@
+/**
+ * @file atsp_c.h
+ * @brief C interface of libatsp for embedding the solvers in other programs.
+ *
+ * The interface only uses opaque handles, fixed-width integers and plain C strings, so it stays binary
+ * compatible across releases of the same major ATSP_C_ABI_VERSION and can be called from C, Rust, Python
+ * (ctypes/cffi), Go and similar. Functions that can fail return an atsp_status; the message of the last
+ * failure on the calling thread is available from atsp_last_error(). No function throws.
+ *
+ * Matrices may be shared by concurrent atsp_solve() calls once they are prepared; every other handle
+ * belongs to one thread at a time.
+ */
+
+#ifndef ATSP_C_H
+#define ATSP_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Version of this interface; the major version (bits 16 and up) changes with incompatible changes.
+ */
+#define ATSP_C_ABI_VERSION 0x00010000u
+
+/**
+ * @brief Result of a fallible call.
+ */
+typedef enum atsp_status {
+    ATSP_OK = 0,                    ///< Success.
+    ATSP_ERROR_INVALID_ARGUMENT = 1,///< A null handle, bad size or cost, malformed parameters, ...
+    ATSP_ERROR_UNKNOWN_SOLVER = 2,  ///< No solver is registered under the given name.
+    ATSP_ERROR_IO = 3,              ///< A file could not be read.
+    ATSP_ERROR_OUT_OF_MEMORY = 4,   ///< An allocation failed.
+    ATSP_ERROR_INTERNAL = 5         ///< Any other failure inside a solver.
+} atsp_status;
+
+typedef struct atsp_matrix atsp_matrix; ///< An instance.
+typedef struct atsp_result atsp_result; ///< The outcome of one solver run.
+
+/**
+ * @brief Called with every improved tour while a solver runs.
+ *
+ * It runs on the solver's thread, in order of improvement, and should return quickly.
+ *
+ * @param cost The cost of the tour.
+ * @param tour The visiting order of all cities without the return to the start; valid during the call only.
+ * @param size The number of cities in the tour.
+ * @param solver The name of the solver that found the tour.
+ * @param user The pointer passed to atsp_solve().
+ * @return 0 to continue, anything else to stop the run with its best tour so far.
+ */
+typedef int (*atsp_progress_callback)(int32_t cost, const int32_t* tour, int32_t size, const char* solver, void* user);
+
+/**
+ * @brief The ATSP_C_ABI_VERSION the library was built with; callers compare its major version with theirs.
+ */
+uint32_t atsp_abi_version(void);
+
+/**
+ * @brief Message of the last failed call on the calling thread ("" if there was none); valid until the next call.
+ */
+const char* atsp_last_error(void);
+
+/**
+ * @brief Wraps a caller-owned cost buffer without copying it.
+ *
+ * The buffer must stay valid and unchanged until atsp_matrix_destroy(); the library never writes to it.
+ *
+ * @param costs size * size costs in row-major order; the diagonal must be 0 and costs of at least 100000000
+ *              (the TSPLIB sentinel) mark forbidden edges.
+ * @param size The number of cities.
+ * @param out Receives the matrix.
+ */
+atsp_status atsp_matrix_create_view(const int32_t* costs, int32_t size, atsp_matrix** out);
+
+/**
+ * @brief Copies a cost buffer into a new matrix; the diagonal is ignored and symmetric costs are packed.
+ *
+ * @param costs size * size costs in row-major order.
+ * @param size The number of cities.
+ * @param out Receives the matrix.
+ */
+atsp_status atsp_matrix_create_copy(const int32_t* costs, int32_t size, atsp_matrix** out);
+
+/**
+ * @brief Reads a matrix file in any format accepted for inputFilePath.
+ *
+ * Accepted are the plain format (the size on the first line, then the costs row by row) and TSPLIB files with
+ * EDGE_WEIGHT_TYPE EXPLICIT and EDGE_WEIGHT_FORMAT FULL_MATRIX. Either may be gzip-compressed if the path ends
+ * in ".gz"; that needs a library built with zlib (ATSP_WITH_ZLIB), otherwise it fails with ATSP_ERROR_IO.
+ *
+ * @param path The file.
+ * @param out Receives the matrix.
+ * @return ATSP_ERROR_IO if the file cannot be read, is compressed without zlib support or has an unsupported format.
+ */
+atsp_status atsp_matrix_load(const char* path, atsp_matrix** out);
+
+/**
+ * @brief Builds the transposed costs (used by Branch and Bound) and, if candidate_list_size > 0, the candidate lists.
+ *
+ * Optional, but it must happen before concurrent solves on the matrix, never during them.
+ *
+ * @param matrix The matrix.
+ * @param candidate_list_size Neighbours per city (0 for none).
+ */
+atsp_status atsp_matrix_prepare(atsp_matrix* matrix, int32_t candidate_list_size);
+
+/**
+ * @brief The number of cities (0 for a null handle).
+ */
+int32_t atsp_matrix_size(const atsp_matrix* matrix);
+
+/**
+ * @brief The content fingerprint (16 hexadecimal digits, "" for a null handle); valid as long as the matrix.
+ */
+const char* atsp_matrix_fingerprint(const atsp_matrix* matrix);
+
+/**
+ * @brief Releases a matrix; a view no longer refers to its buffer afterwards. Null is ignored.
+ */
+void atsp_matrix_destroy(atsp_matrix* matrix);
+
+/**
+ * @brief The number of registered solvers.
+ */
+size_t atsp_solver_count(void);
+
+/**
+ * @brief The name of a registered solver in alphabetical order (NULL if index is out of range).
+ */
+const char* atsp_solver_name(size_t index);
+
+/**
+ * @brief Runs a solver on a matrix.
+ *
+ * @param matrix The matrix.
+ * @param solver The solver name, e.g. "bnb" or "tabu" (see atsp_solver_name()).
+ * @param parameters_json The solver parameters as a JSON object, as in the solve requests of the daemon (NULL for defaults).
+ * @param time_limit_seconds The run stops with its best tour so far after this many seconds (0 for no limit).
+ * @param seed The random seed (0 to draw one).
+ * @param progress Called with every improved tour (may be NULL).
+ * @param user Passed to progress.
+ * @param out Receives the result, also when the run stopped early.
+ */
+atsp_status atsp_solve(const atsp_matrix* matrix, const char* solver, const char* parameters_json, double time_limit_seconds,
+                       uint32_t seed, atsp_progress_callback progress, void* user, atsp_result** out);
+
+/**
+ * @brief Solves many small instances of one size exactly, several per vector lane (see HeldKarpBatch.h).
+ *
+ * Costs at or above 100000000 are forbidden edges and diagonal entries are ignored. Time and memory grow as
+ * 2^size, so this is meant for instances of up to about 12 cities; at most 16 are accepted.
+ *
+ * @param costs count * size * size non-negative costs, one row-major matrix after the other.
+ * @param size The number of cities of every instance.
+ * @param count The number of instances.
+ * @param tour_costs Receives count optimal costs (INT32_MAX for instances without a feasible tour).
+ * @param tours Receives count * size cities, each tour starting at city 0 without the return (-1 for instances
+ *              without a feasible tour); may be NULL.
+ * @param threads The number of threads (0 = one per hardware thread).
+ */
+atsp_status atsp_solve_batch(const int32_t* costs, int32_t size, size_t count, int32_t* tour_costs, int32_t* tours, int32_t threads);
+
+/**
+ * @brief The cost of the best tour (INT32_MAX if none was found).
+ */
+int32_t atsp_result_cost(const atsp_result* result);
+
+/**
+ * @brief Copies the best tour, without the return to the start.
+ *
+ * @param result The result.
+ * @param tour Receives up to capacity cities (may be NULL if capacity is 0).
+ * @param capacity The size of tour.
+ * @return The length of the full tour (0 if none was found), so a short buffer can be resized and the call repeated.
+ */
+int32_t atsp_result_tour(const atsp_result* result, int32_t* tour, int32_t capacity);
+
+/**
+ * @brief The proven lower bound on the optimal cost (0 if the solver proves none).
+ */
+int32_t atsp_result_bound(const atsp_result* result);
+
+/**
+ * @brief 1 if the tour is proven optimal, 0 otherwise.
+ */
+int atsp_result_optimal(const atsp_result* result);
+
+/**
+ * @brief 1 if the run stopped at its time limit or through the progress callback, 0 otherwise.
+ */
+int atsp_result_timed_out(const atsp_result* result);
+
+/**
+ * @brief Milliseconds spent searching, as reported in the results files.
+ */
+double atsp_result_solve_ms(const atsp_result* result);
+
+/**
+ * @brief The whole result, including the effective parameters and search statistics, as a JSON object with the
+ *        fields of the daemon's "result" event; valid as long as the result.
+ */
+const char* atsp_result_json(const atsp_result* result);
+
+/**
+ * @brief Releases a result. Null is ignored.
+ */
+void atsp_result_destroy(atsp_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ATSP_C_H
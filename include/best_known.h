@@ -0,0 +1,32 @@
+/**
+ * @file best_known.h
+ * @brief Best known (proven optimal) tour costs of the TSPLIB ATSP instances.
+ */
+
+#ifndef BEST_KNOWN_H
+#define BEST_KNOWN_H
+
+#include <string>
+
+/**
+ * @brief Instance name of a matrix file: the file name without directories and extensions.
+ *
+ * @param path E.g. "data/Archives/ftv35.atsp.gz".
+ * @return E.g. "ftv35".
+ */
+std::string instanceName(const std::string& path);
+
+/**
+ * @brief Best known tour cost of a TSPLIB ATSP instance.
+ *
+ * @param instance Instance name or path of its file, e.g. "br17" or "data/TSPLib_ATSP/br17.atsp".
+ * @return The cost, or -1 if the instance is not in the table.
+ */
+int bestKnownCost(const std::string& instance);
+
+/**
+ * @brief Relative gap of a cost to a best known cost in percent.
+ */
+double gapPercent(long long cost, int bestKnown);
+
+#endif // BEST_KNOWN_H
@@ -0,0 +1,71 @@
+#ifndef CANDIDATES_H
+#define CANDIDATES_H
+
+class Matrix;
+
+/**
+ * @class CandidateLists
+ * @brief Precomputed k-nearest successor and predecessor lists for every city.
+ *
+ * For each city the k cheapest outgoing and k cheapest incoming neighbours are stored
+ * in ascending cost order in two contiguous n*k arrays. Local search and mutation operators
+ * use them to restrict their neighbourhoods to O(n*k) promising moves.
+ */
+class CandidateLists {
+public:
+    /**
+     * @brief Builds the candidate lists for a matrix using parallel partial sorts.
+     *
+     * @param matrix The cost matrix.
+     * @param k The number of candidates per city (clamped to size - 1).
+     */
+    CandidateLists(const Matrix& matrix, int k);
+
+    /**
+     * @brief Destructor to free the candidate arrays.
+     */
+    ~CandidateLists();
+
+    CandidateLists(const CandidateLists&) = delete;
+    CandidateLists& operator=(const CandidateLists&) = delete;
+
+    /**
+     * @brief Function to get the cheapest successors of a city.
+     *
+     * @param city The index of the city.
+     * @return Pointer to getK() city indices, cheapest outgoing edge first.
+     */
+    const int* getSuccessors(int city) const;
+
+    /**
+     * @brief Function to get the cheapest predecessors of a city.
+     *
+     * @param city The index of the city.
+     * @return Pointer to getK() city indices, cheapest incoming edge first.
+     */
+    const int* getPredecessors(int city) const;
+
+    /**
+     * @brief Function to get the number of candidates stored per city.
+     *
+     * @return The number of candidates per city.
+     */
+    int getK() const;
+
+private:
+    int size;          ///< Number of cities.
+    int k;             ///< Number of candidates per city.
+    int* successors;   ///< size * k successor indices, row-major by city.
+    int* predecessors; ///< size * k predecessor indices, row-major by city.
+
+    /**
+     * @brief Fills the candidate rows of the cities in [first, last).
+     *
+     * @param matrix The cost matrix.
+     * @param first The first city to process.
+     * @param last One past the last city to process.
+     */
+    void buildRange(const Matrix& matrix, int first, int last);
+};
+
+#endif // CANDIDATES_H
@@ -0,0 +1,179 @@
+/**
+ * @file checkpoint.h
+ * @brief Binary solver snapshots and the background writer that persists them for resuming interrupted runs.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Matrix;
+
+/**
+ * @class CheckpointBuffer
+ * @brief Byte buffer that solvers serialize their state into and read it back from.
+ *
+ * Values are stored in native byte order; checkpoints are meant to be resumed on the machine that wrote them.
+ */
+class CheckpointBuffer {
+public:
+    void putInt(int value);
+    void putLong(long long value);
+    void putInts(const int* values, int count);
+    void putString(const std::string& value);
+
+    /**
+     * @brief Serializes the complete state of a random engine, so that a resumed run draws the same numbers.
+     */
+    void putRng(const std::mt19937& rng);
+
+    /**
+     * @brief Stores a hash of the parameters that shaped the state, so a run with other parameters does not resume it.
+     *
+     * @param parameters Every parameter of the solver as "name=value" pairs, in a fixed order.
+     */
+    void putParameters(const std::string& parameters);
+
+    /**
+     * @brief Read accessors, in the order the values were written.
+     * @throws std::runtime_error If the buffer ends before the value.
+     */
+    int getInt();
+    long long getLong();
+    void getInts(int* values, int count);
+    std::string getString();
+    void getRng(std::mt19937& rng);
+
+    /**
+     * @brief Reads the hash stored by putParameters() and compares it with the current parameters.
+     *
+     * @param parameters The current parameters, formatted as when the checkpoint was written.
+     * @return True if the checkpoint was written with the same parameters.
+     */
+    bool matchesParameters(const std::string& parameters);
+
+    /**
+     * @brief Raw contents of the buffer.
+     */
+    std::vector<char>& bytes() { return data; }
+
+private:
+    std::vector<char> data; ///< Serialized values.
+    size_t readOffset = 0;  ///< Position of the next value to read.
+
+    void put(const void* value, size_t length);
+    void get(void* value, size_t length);
+};
+
+/**
+ * @class Checkpointer
+ * @brief Writes solver snapshots on a background thread and loads them back when a run is resumed.
+ *
+ * Solvers poll due() at iteration boundaries and, when it returns true, serialize their state and hand it
+ * to save(), which only queues the bytes. Only the most recent pending snapshot per file is kept, so a slow
+ * disk never stalls the solver or builds up a backlog. Files are written to a temporary name and renamed
+ * into place, and carry a checksum, so an interrupted write never replaces a good checkpoint. Temporaries
+ * are named after the writing process, so several processes can share a directory; those left behind by
+ * a crashed process are deleted when the next Checkpointer starts.
+ */
+class Checkpointer {
+public:
+    /**
+     * @brief Deletes leftover temporary files from the directory and starts the writer thread.
+     *
+     * @param directory Directory holding the checkpoint files (created if needed).
+     * @param intervalSeconds Minimum time between two snapshots of a run.
+     * @param resume Whether load() returns existing checkpoints.
+     * @throws std::runtime_error If the directory cannot be created.
+     */
+    Checkpointer(const std::string& directory, double intervalSeconds, bool resume);
+
+    /**
+     * @brief Writes the pending snapshots and stops the writer thread.
+     */
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    /**
+     * @brief Path of the checkpoint of a solver on an instance.
+     *
+     * @param solver The solver name.
+     * @param matrix The instance; its fingerprint is part of the file name.
+     * @param run Distinguishes concurrent runs of the same solver on the same instance (may be empty).
+     * @return The checkpoint path.
+     */
+    std::string pathFor(const std::string& solver, const Matrix& matrix, const std::string& run = "") const;
+
+    /**
+     * @brief Checks whether the checkpoint interval has elapsed since a run's last snapshot.
+     *
+     * Each run keeps its own time point, so concurrent solvers do not share an interval.
+     *
+     * @param lastSave Time of the run's last snapshot; set to now when the function returns true.
+     * @return True if the caller should take a snapshot now.
+     */
+    bool due(std::chrono::steady_clock::time_point& lastSave) const;
+
+    /**
+     * @brief Queues a snapshot for writing.
+     *
+     * @param path The checkpoint path.
+     * @param buffer The serialized state (moved from).
+     */
+    void save(const std::string& path, CheckpointBuffer& buffer);
+
+    /**
+     * @brief Loads a checkpoint if resuming is enabled.
+     *
+     * @param path The checkpoint path.
+     * @param buffer Receives the serialized state.
+     * @return False if resuming is disabled or the file is missing or corrupt.
+     */
+    bool load(const std::string& path, CheckpointBuffer& buffer) const;
+
+    /**
+     * @brief Drops the pending snapshot and deletes the checkpoint of a finished run.
+     *
+     * @param path The checkpoint path.
+     */
+    void remove(const std::string& path);
+
+private:
+    std::string directory;                          ///< Checkpoint directory.
+    std::chrono::steady_clock::duration interval;   ///< Minimum time between snapshots.
+    bool resume;                                    ///< Whether existing checkpoints are loaded.
+
+    std::map<std::string, std::vector<char>> pending; ///< Latest unwritten snapshot per path.
+    std::mutex queueMutex;                            ///< Guards pending and stopping.
+    std::mutex ioMutex;                               ///< Held while a file is written, so remove() cannot race it.
+    std::condition_variable wakeUp;                   ///< Signals new snapshots or shutdown.
+    bool stopping = false;                            ///< Set by the destructor.
+    std::thread worker;                               ///< The writer thread.
+
+    /**
+     * @brief Writer thread loop.
+     */
+    void run();
+
+    /**
+     * @brief Deletes the "*.ckpt.tmp.<pid>" files of processes that no longer run, or older than a day.
+     */
+    void removeStaleTemporaries();
+
+    /**
+     * @brief Writes one checkpoint file atomically.
+     */
+    void writeFile(const std::string& path, const std::vector<char>& payload);
+};
+
+#endif // CHECKPOINT_H
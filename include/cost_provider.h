@@ -0,0 +1,79 @@
+#ifndef COST_PROVIDER_H
+#define COST_PROVIDER_H
+
+#include <vector>
+
+/**
+ * @class CostProvider
+ * @brief Computes edge costs on demand for instances too large to store as a dense matrix.
+ *
+ * A Matrix backed by a provider keeps no size * size array; getCost() forwards to the provider.
+ * Implementations must be thread-safe for concurrent const calls.
+ */
+class CostProvider {
+public:
+    virtual ~CostProvider() = default;
+
+    /**
+     * @brief Function to get the number of cities.
+     *
+     * @return The number of cities.
+     */
+    virtual int getSize() const = 0;
+
+    /**
+     * @brief Function to compute the cost between two cities.
+     *
+     * @param i The index of the first city.
+     * @param j The index of the second city.
+     * @return The cost from i to j.
+     */
+    virtual int getCost(int i, int j) const = 0;
+
+    /**
+     * @brief Checks whether cost(i, j) == cost(j, i) for every pair of cities.
+     *
+     * @return True if the cost function is symmetric.
+     */
+    virtual bool isSymmetric() const = 0;
+
+    /**
+     * @brief Computes a hash identifying the cost function and its inputs.
+     *
+     * Two providers with the same fingerprint must produce the same costs.
+     *
+     * @return A 64-bit fingerprint.
+     */
+    virtual unsigned long long fingerprint() const = 0;
+};
+
+/**
+ * @class CoordinateCostProvider
+ * @brief Euclidean distance between city coordinates plus a direction-dependent penalty.
+ *
+ * cost(i, j) = round(dist(i, j) + directionPenalty * max(0, y[j] - y[i])), i.e. moving "uphill"
+ * (towards larger y) costs extra, which makes the instance asymmetric when the penalty is non-zero.
+ */
+class CoordinateCostProvider : public CostProvider {
+public:
+    /**
+     * @brief Constructor taking the city coordinates.
+     *
+     * @param x The x coordinates of the cities.
+     * @param y The y coordinates of the cities (same length as x).
+     * @param directionPenalty The extra cost per unit of y gained along an edge.
+     */
+    CoordinateCostProvider(std::vector<double> x, std::vector<double> y, double directionPenalty);
+
+    int getSize() const override;
+    int getCost(int i, int j) const override;
+    bool isSymmetric() const override;
+    unsigned long long fingerprint() const override;
+
+private:
+    std::vector<double> x;   ///< x coordinates of the cities.
+    std::vector<double> y;   ///< y coordinates of the cities.
+    double directionPenalty; ///< Extra cost per unit of y gained along an edge.
+};
+
+#endif // COST_PROVIDER_H
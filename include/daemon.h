@@ -0,0 +1,221 @@
+/**
+ * @file daemon.h
+ * @brief Long-running solver service answering newline-delimited JSON requests on a UNIX domain socket.
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "lib/nlohmann/json.hpp"
+#include "matrix.h"
+
+class SolverPool;
+
+/**
+ * @struct DaemonOptions
+ * @brief Settings of a SolverDaemon.
+ */
+struct DaemonOptions {
+    std::string socketPath;                                  ///< Path of the UNIX domain socket.
+    int workers = 0;                                         ///< Solve threads (0 = one per logical CPU).
+    int maxMatrices = 16;                                    ///< Prepared instances kept in memory, least recently used evicted first.
+    int candidateListSize = 10;                              ///< Candidate list size built for every instance (0 = none).
+    double timeLimitSeconds = 0;                             ///< Time limit of requests that do not set one (0 = none).
+    double minSolveSeconds = 0.01;                           ///< Least run time a request must be able to get before its deadline.
+    std::string fallbackSolver = "nn";                       ///< Solver that requests are degraded to when they cannot get it ("" = reject instead).
+    std::map<std::string, nlohmann::json> defaultParameters; ///< Solver parameters that request parameters are merged over, by solver name.
+};
+
+/**
+ * @class SolverDaemon
+ * @brief Serves solve requests from local clients without per-request process start-up.
+ *
+ * Every request and response is one JSON object per line. A request carries an "op" and an optional "id"
+ * that is echoed in every response to it:
+ * - "solve": runs "solver" with "parameters", "timeLimitSeconds" and "seed" on an instance given inline as
+ *   "matrix" (array of rows), as "path" of a matrix file, as a matrix image (see matrix_image.h) whose
+ *   descriptor is passed with SCM_RIGHTS along with the request line and "matrixFd": true, or as the
+ *   "fingerprint" of an instance the daemon already holds. Unless "stream" is false, every improvement is sent as an "incumbent" event; the run ends
+ *   with a "result" event.
+ * - "load": prepares an instance without solving it and answers its fingerprint ("loaded").
+ * - "lookup": answers whether the instance with a "fingerprint" is held ("lookup" with "known").
+ * - "ping" ("pong"), "stats" ("stats") and "shutdown" ("bye"; queued requests still finish).
+ * Failures are answered with an "error" event carrying a "message".
+ *
+ * Instances are prepared once (transposed costs, candidate lists) and cached by fingerprint, and solve
+ * threads are started with the daemon, so a request only pays for the solve itself. Closing a connection
+ * cancels its running requests and drops its queued ones.
+ *
+ * Requests are scheduled earliest deadline first on a fixed number of slots (one thread of CPU each). A
+ * request's "timeLimitSeconds" is its run-time budget and "deadlineSeconds" (default: the time limit) the
+ * latest time its result is due, both counted from its arrival; requests without either run after all
+ * others. When a request with an earlier deadline waits, the running request with the latest deadline is
+ * suspended at its next iteration boundary (SharedIncumbent::shouldStop()) and resumed once it is again the
+ * earliest waiting one. Admission control estimates when a new request would start; if it could not get
+ * minSolveSeconds before its deadline, it is degraded to the fallback solver, or rejected if "degrade" is
+ * false. The same check is repeated when the request starts, so that no result is later than its deadline
+ * by more than a fallback run and an iteration of the preempted solver.
+ *
+ * Solver objects are kept warm in one SolverPool per registered solver, so repeated requests on the same
+ * instance reuse the Genetic Algorithm's population buffers instead of reallocating them.
+ */
+class SolverDaemon {
+public:
+    /**
+     * @brief Binds the socket and starts the solve threads.
+     *
+     * A stale socket file at the path is replaced; the socket is accessible to the owner only.
+     *
+     * @param options The settings.
+     * @throws std::invalid_argument If the socket path is empty or too long.
+     * @throws std::runtime_error If the socket cannot be created.
+     */
+    explicit SolverDaemon(DaemonOptions options);
+
+    /**
+     * @brief Stops the daemon and removes the socket file.
+     */
+    ~SolverDaemon();
+
+    SolverDaemon(const SolverDaemon&) = delete;
+    SolverDaemon& operator=(const SolverDaemon&) = delete;
+
+    /**
+     * @brief Accepts connections until a "shutdown" request, stop(), SIGINT or SIGTERM.
+     *
+     * Returns after every queued request has been answered; after a signal, running requests are cancelled
+     * and queued ones dropped instead.
+     */
+    void run();
+
+    /**
+     * @brief Makes run() return; safe to call from any thread.
+     */
+    void stop();
+
+private:
+    struct Connection;
+    struct Job;
+
+    using JobKey = std::pair<std::chrono::steady_clock::time_point, unsigned long long>; ///< Deadline and arrival number; orders jobs.
+
+    /**
+     * @brief Reads requests from a connection until it is closed.
+     */
+    void serve(std::shared_ptr<Connection> connection);
+
+    /**
+     * @brief Answers one request line.
+     */
+    void handle(const std::shared_ptr<Connection>& connection, const std::string& line);
+
+    /**
+     * @brief Body of a solve thread.
+     */
+    void work();
+
+    /**
+     * @brief Queues a solve job if its deadline can be met, degrading it otherwise.
+     *
+     * Must be called with queueMutex held.
+     *
+     * @throws std::runtime_error If the job can neither be met nor degraded.
+     */
+    void admit(std::unique_ptr<Job> job);
+
+    /**
+     * @brief Estimates when a job would start if every job with an earlier deadline ran for its full budget.
+     *
+     * Must be called with queueMutex held.
+     */
+    std::chrono::steady_clock::time_point projectedStart(const JobKey& key, std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Hands free slots to the earliest waiting jobs and suspends a running job if an earlier one waits.
+     *
+     * Must be called with queueMutex held.
+     */
+    void schedule();
+
+    /**
+     * @brief Yield handler of a running job: gives up its slot and waits until it is granted one again.
+     */
+    void suspend(Job& job);
+
+    /**
+     * @brief Records the time between the arrival of a request and its result.
+     */
+    void recordLatency(double milliseconds);
+
+    /**
+     * @brief Runs a solve request and sends its events.
+     */
+    void solve(Job& job);
+
+    /**
+     * @brief Returns the prepared instance a request refers to, loading it if needed.
+     *
+     * A known "fingerprint" takes precedence, so clients can send it along with the instance and only pay for
+     * loading when the daemon does not hold it yet.
+     *
+     * @param request The request.
+     * @param descriptor The matrix image sent with the request (-1 if none); the caller closes it.
+     * @throws std::invalid_argument If the request names no instance or an unknown fingerprint alone.
+     */
+    std::shared_ptr<const Matrix> resolveMatrix(const nlohmann::json& request, int descriptor);
+
+    /**
+     * @brief Prepares an instance and adds it to the cache, or returns the cached copy of equal contents.
+     */
+    std::shared_ptr<const Matrix> cacheMatrix(std::unique_ptr<Matrix> matrix);
+
+    /**
+     * @brief Looks up a cached instance and marks it as recently used.
+     */
+    std::shared_ptr<const Matrix> findMatrix(const std::string& fingerprint);
+
+    DaemonOptions options;                         ///< The settings.
+    int listenFd;                                  ///< Listening socket.
+    int wakeFds[2];                                ///< Self-pipe that interrupts the accept loop.
+    std::atomic<bool> stopping{false};             ///< Set once the daemon shuts down.
+
+    std::mutex queueMutex;                         ///< Guards the job maps, the slot counters and closing.
+    std::condition_variable queueReady;            ///< Signalled when a queued job can start or the daemon closes.
+    std::map<JobKey, std::unique_ptr<Job>> queued; ///< Jobs that have not started, earliest deadline first.
+    std::map<JobKey, Job*> running;                ///< Jobs holding a slot.
+    std::map<JobKey, Job*> suspended;              ///< Started jobs waiting for a slot.
+    unsigned long long arrivals = 0;               ///< Number of solve requests queued so far.
+    int slots;                                     ///< Jobs that run at the same time.
+    int freeSlots;                                 ///< Slots not held by a running job.
+    int pendingYields = 0;                         ///< Running jobs asked to suspend that have not yet.
+    bool closing = false;                          ///< Solve threads exit once the queue is empty.
+    std::vector<std::thread> workers;              ///< Solve threads; twice the slots, as suspended jobs keep theirs.
+
+    std::list<std::pair<std::shared_ptr<Connection>, std::thread>> connections; ///< Open connections and their reader threads (used by run() only).
+    std::atomic<unsigned long long> served{0};     ///< Answered solve requests.
+    std::atomic<unsigned long long> degraded{0};   ///< Solve requests run with the fallback solver.
+    std::atomic<unsigned long long> rejected{0};   ///< Solve requests refused by admission control.
+    std::atomic<unsigned long long> preempted{0};  ///< Suspensions of running jobs.
+    std::mutex latencyMutex;                       ///< Guards latencies.
+    std::vector<double> latencies;                 ///< Latest request latencies in milliseconds (ring buffer).
+    unsigned long long latencyCount = 0;           ///< Latencies recorded so far.
+
+    std::map<std::string, std::unique_ptr<SolverPool>> pools; ///< Idle solvers by registry name (filled before the workers start).
+
+    std::mutex matricesMutex;                      ///< Guards the instance cache.
+    std::list<std::shared_ptr<const Matrix>> recent; ///< Cached instances, most recently used first.
+    std::map<std::string, std::list<std::shared_ptr<const Matrix>>::iterator> matrices; ///< Cached instances by fingerprint.
+    std::map<std::string, std::pair<long long, std::string>> paths; ///< Modification time and fingerprint of loaded files by path.
+};
+
+#endif // DAEMON_H
@@ -0,0 +1,135 @@
+/**
+ * @file incumbent.h
+ * @brief Best tour shared by solvers running concurrently on the same instance.
+ */
+
+#ifndef INCUMBENT_H
+#define INCUMBENT_H
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class SharedIncumbent
+ * @brief Best known tour of a portfolio run plus its cancellation flag.
+ *
+ * Solvers publish improvements with offer() and read the cost through getCost(), which is a single atomic
+ * load so that Branch and Bound can prune against it on every node. The tour itself is guarded by a mutex
+ * and only touched on improvements. Solvers call shouldStop() at their deadline checks, which is where a run
+ * can be paused and where it stops once cancel() was called.
+ */
+class SharedIncumbent {
+public:
+    using Listener = std::function<void(int cost, const std::vector<int>& tour, const std::string& solver)>; ///< Notified of improvements.
+
+    /**
+     * @brief Sets a function called with every new incumbent, e.g. to stream improvements to a client.
+     *
+     * The listener runs on the improving solver's thread while the incumbent is locked, so improvements
+     * arrive in order; it must be set before any solver starts and should return quickly.
+     *
+     * @param listener The listener (empty to remove it).
+     */
+    void setListener(Listener listener) {
+        this->listener = std::move(listener);
+    }
+
+    /**
+     * @brief Offers a tour; it is kept if it is cheaper than the current incumbent.
+     *
+     * @param cost The cost of the tour.
+     * @param tour Visiting order of all cities without the return to the start; it may start at any city.
+     * @param solver Name of the solver that found the tour.
+     * @return True if the tour became the incumbent.
+     */
+    bool offer(int cost, const std::vector<int>& tour, const std::string& solver);
+
+    /**
+     * @brief Cost of the incumbent (INT_MAX if there is none).
+     */
+    int getCost() const {
+        return cost.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Copies the incumbent.
+     *
+     * @param tour Receives the tour (empty if there is none).
+     * @param solver Receives the name of the solver that found it.
+     * @return The cost of the incumbent.
+     */
+    int get(std::vector<int>& tour, std::string& solver) const;
+
+    /**
+     * @brief Asks every solver using this incumbent to stop.
+     */
+    void cancel() {
+        cancelled.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks whether cancel() was called.
+     */
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Called by solvers at iteration boundaries: pauses while a yield is requested, then reports cancel().
+     *
+     * @return True if the solver should stop.
+     */
+    bool shouldStop() {
+        if (yieldRequested.load(std::memory_order_acquire) && yieldHandler) {
+            yieldHandler(); // Blocks until the owner lets the run continue
+        }
+        return isCancelled() || std::chrono::steady_clock::now().time_since_epoch().count() >= stopTime.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Makes shouldStop() report a stop from a point in time on; unlike the solver deadline it can be moved,
+     *        e.g. to exclude the time a run spent paused from its budget.
+     *
+     * @param time The stop time.
+     */
+    void stopAt(std::chrono::steady_clock::time_point time) {
+        stopTime.store(time.time_since_epoch().count(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Sets the function that pauses a run, e.g. until a scheduler gives the run its CPU back.
+     *
+     * It is called by every solver thread that reaches shouldStop() while a yield is requested, and must be
+     * set before any solver starts.
+     *
+     * @param handler The handler.
+     */
+    void setYieldHandler(std::function<void()> handler) {
+        yieldHandler = std::move(handler);
+    }
+
+    /**
+     * @brief Requests or withdraws a pause at the next iteration boundary of every solver using this incumbent.
+     */
+    void requestYield(bool requested) {
+        yieldRequested.store(requested, std::memory_order_release);
+    }
+
+private:
+    std::atomic<int> cost{INT_MAX};     ///< Cost of the incumbent.
+    std::atomic<bool> cancelled{false}; ///< Set by cancel().
+    mutable std::mutex mutex;           ///< Guards tour and solver.
+    std::vector<int> tour;              ///< The incumbent tour.
+    std::string solver;                 ///< Solver that found the incumbent.
+    Listener listener;                  ///< Notified of improvements (may be empty).
+    std::atomic<bool> yieldRequested{false}; ///< Set by requestYield().
+    std::atomic<std::chrono::steady_clock::rep> stopTime{std::chrono::steady_clock::time_point::max().time_since_epoch().count()}; ///< Set by stopAt().
+    std::function<void()> yieldHandler; ///< Pauses the run (may be empty).
+};
+
+#endif // INCUMBENT_H
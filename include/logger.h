@@ -0,0 +1,184 @@
+/**
+ * @file logger.h
+ * @brief Leveled asynchronous logger with compile-time removable levels.
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "ring_buffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Lowest level compiled into the binary (0 = debug, 1 = info, 2 = warning, 3 = error).
+ *
+ * Log statements below this level expand to nothing, including the formatting of their arguments.
+ * Set through the ATSP_LOG_MIN_LEVEL CMake cache variable.
+ */
+#ifndef ATSP_LOG_MIN_LEVEL
+#define ATSP_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @enum LogLevel
+ * @brief Severity of a log message.
+ */
+enum class LogLevel { Debug = 0, Info = 1, Warning = 2, Error = 3, Off = 4 };
+
+/**
+ * @struct LogEntry
+ * @brief One queued log message.
+ */
+struct LogEntry {
+    LogLevel level = LogLevel::Info; ///< Severity, selects the prefix and the stream.
+    std::string message;             ///< Formatted message without the trailing newline.
+};
+
+/**
+ * @class Logger
+ * @brief Process-wide logger that moves terminal I/O off the calling threads.
+ *
+ * log() only places the message in a lock-free ring buffer and returns. A background
+ * thread drains the buffer, writes debug and info messages to stdout and warnings and errors to stderr,
+ * and flushes once per drained batch instead of once per line. When the buffer is full the caller yields
+ * until the writer frees a slot, so messages are never dropped.
+ *
+ * Output written directly to std::cout is not ordered with queued messages; code that mixes both calls
+ * flush() before switching back, as the solvers do at the end of a run.
+ */
+class Logger {
+public:
+    /**
+     * @brief Returns the process-wide logger, starting its writer thread on first use.
+     */
+    static Logger& instance();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Sets the lowest level that is written at run time.
+     *
+     * @param level The level.
+     */
+    void setLevel(LogLevel level);
+
+    /**
+     * @brief Checks whether messages of a level are written.
+     *
+     * @param level The level.
+     * @return True if the level is at least the run-time level.
+     */
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Queues a message.
+     *
+     * @param level The level of the message.
+     * @param message The message without the trailing newline.
+     */
+    void log(LogLevel level, std::string message);
+
+    /**
+     * @brief Blocks until every message queued before the call has been written.
+     */
+    void flush();
+
+    /**
+     * @brief Parses "debug", "info", "warning", "error" or "off".
+     *
+     * @param name The level name.
+     * @return The level.
+     * @throws std::runtime_error If the name is unknown.
+     */
+    static LogLevel parseLevel(const std::string& name);
+
+private:
+    Logger();
+    ~Logger();
+
+    MpscRingBuffer<LogEntry> ring;                 ///< Queued messages.
+    std::atomic<int> minLevel;                     ///< Run-time level threshold.
+    std::atomic<unsigned long long> queued{0};     ///< Number of messages pushed.
+    std::atomic<unsigned long long> written{0};    ///< Number of messages written.
+    std::atomic<bool> writerIdle{false};           ///< Set while the writer sleeps, so producers know to wake it.
+    std::mutex mutex;                              ///< Guards the condition variables and stopping.
+    std::condition_variable wakeUp;                ///< Wakes the writer.
+    std::condition_variable drained;               ///< Signals progress of written to flush().
+    bool stopping = false;                         ///< Set by the destructor.
+    std::thread worker;                            ///< The writer thread.
+
+    /**
+     * @brief Writer thread loop.
+     */
+    void run();
+
+    /**
+     * @brief Writes everything currently in the ring buffer.
+     *
+     * @return The number of messages written.
+     */
+    unsigned long long drain();
+
+    /**
+     * @brief Wakes the writer if it is sleeping.
+     */
+    void notifyWriter();
+};
+
+/**
+ * @brief Logs a message built with stream syntax, e.g. LOG_INFO("Cost: " << cost).
+ *
+ * The arguments are only evaluated when the level is enabled at run time.
+ */
+#define ATSP_LOG(level, message)                                          \
+    do {                                                                  \
+        if (Logger::instance().isEnabled(level)) {                        \
+            std::ostringstream atspLogMessage;                            \
+            atspLogMessage << message;                                    \
+            Logger::instance().log(level, atspLogMessage.str());          \
+        }                                                                 \
+    } while (false)
+
+#define ATSP_LOG_DISABLED(message) \
+    do {                           \
+    } while (false)
+
+#if ATSP_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(message) ATSP_LOG(LogLevel::Debug, message)
+#else
+#define LOG_DEBUG(message) ATSP_LOG_DISABLED(message)
+#endif
+
+#if ATSP_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(message) ATSP_LOG(LogLevel::Info, message)
+#else
+#define LOG_INFO(message) ATSP_LOG_DISABLED(message)
+#endif
+
+#if ATSP_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(message) ATSP_LOG(LogLevel::Warning, message)
+#else
+#define LOG_WARNING(message) ATSP_LOG_DISABLED(message)
+#endif
+
+#if ATSP_LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(message) ATSP_LOG(LogLevel::Error, message)
+#else
+#define LOG_ERROR(message) ATSP_LOG_DISABLED(message)
+#endif
+
+/**
+ * @brief True if debug messages are compiled in and enabled; guards code that only prepares debug output.
+ */
+#define LOG_DEBUG_ENABLED() (ATSP_LOG_MIN_LEVEL <= 0 && Logger::instance().isEnabled(LogLevel::Debug))
+
+#endif // LOGGER_H
@@ -2,18 +2,36 @@
 #define MAIN_H
 
 #include "util.h"
+#include "best_known.h"
 #include "Algorithms/BranchAndBound.h"
 #include "Algorithms/BruteForce.h"
 #include "Algorithms/TabuSearch.h"
-#include "Algorithms\GeneticAlgo.h"
+#include "Algorithms/GeneticAlgo.h"
+#include "Algorithms/Solver.h"
+#include "Algorithms/Portfolio.h"
 #include "matrix.h"
 #include "node.h"
+#include "result_cache.h"
+#include "checkpoint.h"
+#include "logger.h"
+#include "phase_timer.h"
+#include "scheduler.h"
+#include "daemon.h"
+#include "sweep.h"
+#include "tuner.h"
 
 #include "lib/nlohmann/json.hpp"
 
+#include <algorithm>
+#include <climits>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 /**
  * @brief Reads the configuration from a JSON object.
@@ -37,4 +55,107 @@ void readConfig(const nlohmann::json& config_json);
  */
 void runMultipleAlgorithms(int numSamples, Matrix& mat);
 
+/**
+ * @brief Runs every enabled algorithm numSamples times on each matrix through the experiment scheduler.
+ *
+ * Results go to the same CSV and columnar files as the sequential runs; the per-run console output is
+ * replaced by one progress line per finished job.
+ *
+ * @param matrices The prepared instances.
+ */
+void runScheduled(const std::vector<Matrix*>& matrices);
+
+/**
+ * @brief Serves solve requests on the configured UNIX domain socket until a client asks it to shut down.
+ *
+ * Requests without parameters of their own use the configured parameters of their solver.
+ */
+void runDaemon();
+
+/**
+ * @brief Runs the configured parameter sweep on one instance and writes every run to the sweep result file.
+ *
+ * The points run in parallel on the experiment scheduler's workers.
+ *
+ * @param mat The instance; it is prepared for the swept solver here.
+ */
+void runSweep(Matrix& mat);
+
+/**
+ * @brief Races candidate parameters of the configured solver over the training instances and writes the
+ *        tuned per-size-class profiles.
+ */
+void runTuner();
+
+/**
+ * @brief Runs one registered solver once on a matrix and records its result.
+ *
+ * @param algorithm The registry name of the solver ("bnb", "bf", "tabu", "ga", ...).
+ * @param mat The matrix.
+ * @param sample The 1-based sample number, used in the console output.
+ * @param run Checkpoint run identifier (empty when runs of the algorithm on the matrix never overlap).
+ * @param verbose Whether to print the solution and the elapsed time.
+ * @return A short summary with the cost and the elapsed time.
+ */
+std::string runAlgorithm(const std::string& algorithm, Matrix& mat, int sample, const std::string& run, bool verbose);
+
+/**
+ * @brief Builds the solver parameters of an algorithm from the configuration.
+ *
+ * @param algorithm The registry name of the solver.
+ * @return The parameters of its SolveRequest.
+ */
+nlohmann::json solverParameters(const std::string& algorithm);
+
+/**
+ * @brief Queues a result for the results files of its solver.
+ *
+ * @param result The result.
+ * @param size The instance size.
+ */
+void saveResult(const SolveResult& result, int size);
+
+/**
+ * @brief Prints a tour and its cost, closing the tour with the start city, and the gap to the best known cost of a TSPLIB instance.
+ *
+ * @param solver The solver name.
+ * @param cost The cost of the tour.
+ * @param tour The tour without the return to the start (empty if none was found).
+ */
+void printTour(const std::string& solver, int cost, const std::vector<int>& tour);
+
+/**
+ * @brief Names of the algorithms enabled in the configuration, in execution order.
+ */
+std::vector<std::string> enabledAlgorithms();
+
+/**
+ * @brief Displays a matrix and builds the auxiliary structures the enabled algorithms use.
+ *
+ * @param mat The matrix.
+ */
+void prepareMatrix(Matrix& mat);
+
+/**
+ * @brief Prints the cached result of an exact solver if the result cache holds one.
+ *
+ * @param mat The instance.
+ * @param solver The exact solver name ("bnb" or "bf").
+ * @param print Whether to print the cached solution.
+ * @return True if the result was served from the cache and the solver does not need to run.
+ */
+bool serveExactFromCache(const Matrix& mat, const std::string& solver, bool print = true);
+
+/**
+ * @brief Stores a solver result in the result cache (no-op when caching is disabled).
+ *
+ * @param mat The instance.
+ * @param solver The solver name.
+ * @param parameters The canonical parameter string of the run.
+ * @param exact Whether the cost is a proven optimum.
+ * @param cost The tour cost (INT_MAX if no tour was found).
+ * @param tour The tour, optionally closed with the start city.
+ */
+void storeResult(const Matrix& mat, const std::string& solver, const std::string& parameters, bool exact, int cost, std::vector<int> tour);
+
 #endif // MAIN_H
\ No newline at end of file
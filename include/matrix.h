@@ -8,6 +8,11 @@
 #include <sstream>
 #include <iomanip>
 #include <random>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "candidates.h"
+#include "cost_provider.h"
 
 /**
  * @class Matrix
@@ -20,8 +25,57 @@ class Matrix {
 private:
     int size; ///< The size of the matrix (number of rows/columns).
     int* data; ///< Pointer to the matrix data (flat 1D array to simulate a 2D matrix).
+    int* transposed; ///< Optional column-major copy of data (nullptr until buildTransposed() is called).
+    CandidateLists* candidateLists; ///< Optional k-nearest neighbour lists (nullptr until buildCandidateLists() is called).
+    bool symmetric; ///< True if cost(i, j) == cost(j, i) for every pair of cities (detected at load time).
+    bool packed; ///< True if data holds only the upper triangle (diagonal included), row by row.
+    CostProvider* provider; ///< Optional on-demand cost function; when set, data is not allocated.
+    unsigned long long providerId; ///< Unique id identifying this matrix's rows in the per-thread row cache.
+    int rowCacheSize; ///< Number of rows each thread keeps materialized for a provider-backed matrix.
+    int forbiddenEdgeCount; ///< Number of off-diagonal entries at or above FORBIDDEN_COST.
+    int* adjacencyOffsets; ///< CSR row offsets (size + 1) of the allowed edges, or nullptr if no edge is forbidden.
+    int* adjacencyTargets; ///< CSR successor indices of the allowed edges, grouped by source city.
+    unsigned long long contentHash; ///< Fingerprint of the size and all costs (computed at load time).
+    std::function<void()> releaseView; ///< Releases data when it is a view of memory owned elsewhere (empty when data is owned).
+
+    /**
+     * @brief Releases the derived data (transposed copy, candidate lists), e.g. after the matrix contents change.
+     */
+    void clearDerived();
+
+    /**
+     * @brief Detects whether the loaded matrix is symmetric and, if so, repacks it as an upper triangle.
+     *
+     * A packed symmetric matrix uses size * (size + 1) / 2 elements instead of size * size.
+     */
+    void detectSymmetry();
+
+    /**
+     * @brief Frees the stored costs, derived data and cost provider, returning the matrix to an empty state.
+     */
+    void resetStorage();
+
+    /**
+     * @brief Returns a row of a provider-backed matrix from the calling thread's LRU row cache.
+     *
+     * @param i The index of the city.
+     * @return Pointer to the materialized row, valid until the thread requests rowCacheSize other rows.
+     */
+    const int* cachedRow(int i) const;
+
+    /**
+     * @brief Counts the forbidden edges and, if there are any, builds the CSR index of the allowed ones.
+     */
+    void detectForbiddenEdges();
+
+    /**
+     * @brief Computes contentHash from the current contents.
+     */
+    void computeFingerprint();
 
 public:
+    static const int FORBIDDEN_COST = 100000000; ///< TSPLIB sentinel cost marking a missing edge.
+
     /**
      * @brief Constructor to initialize the matrix with a given size.
      * 
@@ -34,13 +88,60 @@ public:
      */
     ~Matrix();
 
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+
     /**
      * @brief Function to read matrix from a file.
      * 
+     * Files ending in ".gz" are decompressed first (requires a build with zlib).
+     * 
      * @param filename The name of the file to read the matrix from.
+     * @throws std::runtime_error If the file cannot be read or has an invalid format.
      */
     void readFromFile(const std::string& filename);
 
+    /**
+     * @brief Reads a matrix in either of the two supported text formats.
+     * 
+     * The plain format is the size on the first line followed by the rows. The TSPLIB format starts with
+     * "KEY: value" specification lines (DIMENSION, EDGE_WEIGHT_TYPE EXPLICIT, EDGE_WEIGHT_FORMAT FULL_MATRIX)
+     * followed by EDGE_WEIGHT_SECTION and the rows. Diagonal entries are ignored.
+     * 
+     * @param input The text.
+     * @throws std::runtime_error If the format is invalid or entries are missing.
+     */
+    void readFromStream(std::istream& input);
+
+    /**
+     * @brief Function to load the matrix from costs held in memory.
+     *
+     * The diagonal is set to 0, as when reading from a file.
+     *
+     * @param s The size of the matrix.
+     * @param costs The s * s costs in row-major order.
+     */
+    void setCosts(int s, const std::vector<int>& costs);
+
+    /**
+     * @brief Function to use costs held elsewhere, e.g. a read-only shared memory mapping, without copying them.
+     *
+     * The matrix never writes to the costs, so at() must not be used on it, and symmetric costs are not packed.
+     *
+     * @param s The size of the matrix.
+     * @param costs The s * s costs in row-major order; the diagonal must be 0.
+     * @param release Called once the matrix no longer uses the costs (may be empty).
+     * @throws std::invalid_argument If the size is not positive or a diagonal entry is not 0.
+     */
+    void setView(int s, const int* costs, std::function<void()> release);
+
+    /**
+     * @brief Function to check whether the costs are a view set by setView().
+     *
+     * @return True if the matrix does not own its costs.
+     */
+    bool isView() const;
+
     /**
      * @brief Function to generate a random matrix with symmetricity control.
      * 
@@ -53,6 +154,45 @@ public:
      */
     void generateRandomMatrix(int s, int minValue, int maxValue, int symmetricity, int asymRangeMin, int asymRangeMax);
 
+    /**
+     * @brief Function to back the matrix by a cost function instead of a stored array.
+     *
+     * Costs are computed on demand, so the memory use is independent of size * size.
+     * The matrix takes ownership of the provider.
+     *
+     * @param costProvider The cost function (deleted by the matrix).
+     * @param cacheRows The number of rows each thread keeps materialized for getRow().
+     */
+    void setCostProvider(CostProvider* costProvider, int cacheRows);
+
+    /**
+     * @brief Function to read city coordinates from a file and back the matrix by a CoordinateCostProvider.
+     *
+     * The first line holds the number of cities, followed by one "x y" pair per city.
+     *
+     * @param filename The name of the file to read the coordinates from.
+     * @param directionPenalty The extra cost per unit of y gained along an edge.
+     * @param cacheRows The number of rows each thread keeps materialized for getRow().
+     */
+    void readCoordinatesFromFile(const std::string& filename, double directionPenalty, int cacheRows);
+
+    /**
+     * @brief Function to generate random city coordinates and back the matrix by a CoordinateCostProvider.
+     *
+     * @param s The number of cities.
+     * @param maxCoordinate Coordinates are drawn uniformly from [0, maxCoordinate].
+     * @param directionPenalty The extra cost per unit of y gained along an edge.
+     * @param cacheRows The number of rows each thread keeps materialized for getRow().
+     */
+    void generateRandomCoordinates(int s, double maxCoordinate, double directionPenalty, int cacheRows);
+
+    /**
+     * @brief Checks whether costs are computed on demand by a cost provider.
+     *
+     * @return True if the matrix is backed by a CostProvider.
+     */
+    bool isImplicit() const;
+
     /**
      * @brief Function to get the cost between two cities.
      * 
@@ -69,11 +209,132 @@ public:
      */
     int getSize() const;
 
+    /**
+     * @brief Checks whether the matrix is symmetric.
+     *
+     * Symmetric instances are stored packed and enable the direction-agnostic solver paths.
+     *
+     * @return True if cost(i, j) == cost(j, i) for every pair of cities.
+     */
+    bool isSymmetric() const;
+
+    /**
+     * @brief Builds a column-major copy of the matrix.
+     *
+     * After this call getColumn() returns contiguous columns, so kernels that scan
+     * incoming costs (cost(j, city) for all j) walk memory sequentially instead of
+     * striding by the row length. Symmetric matrices need no copy, so this is a no-op for them,
+     * as it is for provider-backed matrices, which are never materialized.
+     */
+    void buildTransposed();
+
+    /**
+     * @brief Checks whether the transposed copy has been built.
+     *
+     * @return True if getColumn() is available.
+     */
+    bool hasTransposed() const;
+
+    /**
+     * @brief Function to get a contiguous row of the matrix (outgoing costs of a city).
+     *
+     * @param i The index of the city.
+     * @return Pointer to size elements, element j being the cost from i to j,
+     *         or nullptr if the matrix is stored packed (use getCost() instead).
+     *         For provider-backed matrices the row comes from a per-thread cache and stays valid
+     *         until the calling thread requests rowCacheSize other rows.
+     */
+    const int* getRow(int i) const;
+
+    /**
+     * @brief Function to get a contiguous column of the matrix (incoming costs of a city).
+     *
+     * @param j The index of the city.
+     * @return Pointer to size elements, element i being the cost from i to j,
+     *         or nullptr if no contiguous column is available (use getCost() instead).
+     *         For symmetric matrices this is the row of j.
+     */
+    const int* getColumn(int j) const;
+
+    /**
+     * @brief Checks whether the matrix contains forbidden edges (cost at or above FORBIDDEN_COST).
+     *
+     * @return True if at least one off-diagonal edge is forbidden.
+     */
+    bool hasForbiddenEdges() const;
+
+    /**
+     * @brief Checks whether the edge between two cities is forbidden.
+     *
+     * @param i The index of the first city.
+     * @param j The index of the second city.
+     * @return True if i != j and the cost from i to j is at or above FORBIDDEN_COST.
+     */
+    bool isForbidden(int i, int j) const;
+
+    /**
+     * @brief Function to get the number of allowed (non-forbidden) successors of a city.
+     *
+     * Only available when hasForbiddenEdges() is true.
+     *
+     * @param city The index of the city.
+     * @return The number of entries returned by getAllowedSuccessors().
+     */
+    int getAllowedSuccessorCount(int city) const;
+
+    /**
+     * @brief Function to get the allowed (non-forbidden) successors of a city from the CSR index.
+     *
+     * @param city The index of the city.
+     * @return Pointer to getAllowedSuccessorCount(city) city indices in ascending order,
+     *         or nullptr if the matrix has no forbidden edges.
+     */
+    const int* getAllowedSuccessors(int city) const;
+
+    /**
+     * @brief Clamps a 64-bit path cost to the int range so that sums of forbidden edges cannot overflow.
+     *
+     * @param cost The accumulated cost.
+     * @return The cost, or INT_MAX if it does not fit into an int.
+     */
+    static int saturateCost(long long cost);
+
+    /**
+     * @brief Builds the k-nearest successor/predecessor lists shared by the heuristic solvers.
+     *
+     * @param k The number of candidates per city.
+     */
+    void buildCandidateLists(int k);
+
+    /**
+     * @brief Function to get the candidate lists of the matrix.
+     *
+     * @return The candidate lists, or nullptr if buildCandidateLists() has not been called.
+     */
+    const CandidateLists* getCandidateLists() const;
+
+    /**
+     * @brief Function to get a fingerprint of the matrix contents.
+     *
+     * Matrices with equal size and costs have equal fingerprints regardless of how they are stored,
+     * which makes the fingerprint usable as a cache key for per-instance results.
+     *
+     * @return The fingerprint as 16 hexadecimal digits.
+     */
+    std::string getFingerprint() const;
+
     /**
      * @brief Function to display the matrix.
      */
     void display() const;
 
+    /**
+     * @brief Function to display a one-line summary of the matrix (size, storage, cost range, fingerprint).
+     *
+     * Printing every entry dominates short runs on large instances, so this is the default.
+     */
+    void displaySummary() const;
+
     /**
      * @brief Function to access elements (row, col) in the matrix.
      * 
@@ -0,0 +1,54 @@
+/**
+ * @file matrix_image.h
+ * @brief Binary matrix layout shared between processes through a memory file descriptor.
+ */
+
+#ifndef MATRIX_IMAGE_H
+#define MATRIX_IMAGE_H
+
+#include <cstdint>
+#include <memory>
+#include "matrix.h"
+
+/**
+ * @struct MatrixImageHeader
+ * @brief Start of a matrix image; the costs follow at costsOffset as size * size native-endian int32 values in
+ *        row-major order, with a zero diagonal.
+ */
+struct MatrixImageHeader {
+    char magic[8];         ///< "ATSPMAT1".
+    uint32_t size;         ///< Number of cities.
+    uint32_t costsOffset;  ///< Byte offset of the costs from the start of the image (at least sizeof(MatrixImageHeader)).
+};
+
+/**
+ * @brief The magic bytes of a matrix image.
+ */
+extern const char MATRIX_IMAGE_MAGIC[8];
+
+/**
+ * @brief Maps a matrix image read-only.
+ *
+ * A memfd sealed with F_SEAL_WRITE and F_SEAL_SHRINK cannot change under the matrix, so the matrix becomes a view
+ * of the mapping and nothing is copied. Any other descriptor could still be modified by its owner and has its
+ * costs copied once: a POSIX shared memory segment, or a memfd sealed only with F_SEAL_FUTURE_WRITE, which
+ * leaves writable mappings made before the seal in place.
+ * The descriptor may be closed afterwards.
+ *
+ * @param fd The descriptor.
+ * @return The matrix.
+ * @throws std::invalid_argument If the descriptor does not hold a valid image.
+ * @throws std::runtime_error If it cannot be mapped.
+ */
+std::unique_ptr<Matrix> mapMatrixImage(int fd);
+
+/**
+ * @brief Writes a matrix into a new memfd and seals it, ready to be passed to mapMatrixImage() in another process.
+ *
+ * @param matrix The matrix.
+ * @return The descriptor; the caller closes it.
+ * @throws std::runtime_error If the memfd cannot be created.
+ */
+int createMatrixImage(const Matrix& matrix);
+
+#endif // MATRIX_IMAGE_H
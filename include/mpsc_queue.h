@@ -0,0 +1,70 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Unbounded lock-free multi-producer single-consumer queue.
+ *
+ * Producers link new nodes with a single atomic exchange, so push() never blocks or spins on
+ * other producers. Only one thread may call pop(). Based on Dmitry Vyukov's intrusive MPSC queue.
+ *
+ * @tparam T The element type (must be default-constructible and movable).
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(new Node()), tail(head.load(std::memory_order_relaxed)) {}
+
+    ~MpscQueue() {
+        T discarded;
+        while (pop(discarded)) {
+        }
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends an element; safe to call from any number of threads concurrently.
+     *
+     * @param value The element to append.
+     */
+    void push(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes the oldest element; must only be called from the consumer thread.
+     *
+     * @param out Receives the element.
+     * @return True if an element was removed, false if the queue is (momentarily) empty.
+     */
+    bool pop(T& out) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        out = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> head; ///< Most recently pushed node (shared by producers).
+    Node* tail;              ///< Stub node before the oldest element (consumer only).
+};
+
+#endif // MPSC_QUEUE_H
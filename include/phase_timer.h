@@ -0,0 +1,184 @@
+/**
+ * @file phase_timer.h
+ * @brief Scoped timers for the phases inside GA generations and Tabu Search iterations.
+ *
+ * Built only with the ATSP_PHASE_TIMERS CMake option. Without it PHASE_TIMER() and PHASE_TIMER_REPORT()
+ * expand to nothing and this header declares nothing else, so the solvers carry no timing code at all.
+ */
+
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#ifdef ATSP_PHASE_TIMERS
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <time.h>
+
+/**
+ * @enum Phase
+ * @brief The timed phases. Crossover and mutation run inside offspring generation, fitness inside
+ * selection, and the tabu checks inside the neighbourhood evaluation.
+ */
+enum class Phase {
+    GaGenerateOffspring, ///< GeneticAlgorithm::generateOffspring, one sample per generation.
+    GaCrossover,         ///< One crossover producing two offspring.
+    GaMutation,          ///< One mutation of a copied parent.
+    GaFitness,           ///< Costing the combined population, one sample per generation.
+    GaSelection,         ///< GeneticAlgorithm::selection, one sample per generation.
+    TabuNeighbourhood,   ///< Evaluating the neighbourhood, one sample per iteration.
+    TabuCheck,           ///< One tabu list lookup.
+    Count                ///< Number of phases.
+};
+
+/**
+ * @class PhaseHistogram
+ * @brief Log-linear histogram of durations in nanoseconds.
+ *
+ * Durations below 16 ns get a bucket each; above that every power of two is split into 8 buckets, so a
+ * percentile is off by at most 12.5%.
+ */
+class PhaseHistogram {
+public:
+    static const int SUB_BUCKETS = 8;                     ///< Buckets per power of two.
+    static const int BUCKETS = 16 + (64 - 4) * SUB_BUCKETS; ///< Covers every 64-bit duration.
+
+    /**
+     * @brief Adds one duration.
+     *
+     * @param nanoseconds The duration.
+     */
+    void record(uint64_t nanoseconds) {
+        ++buckets[bucketOf(nanoseconds)];
+        ++count;
+        total += nanoseconds;
+        if (nanoseconds > maximum) maximum = nanoseconds;
+    }
+
+    /**
+     * @brief Adds the durations of another histogram.
+     *
+     * @param other The histogram to add.
+     */
+    void merge(const PhaseHistogram& other);
+
+    /**
+     * @brief Estimates a percentile.
+     *
+     * @param fraction The percentile as a fraction (0.5 for the median).
+     * @return The upper end of the bucket holding it, in nanoseconds (0 if empty).
+     */
+    uint64_t percentile(double fraction) const;
+
+    uint64_t count = 0;   ///< Number of durations.
+    uint64_t total = 0;   ///< Sum of the durations.
+    uint64_t maximum = 0; ///< Longest duration.
+
+private:
+    uint64_t buckets[BUCKETS] = {}; ///< Durations per bucket.
+
+    static int bucketOf(uint64_t nanoseconds) {
+        if (nanoseconds < 16) {
+            return static_cast<int>(nanoseconds);
+        }
+        int exponent = 63 - __builtin_clzll(nanoseconds); // >= 4
+        int sub = static_cast<int>((nanoseconds >> (exponent - 3)) & (SUB_BUCKETS - 1));
+        return 16 + (exponent - 4) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t upperBoundOf(int bucket);
+};
+
+/**
+ * @class PhaseTimers
+ * @brief Per-thread phase histograms and their merged report.
+ *
+ * Every thread records into its own histograms without locks or atomics; they are registered on the
+ * thread's first timed phase and kept after it exits. report() merges all threads, so it must only be
+ * called while no timed code runs, e.g. after the experiments have finished.
+ */
+class PhaseTimers {
+public:
+    /**
+     * @brief The calling thread's histogram of a phase.
+     *
+     * @param phase The phase.
+     * @return The histogram.
+     */
+    static PhaseHistogram& local(Phase phase);
+
+    /**
+     * @brief Monotonic timestamp that is not slewed by NTP.
+     *
+     * @return Nanoseconds since an arbitrary start.
+     */
+    static uint64_t now() {
+#ifdef CLOCK_MONOTONIC_RAW
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+        return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Prints calls, total time and percentiles per phase, merged over all threads.
+     *
+     * @param out The stream to print to.
+     */
+    static void report(std::ostream& out);
+
+    /**
+     * @brief Clears the histograms of all threads.
+     */
+    static void reset();
+
+    /**
+     * @brief Name of a phase in the report ("ga.crossover").
+     *
+     * @param phase The phase.
+     * @return The name.
+     */
+    static const char* name(Phase phase);
+};
+
+/**
+ * @class ScopedPhaseTimer
+ * @brief Records the time from its construction to its destruction under a phase.
+ */
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(Phase phase) : phase(phase), start(PhaseTimers::now()) {}
+    ~ScopedPhaseTimer() { PhaseTimers::local(phase).record(PhaseTimers::now() - start); }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    Phase phase;    ///< The timed phase.
+    uint64_t start; ///< Timestamp at construction.
+};
+
+#define PHASE_TIMER_CONCAT_(a, b) a##b
+#define PHASE_TIMER_NAME_(line) PHASE_TIMER_CONCAT_(phaseTimer, line)
+
+/**
+ * @brief Times the rest of the enclosing scope under a phase, e.g. PHASE_TIMER(Phase::GaSelection).
+ */
+#define PHASE_TIMER(phase) ScopedPhaseTimer PHASE_TIMER_NAME_(__LINE__)(phase)
+
+/**
+ * @brief Prints the phase breakdown to a stream.
+ */
+#define PHASE_TIMER_REPORT(out) PhaseTimers::report(out)
+
+#else
+
+#define PHASE_TIMER(phase) do { } while (0)
+#define PHASE_TIMER_REPORT(out) do { } while (0)
+
+#endif // ATSP_PHASE_TIMERS
+
+#endif // PHASE_TIMER_H
@@ -0,0 +1,104 @@
+/**
+ * @file result_cache.h
+ * @brief Content-addressed on-disk cache of solver results keyed by instance fingerprint and solver parameters.
+ */
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "matrix.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct CachedResult
+ * @brief A tour stored in the result cache.
+ */
+struct CachedResult {
+    std::string solver;     ///< Short solver name ("bnb", "bf", "tabu", "ga").
+    std::string parameters; ///< Canonical parameter string the tour was produced with.
+    bool exact = false;     ///< Whether the cost is a proven optimum.
+    int cost = 0;           ///< Cost of the tour.
+    std::vector<int> tour;  ///< Visiting order of all cities, without the return to the start.
+};
+
+/**
+ * @class ResultCache
+ * @brief Stores solver results under <directory>/<fingerprint>/<solver>-<key>.res.
+ *
+ * Entries are written to a temporary file and renamed into place, so concurrent processes sharing a
+ * directory never observe partial entries; the last writer of an entry wins. Temporaries left behind by a
+ * crashed writer are deleted by the next cache opened on the directory once they are an hour old. Lookups refresh the
+ * modification time of the entry and the cache evicts the least recently used entries once its total
+ * size exceeds the configured bound. I/O errors are reported on stderr and treated as cache misses.
+ */
+class ResultCache {
+public:
+    /**
+     * @brief Opens (and creates if needed) a cache directory and deletes its stale temporary files.
+     *
+     * @param directory The cache directory.
+     * @param maxBytes Upper bound on the total size of the entries (0 disables eviction).
+     * @throws std::runtime_error If the directory cannot be created.
+     */
+    ResultCache(const std::string& directory, unsigned long long maxBytes);
+
+    /**
+     * @brief Looks up the result of a solver run on an instance.
+     *
+     * @param matrix The instance.
+     * @param solver The solver name.
+     * @param parameters The canonical parameter string of the run.
+     * @param result Receives the entry on a hit.
+     * @return True on a hit.
+     */
+    bool lookup(const Matrix& matrix, const std::string& solver, const std::string& parameters, CachedResult& result);
+
+    /**
+     * @brief Stores the result of a solver run on an instance, replacing an existing entry.
+     *
+     * @param matrix The instance.
+     * @param result The result; its solver and parameters form the key.
+     */
+    void store(const Matrix& matrix, const CachedResult& result);
+
+    /**
+     * @brief Finds the cheapest tour cached for an instance by any solver.
+     *
+     * Useful as an upper bound or initial tour for a later run.
+     *
+     * @param matrix The instance.
+     * @param result Receives the cheapest entry.
+     * @return True if any entry exists for the instance.
+     */
+    bool bestKnownTour(const Matrix& matrix, CachedResult& result);
+
+private:
+    std::string directory;       ///< Root directory of the cache.
+    unsigned long long maxBytes; ///< Eviction threshold in bytes (0 = unbounded).
+
+    /**
+     * @brief Path of the entry for a solver run.
+     */
+    std::string entryPath(const Matrix& matrix, const std::string& solver, const std::string& parameters) const;
+
+    /**
+     * @brief Reads and validates an entry file.
+     *
+     * @return False if the file is missing, corrupt or belongs to another instance size.
+     */
+    bool readEntry(const std::string& path, const Matrix& matrix, CachedResult& result) const;
+
+    /**
+     * @brief Removes the least recently used entries until the cache is below 90% of maxBytes.
+     */
+    void evict();
+
+    /**
+     * @brief Deletes "*.res.tmp.*" files of interrupted stores that are more than an hour old.
+     */
+    void removeStaleTemporaries();
+};
+
+#endif // RESULT_CACHE_H
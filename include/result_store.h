@@ -0,0 +1,86 @@
+/**
+ * @file result_store.h
+ * @brief Append-only binary columnar store for result records.
+ *
+ * File layout (little-endian):
+ * - Header: magic "ATSPCOL1", uint32 column count, then per column a 32-byte NUL-padded name,
+ *   a uint8 type code and 3 padding bytes.
+ * - Blocks, one per append: magic "BLK1", uint32 row count, then per column a double min and
+ *   double max, followed by each column's values stored contiguously and padded to 8 bytes.
+ *
+ * A sidecar "<path>.idx" lists (uint64 block offset, uint32 row count, uint32 reserved) per block
+ * so readers can locate blocks without scanning. python/result_store.py memory-maps both files.
+ */
+
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include "results_writer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class ColumnarResultStore
+ * @brief Appends blocks of ResultRecords to one columnar store file.
+ */
+class ColumnarResultStore {
+public:
+    /**
+     * @brief Type codes of the stored columns.
+     */
+    enum ColumnType : uint8_t {
+        Int32 = 1,   ///< int32_t
+        Float32 = 2, ///< float
+        Char = 3,    ///< single byte
+        String8 = 4, ///< 8-byte NUL-padded string
+        Int64 = 5    ///< int64_t
+    };
+
+    /**
+     * @brief Opens (or creates) a store file and validates its schema.
+     *
+     * @param path The store file path; the block index is written to path + ".idx".
+     * @throws std::runtime_error if the file cannot be opened or has a different schema.
+     */
+    explicit ColumnarResultStore(const std::string& path);
+
+    /**
+     * @brief Destructor to close the store files.
+     */
+    ~ColumnarResultStore();
+
+    ColumnarResultStore(const ColumnarResultStore&) = delete;
+    ColumnarResultStore& operator=(const ColumnarResultStore&) = delete;
+
+    /**
+     * @brief Appends the records as one block with per-column min/max statistics.
+     *
+     * @param records The records to append.
+     */
+    void append(const std::vector<const ResultRecord*>& records);
+
+    /**
+     * @brief Flushes both files and optionally forces them to stable storage.
+     *
+     * @param sync True to fsync after flushing.
+     */
+    void flush(bool sync);
+
+    /**
+     * @brief Maps a CSV result path to its store path ("x.csv" -> "x.atspcol").
+     *
+     * @param csvPath The CSV result path.
+     * @return The store path.
+     */
+    static std::string storePathFor(const std::string& csvPath);
+
+private:
+    std::FILE* data;  ///< The store file.
+    std::FILE* index; ///< The block index file.
+    std::string path; ///< The store file path.
+};
+
+#endif // RESULT_STORE_H
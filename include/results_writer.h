@@ -0,0 +1,212 @@
+/**
+ * @file results_writer.h
+ * @brief Typed result records and the asynchronous writer that appends them to result files.
+ */
+
+#ifndef RESULTS_WRITER_H
+#define RESULTS_WRITER_H
+
+#include "mpsc_queue.h"
+#include "search_counters.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ColumnarResultStore;
+
+/**
+ * @struct ResultRecord
+ * @brief One result line, with the columns written depending on its kind.
+ *
+ * The CSV layouts match the files the python analysis scripts read:
+ * - Timing:  algoName, problemSize, time
+ * - Tabu:    algoName, problemSize, time, bestCost
+ * - Genetic: algoName, problemSize, time, bestCost, populationSize, mutationRate, randomRate,
+ *            crossoverRate, mutationType, iterationNum, crossingSegmentSizeRate,
+ *            mutationSegmentSizeRate, randomRateNewGen
+ * - Sweep:   algoName, problemSize, time, bestCost, sweepPoint, the Genetic parameter columns, tabuSize,
+ *            maxIterations (the columns of the other solver are 0)
+ *
+ * The search counters are only written to the columnar store, as counts and per-second rates.
+ */
+struct ResultRecord {
+    enum class Kind { Timing, Tabu, Genetic, Sweep };
+
+    Kind kind = Kind::Timing;          ///< Which columns are written.
+    std::string resultPath;            ///< File the record is appended to.
+    std::string algoName;              ///< Short algorithm name ("bnb", "bf", "tabu", "ga").
+    int problemSize = 0;               ///< Number of cities.
+    float time = 0;                    ///< Elapsed time in milliseconds.
+    int bestCost = 0;                  ///< Cost of the best tour (Tabu, Genetic).
+    int populationSize = 0;            ///< GA population size.
+    float mutationRate = 0;            ///< GA mutation rate in percent.
+    float crossoverRate = 0;           ///< GA crossover rate in percent.
+    char mutationType = 'i';           ///< GA mutation type ('i' or 's').
+    float randomRateNewGen = 0;        ///< GA share of random chromosomes per generation in percent.
+    int iterationNum = 0;              ///< GA number of generations.
+    float crossingSegmentSizeRate = 0; ///< GA crossover segment size in percent.
+    float mutationSegmentSizeRate = 0; ///< GA mutation segment size in percent.
+    float randomRate = 0;              ///< GA random offspring rate in percent.
+    int sweepPoint = 0;                ///< Index of the parameter sweep point (Sweep).
+    int tabuSize = 0;                  ///< Tabu list size (Sweep).
+    int maxIterations = 0;             ///< Tabu Search iteration limit (Sweep).
+    SearchCounters counters;           ///< Search counters of the run (columnar store only).
+
+    /**
+     * @brief Formats the record as one CSV line (without the trailing newline).
+     *
+     * @return The CSV line.
+     */
+    std::string toCsv() const;
+};
+
+/**
+ * @class ResultsWriter
+ * @brief Process-wide results sink with a single long-lived writer thread.
+ *
+ * Any thread can call write(); records go through a lock-free queue and are appended in
+ * batches by the writer thread, which keeps every result file open for the whole run.
+ */
+class ResultsWriter {
+public:
+    /**
+     * @brief When the writer forces written data to stable storage.
+     */
+    enum class FsyncPolicy {
+        Never,      ///< Leave it to the operating system.
+        EveryBatch, ///< fsync every file touched by a batch.
+        OnClose     ///< fsync when the files are closed at shutdown.
+    };
+
+    /**
+     * @brief Returns the process-wide writer, starting its thread on first use.
+     *
+     * @return The writer.
+     */
+    static ResultsWriter& instance();
+
+    /**
+     * @brief Adjusts the batching and durability settings.
+     *
+     * @param policy The fsync policy.
+     * @param maxBatchSize Pending records that wake the writer before the flush interval expires.
+     * @param flushIntervalMs Maximum time a record waits in the queue.
+     */
+    void configure(FsyncPolicy policy, int maxBatchSize, int flushIntervalMs);
+
+    /**
+     * @brief Selects the output formats.
+     *
+     * @param csv Append CSV lines to record.resultPath.
+     * @param columnar Append blocks to the columnar store next to it ("x.csv" -> "x.atspcol").
+     */
+    void setFormats(bool csv, bool columnar);
+
+    /**
+     * @brief Queues a record; never blocks on I/O.
+     *
+     * @param record The record to write.
+     */
+    void write(ResultRecord record);
+
+    /**
+     * @brief Blocks until every record whose write() returned before this call, on any thread, has been written.
+     *
+     * Records queued while it waits may be written as well but are not waited for.
+     *
+     * @throws std::runtime_error if a result file could not be opened or written since the last flush.
+     */
+    void flush();
+
+    /**
+     * @brief Parses an fsync policy name ("never", "batch", "close").
+     *
+     * @param name The policy name.
+     * @return The policy.
+     */
+    static FsyncPolicy parseFsyncPolicy(const std::string& name);
+
+    ResultsWriter(const ResultsWriter&) = delete;
+    ResultsWriter& operator=(const ResultsWriter&) = delete;
+
+private:
+    /**
+     * @struct Entry
+     * @brief A queued record, or a flush marker that the writer confirms once everything before it is written.
+     */
+    struct Entry {
+        ResultRecord record;            ///< The record (unused for a marker).
+        unsigned long long flushTicket = 0; ///< Ticket of the flush() call for a marker, 0 for a record.
+    };
+
+    ResultsWriter();
+    ~ResultsWriter();
+
+    /**
+     * @brief Writer thread loop: drains the queue in batches until shutdown.
+     */
+    void run();
+
+    /**
+     * @brief Writes every record currently in the queue.
+     *
+     * @return The ticket of the last flush marker among them (0 if there was none).
+     */
+    unsigned long long drain();
+
+    /**
+     * @brief Appends a batch to the CSV files.
+     *
+     * @param batch The records to write.
+     */
+    void writeCsv(const std::vector<ResultRecord>& batch);
+
+    /**
+     * @brief Appends a batch to the columnar stores, one block per store.
+     *
+     * @param batch The records to write.
+     */
+    void writeColumnar(const std::vector<ResultRecord>& batch);
+
+    /**
+     * @brief Remembers the first error since the last flush.
+     *
+     * @param error The error message.
+     */
+    void reportError(const std::string& error);
+
+    /**
+     * @brief Returns the open file for a result path, opening it in append mode if needed.
+     *
+     * @param path The result path.
+     * @return The file, or nullptr if it cannot be opened.
+     */
+    std::FILE* fileFor(const std::string& path);
+
+    MpscQueue<Entry> queue;                     ///< Records and flush markers waiting to be written.
+    std::map<std::string, std::FILE*> files;    ///< Open result files (writer thread only).
+    std::map<std::string, std::unique_ptr<ColumnarResultStore>> stores; ///< Open columnar stores (writer thread only).
+    std::thread worker;                         ///< The writer thread.
+    std::mutex mutex;                           ///< Guards the condition variables, the flush tickets and error text.
+    std::condition_variable wake;               ///< Wakes the writer thread.
+    std::condition_variable progress;           ///< Signals flush() waiters.
+    std::atomic<bool> stopping;                 ///< Set at shutdown.
+    unsigned long long flushTickets = 0;        ///< Flush markers queued so far, in queue order (guarded by mutex).
+    unsigned long long flushedTicket = 0;       ///< Last flush marker whose preceding records are written (guarded by mutex).
+    std::atomic<int> pending;                   ///< Records queued since the writer last woke.
+    std::atomic<int> maxBatchSize;              ///< Pending records that trigger an early wake-up.
+    std::atomic<int> flushIntervalMs;           ///< Maximum time a record waits in the queue.
+    std::atomic<FsyncPolicy> fsyncPolicy;       ///< Durability policy.
+    std::atomic<bool> csvOutput;                ///< Write CSV lines.
+    std::atomic<bool> columnarOutput;           ///< Write columnar store blocks.
+    std::string lastError;                      ///< First error since the last flush (guarded by mutex).
+};
+
+#endif // RESULTS_WRITER_H
@@ -0,0 +1,100 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class MpscRingBuffer
+ * @brief Bounded lock-free multi-producer single-consumer ring buffer.
+ *
+ * Each cell carries a sequence number that tells producers whether it is free and the consumer whether
+ * it is filled, so producers only contend on one compare-and-swap of the enqueue position and nothing
+ * is allocated after construction. Based on Dmitry Vyukov's bounded MPMC queue, with the dequeue side
+ * simplified for a single consumer.
+ *
+ * @tparam T The element type (must be default-constructible and movable).
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    /**
+     * @brief Creates an empty ring buffer.
+     *
+     * @param capacity Minimum number of elements; rounded up to a power of two.
+     */
+    explicit MpscRingBuffer(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) rounded <<= 1;
+        mask = rounded - 1;
+        cells.reset(new Cell[rounded]);
+        for (size_t i = 0; i < rounded; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief Appends an element unless the buffer is full; safe to call from any number of threads.
+     *
+     * @param value The element; moved from only on success.
+     * @return False if the buffer is full.
+     */
+    bool tryPush(T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // The consumer has not freed this cell yet
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element; must only be called from the consumer thread.
+     *
+     * @param out Receives the element.
+     * @return False if the buffer is (momentarily) empty.
+     */
+    bool pop(T& out) {
+        Cell& cell = cells[dequeuePosition & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePosition + 1) < 0) {
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release); // Free for the next lap
+        ++dequeuePosition;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells; ///< Storage, capacity is a power of two.
+    size_t mask;                   ///< Capacity - 1.
+    alignas(64) std::atomic<size_t> enqueuePosition{0}; ///< Next position producers claim.
+    alignas(64) size_t dequeuePosition = 0;             ///< Next position the consumer reads.
+};
+
+#endif // RING_BUFFER_H
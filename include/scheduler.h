@@ -0,0 +1,111 @@
+/**
+ * @file scheduler.h
+ * @brief Bounded worker pool that runs experiment jobs with CPU pinning, priorities and progress reporting.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ExperimentJob
+ * @brief One run of one algorithm on one instance.
+ */
+struct ExperimentJob {
+    std::string label;                 ///< Shown in the progress report, e.g. "tabu 34x34 sample 2".
+    int priority = 0;                  ///< Jobs with a higher priority are started first.
+    std::function<std::string()> run;  ///< Runs the job and returns a short summary (e.g. cost and time).
+};
+
+/**
+ * @class ExperimentScheduler
+ * @brief Runs submitted jobs on a fixed number of worker threads.
+ *
+ * Jobs are started in order of decreasing priority and, within a priority, in submission order. Each worker
+ * is pinned to its own logical CPU (Linux only). With Isolation::Physical there is at most one worker per
+ * physical core and sibling hyper-threads stay idle, so that timings are not disturbed by a job sharing the
+ * core; Isolation::Throughput uses every logical CPU, spreading workers over physical cores first.
+ */
+class ExperimentScheduler {
+public:
+    /**
+     * @enum Isolation
+     * @brief How workers are placed on CPUs.
+     */
+    enum class Isolation { Physical, Throughput };
+
+    /**
+     * @brief Creates a scheduler.
+     *
+     * @param workers Requested number of workers (0 = as many as the isolation mode allows).
+     * @param isolation How workers are placed on CPUs.
+     * @param pinThreads Whether workers are pinned to their CPU.
+     */
+    ExperimentScheduler(int workers, Isolation isolation, bool pinThreads);
+
+    /**
+     * @brief Adds a job; must not be called while run() is executing.
+     *
+     * @param job The job.
+     */
+    void submit(ExperimentJob job);
+
+    /**
+     * @brief Runs all submitted jobs and returns when they are finished.
+     *
+     * After a job throws, no further jobs are started and the exception is rethrown once the running jobs end.
+     */
+    void run();
+
+    /**
+     * @brief Number of worker threads run() uses.
+     */
+    int getWorkerCount() const;
+
+    /**
+     * @brief Parses "physical" or "throughput".
+     *
+     * @throws std::runtime_error If the name is unknown.
+     */
+    static Isolation parseIsolation(const std::string& name);
+
+private:
+    std::vector<int> cpus;             ///< Logical CPU of each worker (empty if not pinned).
+    int workerCount;                   ///< Number of workers.
+    std::vector<ExperimentJob> jobs;   ///< Submitted jobs, sorted by run().
+
+    std::atomic<size_t> nextJob{0};    ///< Index of the next job to start.
+    std::atomic<bool> failed{false};   ///< Set when a job threw.
+    std::exception_ptr firstError;     ///< Exception of the first failed job.
+    std::mutex progressMutex;          ///< Guards finishedJobs and firstError.
+    size_t finishedJobs = 0;           ///< Number of finished jobs.
+    std::chrono::steady_clock::time_point startTime; ///< Start of run().
+
+    /**
+     * @brief Worker thread loop.
+     *
+     * @param worker Index of the worker.
+     */
+    void work(int worker);
+
+    /**
+     * @brief Reports a finished job with elapsed time and an estimate of the remaining time.
+     */
+    void reportProgress(const ExperimentJob& job, const std::string& summary);
+
+    /**
+     * @brief Logical CPUs available to the process, one per physical core first, then the siblings.
+     *
+     * @param physicalCores Receives the number of physical cores.
+     */
+    static std::vector<int> detectCpus(int& physicalCores);
+};
+
+#endif // SCHEDULER_H
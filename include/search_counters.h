@@ -0,0 +1,71 @@
+/**
+ * @file search_counters.h
+ * @brief Hot-path event counters of one solver run.
+ */
+
+#ifndef SEARCH_COUNTERS_H
+#define SEARCH_COUNTERS_H
+
+#include <map>
+#include <string>
+
+/**
+ * @struct SearchCounters
+ * @brief Counts of the search events that explain where a run spent its time.
+ *
+ * A solver object runs on one thread at a time, so it owns its counters and increments them as plain
+ * integers: no atomics and no shared cache lines on the hot path. They are published once at the end of a
+ * run through SolveResult::stats, under the member names, and summed over the members of a portfolio.
+ */
+struct SearchCounters {
+    unsigned long long nodesExpanded = 0;      ///< Branch and Bound subproblems whose children were generated.
+    unsigned long long nodesPruned = 0;        ///< Branch and Bound children cut off by the bound.
+    unsigned long long movesEvaluated = 0;     ///< Tabu Search neighbour moves scored.
+    unsigned long long tabuRejected = 0;       ///< Tabu Search moves rejected as tabu without meeting the aspiration criterion.
+    unsigned long long crossovers = 0;         ///< GA crossover operations (two offspring each).
+    unsigned long long mutations = 0;          ///< GA mutation operations.
+    unsigned long long duplicateOffspring = 0; ///< GA offspring identical to a parent (a shuffle whose swaps cancel out is not detected).
+    unsigned long long diversityRetries = 0;   ///< GA parent redraws because the parents were too similar.
+
+    /**
+     * @brief Adds another run's counters.
+     *
+     * @param other The counters to add.
+     * @return This object.
+     */
+    SearchCounters& operator+=(const SearchCounters& other);
+
+    /**
+     * @brief Writes the non-zero counters into a result's statistics.
+     *
+     * @param stats The statistics map, e.g. SolveResult::stats.
+     */
+    void writeTo(std::map<std::string, unsigned long long>& stats) const;
+
+    /**
+     * @brief Reads the counters back from a result's statistics; missing ones are 0.
+     *
+     * @param stats The statistics map.
+     * @return The counters.
+     */
+    static SearchCounters fromStats(const std::map<std::string, unsigned long long>& stats);
+
+    /**
+     * @brief Checks whether a statistic is one of the counters, also when prefixed by a portfolio member ("tabu.movesEvaluated").
+     *
+     * @param stat The statistic's name.
+     * @return True for a counter.
+     */
+    static bool isCounter(const std::string& stat);
+
+    /**
+     * @brief Converts a count into a rate.
+     *
+     * @param count The count.
+     * @param milliseconds The time it was counted over.
+     * @return Events per second (0 if no time passed).
+     */
+    static double perSecond(unsigned long long count, double milliseconds);
+};
+
+#endif // SEARCH_COUNTERS_H
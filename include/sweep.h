@@ -0,0 +1,134 @@
+/**
+ * @file sweep.h
+ * @brief In-process parameter sweeps of a solver: grid, random or Latin hypercube sampling.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "Algorithms/Solver.h"
+#include "lib/nlohmann/json.hpp"
+#include "matrix.h"
+#include "results_writer.h"
+#include "scheduler.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct SweepDimension
+ * @brief One swept parameter.
+ */
+struct SweepDimension {
+    std::string name;                   ///< Parameter name, e.g. "mutationRate" or "tabuSize".
+    std::vector<nlohmann::json> values; ///< Candidate values (a list, or a grid range expanded by its step).
+    bool range = false;                 ///< Sampled from [low, high] instead of values (random and lhs only).
+    double low = 0;                     ///< Lower end of the range.
+    double high = 0;                    ///< Upper end of the range.
+    bool integer = false;               ///< Whether range samples are rounded to integers.
+};
+
+/**
+ * @class ParameterSweep
+ * @brief Expands a sweep specification into points and runs every point on one instance.
+ *
+ * A parameter is given as a list of values, or as a range {"min", "max"} (with "step" for a grid). A grid
+ * runs the cartesian product of all lists; random sampling draws every parameter independently; Latin
+ * hypercube sampling splits each range (or list) into as many strata as there are points and uses every
+ * stratum exactly once per parameter. Ranges whose ends are integers yield integers.
+ *
+ * The instance is prepared once and shared by all runs. Runs go to the experiment scheduler, and each
+ * worker keeps its solver object between points, so solvers that cache their buffers (the GA) allocate
+ * them once per worker. Every run is appended to one result file as a ResultRecord::Kind::Sweep record.
+ */
+class ParameterSweep {
+public:
+    /**
+     * @enum Method
+     * @brief How points are chosen.
+     */
+    enum class Method { Grid, Random, LatinHypercube };
+
+    /**
+     * @brief Parses a specification (the "sweep" section of the configuration) and draws the points.
+     *
+     * @param specification The specification.
+     * @throws std::runtime_error If it is invalid.
+     */
+    explicit ParameterSweep(const nlohmann::json& specification);
+
+    /**
+     * @brief The points, each an object mapping parameter names to values.
+     */
+    const std::vector<nlohmann::json>& getPoints() const;
+
+    /**
+     * @brief Registry name of the swept solver.
+     */
+    const std::string& getSolver() const;
+
+    /**
+     * @brief Runs per point.
+     */
+    int getSamples() const;
+
+    /**
+     * @brief Applies a point to the solver's base parameters.
+     *
+     * GA parameters go into the "geneticAlgorithmConfiguration" object when the base has one; all other
+     * parameters replace top-level keys.
+     *
+     * @param base The base parameters.
+     * @param point The point.
+     * @return The parameters of the point's runs.
+     */
+    nlohmann::json parametersFor(const nlohmann::json& base, const nlohmann::json& point) const;
+
+    /**
+     * @brief Runs every point getSamples() times and queues one record per run.
+     *
+     * @param matrix The prepared instance.
+     * @param base The solver's base parameters; a GA "configPath" is read once and inlined.
+     * @param scheduler The scheduler that runs the points in parallel.
+     * @param resultPath The result file (CSV path; the columnar store lives next to it).
+     * @param timeLimitSeconds Time limit per run (0 for none).
+     */
+    void run(const Matrix& matrix, nlohmann::json base, ExperimentScheduler& scheduler, const std::string& resultPath, double timeLimitSeconds);
+
+    /**
+     * @brief Parses "grid", "random" or "lhs".
+     *
+     * @throws std::runtime_error If the name is unknown.
+     */
+    static Method parseMethod(const std::string& name);
+
+private:
+    std::string solver;                  ///< Registry name of the swept solver.
+    Method method;                       ///< How points are chosen.
+    int samples;                         ///< Runs per point.
+    unsigned int seed;                   ///< Seed of the sampling and, when not 0, of the runs.
+    std::vector<SweepDimension> dimensions; ///< The swept parameters.
+    std::vector<nlohmann::json> points;  ///< The points.
+
+    /**
+     * @brief Fills points with the cartesian product of the dimension values.
+     */
+    void expandGrid();
+
+    /**
+     * @brief Fills points with count random or Latin hypercube samples.
+     */
+    void sample(int count);
+
+    /**
+     * @brief Maps a position in [0, 1) to a value of a dimension.
+     */
+    static nlohmann::json valueAt(const SweepDimension& dimension, double position);
+
+    /**
+     * @brief Builds the result record of a run.
+     */
+    static ResultRecord recordFor(const SolveResult& result, int point, int size, const std::string& resultPath);
+};
+
+#endif // SWEEP_H
@@ -0,0 +1,102 @@
+/**
+ * @file tuner.h
+ * @brief Racing (F-race) tuner that picks solver parameters per instance size class.
+ */
+
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "lib/nlohmann/json.hpp"
+#include "matrix.h"
+#include "scheduler.h"
+#include "sweep.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class RaceTuner
+ * @brief Races candidate configurations of one solver over a training set of instances.
+ *
+ * The candidates are drawn like the points of a parameter sweep (Latin hypercube sampling by default), plus
+ * the configured parameters themselves. The training instances are split into size classes, and every class
+ * is raced separately: in each step all surviving candidates solve the same instance with the same seed
+ * (a "block") in parallel, and once firstTest blocks have been run the Friedman test over the ranks of the
+ * costs decides after every block whether the candidates differ; if they do, the candidates whose rank sum
+ * is significantly worse than the best one (Conover's post-hoc test) are dropped. A class is done when one
+ * candidate is left or its block or run budget is spent, and its best-ranked candidate becomes the profile
+ * of the class.
+ *
+ * The result is the solver's configuration with a "profiles" array, one entry per size class, which the
+ * Genetic Algorithm (as its configuration file) and Tabu Search (tabuSearch.profilePath) apply by instance size.
+ */
+class RaceTuner {
+public:
+    /**
+     * @brief Parses the "tuner" section of the configuration.
+     *
+     * @param specification The section: the sweep keys that define the candidates, and the race settings.
+     * @throws std::runtime_error If it is invalid.
+     */
+    explicit RaceTuner(const nlohmann::json& specification);
+
+    /**
+     * @brief Registry name of the tuned solver.
+     */
+    const std::string& getSolver() const;
+
+    /**
+     * @brief Races every size class of the training set.
+     *
+     * @param instancePaths Matrix files, or directories whose files are all used.
+     * @param base The solver's configured parameters; a GA "configPath" is read once and inlined.
+     * @param scheduler The scheduler that runs the candidates of a block in parallel.
+     * @param timeLimitSeconds Time limit per run (0 for none); the section's own limit takes precedence.
+     * @param candidateListSize Candidate list size the instances are prepared with (0 for none).
+     * @return The tuned configuration: base with one entry per raced size class in "profiles".
+     * @throws std::runtime_error If no instance can be loaded.
+     */
+    nlohmann::json run(const std::vector<std::string>& instancePaths, nlohmann::json base, ExperimentScheduler& scheduler,
+                       double timeLimitSeconds, int candidateListSize);
+
+    /**
+     * @brief Candidates that survive a Friedman test with Conover's post-hoc comparison against the best one.
+     *
+     * @param costs costs[block][candidate]; only the alive candidates are read.
+     * @param alive Indices of the candidates still in the race.
+     * @param alpha Significance level.
+     * @return The surviving indices, in the order of alive (all of alive if the test is not significant).
+     */
+    static std::vector<int> friedmanSurvivors(const std::vector<std::vector<double>>& costs, const std::vector<int>& alive, double alpha);
+
+private:
+    /**
+     * @struct RaceOutcome
+     * @brief Result of the race of one size class.
+     */
+    struct RaceOutcome {
+        int winner = 0;             ///< Index of the best-ranked surviving candidate.
+        int blocks = 0;             ///< Blocks run.
+        int runs = 0;               ///< Solver runs spent.
+        std::vector<int> survivors; ///< Candidates left at the end.
+    };
+
+    std::unique_ptr<ParameterSweep> candidates; ///< Draws the candidate points.
+    bool includeBase;          ///< Whether the configured parameters race as a candidate too.
+    std::vector<int> sizeClasses; ///< Upper size bounds of the classes; larger instances form the last class.
+    int firstTest;             ///< Blocks before the first elimination test.
+    int maxBlocks;             ///< Block budget per class.
+    int maxRuns;               ///< Run budget per class.
+    double alpha;              ///< Significance level of the tests.
+    double runTimeLimit;       ///< Time limit per run (0 = use the one passed to run()).
+    unsigned int seed;         ///< Seed of the blocks; 0 draws random seeds.
+
+    /**
+     * @brief Races the candidates on the instances of one class.
+     */
+    RaceOutcome race(const std::vector<const Matrix*>& instances, const std::vector<std::string>& names,
+                     const std::vector<nlohmann::json>& parameters, ExperimentScheduler& scheduler, double timeLimitSeconds);
+};
+
+#endif // TUNER_H
@@ -14,6 +14,7 @@
 #include "Algorithms/BruteForce.h"
 #include "Algorithms/TabuSearch.h"
 #include "Algorithms/GeneticAlgo.h"
+#include "results_writer.h"
 
 
 #include <chrono>
@@ -63,9 +64,21 @@ public:
      */
     float returnElapsedTimeSeconds();
 
+    /**
+     * @brief Queues a result record for the asynchronous results writer.
+     * 
+     * The record is appended to record.resultPath by the writer thread; call
+     * ResultsWriter::instance().flush() to wait until it is on disk.
+     * 
+     * @param record The record to save.
+     */
+    void saveResultRecord(const ResultRecord& record);
+
     /**
      * @brief Saves the results to a specified file.
      * 
+     * Convenience wrappers that build a ResultRecord of the matching kind.
+     * 
      * @param resultPath The path to the file where results will be saved.
      * @param algoName The name of the algorithm used.
      * @param problemSize The size of the problem.
@@ -75,10 +88,18 @@ public:
     void saveResultsTabuSearch(std::string resultPath, std::string algoName, int problemSize, float time, int bestCost);
     void saveResultsGA(std::string resultPath, std::string algoName, int problemSize, float time, int bestCost, int populationSize, float mutationRate, float crossoverRate, char mutationType, float randomRateNewGen, int iterationNum, float crossingSegmentSizeRate, float mutationSegmentSizeRate,  float randomRate);
 
+    /**
+     * @brief Sets the search counters attached to the records saved by the wrappers above.
+     * 
+     * @param counters The counters of the run being saved.
+     */
+    void setSearchCounters(const SearchCounters& counters);
+
 private:
     std::chrono::time_point<std::chrono::high_resolution_clock> start; ///< Start time of the operation.
     std::chrono::time_point<std::chrono::high_resolution_clock> end; ///< End time of the operation.
     std::chrono::nanoseconds duration; ///< Duration of the operation.
+    SearchCounters searchCounters; ///< Counters of the run being saved.
 };
 
 #endif // UTIL_H
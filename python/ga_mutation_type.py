@@ -17,8 +17,11 @@ correct_answers = {
     71: 1950,
 }
 
-# Wczytywanie wszystkich plików CSV z folderu
+# Wczytywanie wszystkich plików CSV z folderu (lub szybszego magazynu kolumnowego, jeśli istnieje)
 def load_csv_files(folder_path):
+    if any(file.endswith(".atspcol") for file in os.listdir(folder_path)):
+        from result_store import read_store_dir
+        return read_store_dir(folder_path, as_frame=True)
     all_files = [os.path.join(folder_path, file) for file in os.listdir(folder_path) if file.endswith(".csv")]
     data_frames = []
     for file in all_files:
@@ -0,0 +1,143 @@
+"""Reader for the binary columnar result store written by the ATSP solver.
+
+Enable it with "resultsWriter": {"format": "columnar"} (or "both") in config/config.json.
+Every CSV result path then gets a matching ".atspcol" store plus a ".atspcol.idx" block index.
+The store is memory-mapped, so only the blocks and columns that are used are read from disk.
+
+    from result_store import read_store, read_store_dir
+    columns = read_store("../results/resultsTabu_34x34.atspcol")
+    frame = read_store_dir("../results/results_mut_type_bigger", as_frame=True,
+                           where={"problemSize": (30, 50)})
+"""
+import os
+import struct
+
+import numpy as np
+
+FILE_MAGIC = b"ATSPCOL1"
+BLOCK_MAGIC = b"BLK1"
+NAME_LENGTH = 32
+
+# Type code -> numpy dtype (see ColumnarResultStore::ColumnType)
+DTYPES = {
+    1: np.dtype("<i4"),
+    2: np.dtype("<f4"),
+    3: np.dtype("S1"),
+    4: np.dtype("S8"),
+    5: np.dtype("<i8"),
+}
+
+
+def _read_schema(buffer):
+    if bytes(buffer[:8]) != FILE_MAGIC:
+        raise ValueError("not an ATSP columnar result store")
+    (count,) = struct.unpack_from("<I", buffer, 8)
+    schema = []
+    offset = 12
+    for _ in range(count):
+        name = bytes(buffer[offset:offset + NAME_LENGTH]).split(b"\0", 1)[0].decode()
+        schema.append((name, DTYPES[buffer[offset + NAME_LENGTH]]))
+        offset += NAME_LENGTH + 4
+    return schema
+
+
+def _block_offsets(path):
+    """Block offsets from the index file, or by scanning the block headers if it is missing."""
+    index_path = path + ".idx"
+    if os.path.exists(index_path) and os.path.getsize(index_path) > 0:
+        index = np.fromfile(index_path, dtype=np.dtype([("offset", "<u8"), ("rows", "<u4"), ("reserved", "<u4")]))
+        return [int(offset) for offset in index["offset"]]
+    return None
+
+
+def _as_bytes(value):
+    return value.encode("ascii") if isinstance(value, str) else value
+
+
+def _as_stat(value):
+    """A bound as it compares with the block statistics; Char columns store the character code."""
+    value = _as_bytes(value)
+    return value[0] if isinstance(value, bytes) else value
+
+
+def _block_size(rows, schema):
+    size = 8 + len(schema) * 16
+    for _, dtype in schema:
+        size += rows * dtype.itemsize
+        size = (size + 7) & ~7
+    return size
+
+
+def read_store(path, columns=None, where=None):
+    """Reads a store into a dict of numpy arrays.
+
+    columns: optional list of column names to return (default: all).
+    where: optional {column: (low, high)}; blocks whose min/max statistics lie entirely outside
+           the range are skipped without being read, and the remaining rows are filtered.
+           String8 columns (algoName) carry no statistics, so they only filter rows,
+           e.g. where={"algoName": ("GA", "GA")}.
+    """
+    buffer = np.memmap(path, dtype=np.uint8, mode="r")
+    schema = _read_schema(buffer)
+    header_size = (12 + len(schema) * (NAME_LENGTH + 4) + 7) & ~7
+    names = [name for name, _ in schema]
+    wanted = names if columns is None else list(columns)
+    where = where or {}
+    dtypes = dict(schema)
+    # String8 blocks store min = max = 0, which says nothing about the strings
+    pruned = {column: (_as_stat(low), _as_stat(high)) for column, (low, high) in where.items()
+              if dtypes[column] != DTYPES[4]}
+    bounds = {column: ((_as_bytes(low), _as_bytes(high)) if dtypes[column].kind == "S" else (low, high))
+              for column, (low, high) in where.items()}
+
+    offsets = _block_offsets(path)
+    if offsets is None:
+        offsets = []
+        offset = header_size
+        while offset < len(buffer):
+            (rows,) = struct.unpack_from("<I", buffer, offset + 4)
+            offsets.append(offset)
+            offset += _block_size(rows, schema)
+
+    parts = {name: [] for name in wanted}
+    for offset in offsets:
+        if bytes(buffer[offset:offset + 4]) != BLOCK_MAGIC:
+            raise ValueError(f"corrupt block at offset {offset} in {path}")
+        (rows,) = struct.unpack_from("<I", buffer, offset + 4)
+        stats = np.frombuffer(buffer, dtype="<f8", count=2 * len(schema), offset=offset + 8).reshape(-1, 2)
+
+        # Skip blocks that cannot contain matching rows
+        if any(stats[names.index(c)][1] < low or stats[names.index(c)][0] > high for c, (low, high) in pruned.items()):
+            continue
+
+        arrays = {}
+        position = offset + 8 + len(schema) * 16
+        for name, dtype in schema:
+            arrays[name] = np.frombuffer(buffer, dtype=dtype, count=rows, offset=position)
+            position = (position + rows * dtype.itemsize + 7) & ~7
+
+        mask = np.ones(rows, dtype=bool)
+        for column, (low, high) in bounds.items():
+            mask &= (arrays[column] >= low) & (arrays[column] <= high)
+        for name in wanted:
+            parts[name].append(arrays[name][mask])
+
+    return {name: (np.concatenate(parts[name]) if parts[name] else np.empty(0, dtype=dtypes[name]))
+            for name in wanted}
+
+
+def read_store_dir(folder, columns=None, where=None, as_frame=False):
+    """Reads and concatenates every store in a folder; optionally returns a pandas DataFrame."""
+    stores = sorted(os.path.join(folder, f) for f in os.listdir(folder) if f.endswith(".atspcol"))
+    results = [read_store(path, columns, where) for path in stores]
+    if not results:
+        return None
+    merged = {name: np.concatenate([result[name] for result in results]) for name in results[0]}
+    if as_frame:
+        import pandas as pd
+        frame = pd.DataFrame(merged)
+        for name in frame.columns:
+            if frame[name].dtype == object:
+                frame[name] = frame[name].str.decode("ascii")
+        return frame
+    return merged
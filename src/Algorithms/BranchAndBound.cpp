@@ -1,4 +1,22 @@
 #include "../../include/Algorithms/BranchAndBound.h"
+#include "../../include/Algorithms/NearestNeighbour.h"
+#include "../../include/Algorithms/TabuSearch.h"
+#include "../../include/Algorithms/Solver.h"
+#include "../../include/logger.h"
+
+namespace {
+
+// Whether a tour (without the return to the start) uses a missing edge, e.g. a tour offered by a heuristic
+bool usesForbiddenEdge(const Matrix& matrix, const std::vector<int>& tour) {
+    for (size_t k = 0; k < tour.size(); ++k) {
+        if (matrix.isForbidden(tour[k], tour[(k + 1) % tour.size()])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
 
 BranchAndBound::Subproblem::Subproblem(int numCities) : cost(0), lowerBound(0) {
     visited.reserve(numCities);
@@ -9,48 +27,141 @@ BranchAndBound::Subproblem::Subproblem(int numCities) : cost(0), lowerBound(0) {
 }
 
 BranchAndBound::BranchAndBound(const Matrix& matrix) 
-    : matrix(matrix), bestCost(std::numeric_limits<int>::max()) {}
+    : matrix(matrix), bestCost(std::numeric_limits<int>::max()), checkpointer(nullptr), nodeCount(0),
+      deadline(std::chrono::steady_clock::time_point::max()), stopped(false), rootBound(0), incumbent(nullptr), resuming(false) {}
 
 int BranchAndBound::calculateLowerBound(const Subproblem& subproblem) const {
-    int bound = subproblem.cost;
-    int n = matrix.getSize();
+    long long bound = subproblem.cost; // 64-bit so that forbidden-edge sentinels cannot overflow
 
     // For each unvisited city, calculate the minimum cost to enter and exit
     for (int city : subproblem.unvisited) {
-        int minOut = std::numeric_limits<int>::max();
-        int minIn = std::numeric_limits<int>::max();
+        int minOut = minOutgoingCost(city);
+        int minIn = matrix.isSymmetric() ? minOut : minIncomingCost(city);
+        bound += (minOut + minIn);
+    }
+
+    // Divide bound by 2 to avoid overestimation
+    return Matrix::saturateCost(bound / 2);
+}
+
+int BranchAndBound::minOutgoingCost(int city) const {
+    int n = matrix.getSize();
+    int minOut = std::numeric_limits<int>::max();
+
+    // On sparse instances only the allowed edges from the CSR index can be cheapest
+    const int* successors = matrix.getAllowedSuccessors(city);
+    if (successors != nullptr) {
+        int count = matrix.getAllowedSuccessorCount(city);
+        for (int s = 0; s < count; ++s) {
+            minOut = std::min(minOut, matrix.getCost(city, successors[s]));
+        }
+        return count > 0 ? minOut : Matrix::FORBIDDEN_COST;
+    }
 
+    // Outgoing costs are a contiguous row unless the matrix is stored packed
+    const int* row = matrix.getRow(city);
+    if (row != nullptr) {
         for (int j = 0; j < n; ++j) {
-            if (j != city) {
-                int costOut = matrix.getCost(city, j);
-                int costIn = matrix.getCost(j, city);
-                if (costOut < minOut) minOut = costOut;
-                if (costIn < minIn) minIn = costIn;
-            }
+            if (j != city && row[j] < minOut) minOut = row[j];
+        }
+    } else {
+        for (int j = 0; j < n; ++j) {
+            if (j != city) minOut = std::min(minOut, matrix.getCost(city, j));
         }
-        bound += (minOut + minIn);
     }
+    return minOut;
+}
 
-    // Divide bound by 2 to avoid overestimation
-    return bound / 2;
+int BranchAndBound::minIncomingCost(int city) const {
+    int n = matrix.getSize();
+    int minIn = std::numeric_limits<int>::max();
+
+    // Incoming costs are a column; use the transposed copy when available to avoid strided reads
+    const int* column = matrix.getColumn(city);
+    if (column != nullptr) {
+        for (int j = 0; j < n; ++j) {
+            if (j != city && column[j] < minIn) minIn = column[j];
+        }
+    } else {
+        for (int j = 0; j < n; ++j) {
+            if (j != city) minIn = std::min(minIn, matrix.getCost(j, city));
+        }
+    }
+    return minIn;
+}
+
+bool BranchAndBound::isMirroredDuplicate(const Subproblem& subproblem) const {
+    if (!matrix.isSymmetric() || subproblem.visited.size() < 2) {
+        return false;
+    }
+    int second = subproblem.visited[1];
+
+    // Complete tour: keep it only if it ends with a larger city than it started with
+    if (subproblem.unvisited.empty()) {
+        return subproblem.visited.back() < second;
+    }
+
+    // Partial tour: some unvisited city must still be able to end the tour
+    for (int city : subproblem.unvisited) {
+        if (city > second) return false;
+    }
+    return true;
 }
 
 void BranchAndBound::processSubproblem(Subproblem& subproblem) {
+    // Reading the clock on every node would be measurable, so only every 4096th node checks the deadline and interval
+    if ((++nodeCount & 4095) == 0) {
+        if (std::chrono::steady_clock::now() >= deadline || (incumbent != nullptr && incumbent->shouldStop())) {
+            stopped = true;
+            if (checkpointer != nullptr) {
+                saveCheckpoint(); // Lets a later run continue from here
+            }
+        } else if (checkpointer != nullptr && checkpointer->due(lastCheckpoint)) {
+            saveCheckpoint();
+        }
+    }
+    if (stopped) {
+        return;
+    }
+
     // If all cities are visited, close the tour and update best cost if necessary
     if (subproblem.visited.size() == matrix.getSize()) {
+        if (matrix.isForbidden(subproblem.visited.back(), 0)) {
+            return;  // No edge back to the start city
+        }
         int tourCost = subproblem.cost + matrix.getCost(subproblem.visited.back(), 0);
         if (tourCost < bestCost) {
             bestCost = tourCost;
             bestPath = subproblem.visited;
             bestPath.push_back(0);  // Return to the start city
+            if (incumbent != nullptr) {
+                incumbent->offer(tourCost, subproblem.visited, "bnb");
+            }
         }
         return;
     }
 
+    // When resuming, skip the branches that were finished before the checkpoint
+    size_t depth = subproblem.visited.size() - 1;
+    size_t first = 0;
+    if (resuming) {
+        if (depth < resumeStack.size()) {
+            first = resumeStack[depth];
+        } else {
+            resuming = false;  // Reached the subproblem the checkpoint was taken in
+        }
+    }
+
+    ++counters.nodesExpanded;
+
     // Loop through each unvisited city and create a new subproblem for it
-    for (size_t i = 0; i < subproblem.unvisited.size(); ++i) {
+    for (size_t i = first; i < subproblem.unvisited.size(); ++i) {
+        resuming = resuming && i == first;  // Later siblings were not started before the checkpoint
         int city = subproblem.unvisited[i];
-        
+        if (matrix.isForbidden(subproblem.visited.back(), city)) {
+            continue;  // Infeasible branch
+        }
+
         Subproblem newSubproblem = subproblem;  // Duplicate current subproblem
         newSubproblem.visited.push_back(city);
         newSubproblem.cost += matrix.getCost(subproblem.visited.back(), city);
@@ -58,20 +169,188 @@ void BranchAndBound::processSubproblem(Subproblem& subproblem) {
         // Remove the city from unvisited list in the new subproblem
         newSubproblem.unvisited.erase(newSubproblem.unvisited.begin() + i);
 
+        // On symmetric instances skip the reversed copy of tours that are explored anyway
+        if (isMirroredDuplicate(newSubproblem)) {
+            continue;
+        }
+
         // Calculate the lower bound for this new subproblem
         newSubproblem.lowerBound = calculateLowerBound(newSubproblem);
 
         // Proceed with the new subproblem if its bound is better than the current best cost
-        if (newSubproblem.lowerBound < bestCost) {
+        if (newSubproblem.lowerBound < pruningBound()) {
+            branchStack.push_back(static_cast<int>(i));
             processSubproblem(newSubproblem);
+            if (stopped) {
+                return; // Keep branchStack pointing at the unfinished subproblem
+            }
+            branchStack.pop_back();
+        } else {
+            ++counters.nodesPruned;
         }
     }
 }
 
 void BranchAndBound::runBranchAndBound() {
+    nodeCount = 0;
+    counters = SearchCounters();
+    stopped = false;
+    branchStack.clear();
+    if (checkpointer != nullptr) {
+        checkpointPath = checkpointer->pathFor("bnb", matrix, checkpointRun);
+        resuming = loadCheckpoint();
+        if (resuming) {
+            LOG_INFO("Resuming branch and bound with incumbent " << bestCost << " at depth " << resumeStack.size());
+        }
+        lastCheckpoint = std::chrono::steady_clock::now();
+    }
+
+    if (incumbent != nullptr && !bestPath.empty()) {
+        incumbent->offer(bestCost, std::vector<int>(bestPath.begin(), bestPath.end() - 1), "bnb"); // Warm start
+    }
+
     Subproblem initial(matrix.getSize());
     initial.lowerBound = calculateLowerBound(initial);
+    rootBound = initial.lowerBound;
     processSubproblem(initial);
+
+    resuming = false;
+    if (checkpointer != nullptr && !stopped) {
+        checkpointer->remove(checkpointPath); // The run is complete
+    }
+    Logger::instance().flush(); // The caller prints the result directly
+}
+
+void BranchAndBound::setCheckpointer(Checkpointer* checkpointer, const std::string& run) {
+    this->checkpointer = checkpointer;
+    this->checkpointRun = run;
+}
+
+void BranchAndBound::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+}
+
+void BranchAndBound::setInitialTour(const std::vector<int>& tour) {
+    int n = matrix.getSize();
+    if (static_cast<int>(tour.size()) != n) {
+        throw std::invalid_argument("Initial tour has the wrong length");
+    }
+    std::vector<bool> seen(n, false);
+    int startIndex = 0;
+    for (int k = 0; k < n; ++k) {
+        if (tour[k] < 0 || tour[k] >= n || seen[tour[k]]) {
+            throw std::invalid_argument("Initial tour is not a permutation of the cities");
+        }
+        seen[tour[k]] = true;
+        if (tour[k] == 0) startIndex = k;
+    }
+
+    // The search enumerates tours from city 0, so store the incumbent in the same rotation
+    std::vector<int> path(n + 1);
+    long long cost = 0; // 64-bit so that forbidden-edge sentinels cannot overflow
+    for (int k = 0; k < n; ++k) {
+        path[k] = tour[(startIndex + k) % n];
+        if (k > 0) cost += matrix.getCost(path[k - 1], path[k]);
+    }
+    path[n] = 0;
+    cost += matrix.getCost(path[n - 1], 0);
+
+    // A heuristic tour through a missing edge is no incumbent: it would be reported as the optimum if no feasible tour exists
+    if (cost < Matrix::FORBIDDEN_COST && cost < bestCost) {
+        bestCost = static_cast<int>(cost);
+        bestPath = path;
+    }
+}
+
+int BranchAndBound::warmStart(int iterations, int tabuSize, unsigned int seed) {
+    NearestNeighbour nn(matrix);
+    nn.run(0);
+    setInitialTour(nn.getBestPath());
+    if (iterations > 0) {
+        TabuSearch tabu(matrix, tabuSize, iterations, seed);
+        tabu.setInitialPath(nn.getBestPath());
+        tabu.setDeadline(deadline);
+        tabu.runTabuSearch();
+        setInitialTour(std::vector<int>(tabu.getBestPath(), tabu.getBestPath() + matrix.getSize()));
+    }
+    return bestCost;
+}
+
+void BranchAndBound::setIncumbent(SharedIncumbent* incumbent) {
+    this->incumbent = incumbent;
+}
+
+bool BranchAndBound::isComplete() const {
+    return !stopped;
+}
+
+int BranchAndBound::getLowerBound() const {
+    // Everything that could beat the pruning bound was explored, so a complete run proves it optimal
+    return stopped ? std::min(rootBound, pruningBound()) : pruningBound();
+}
+
+unsigned long long BranchAndBound::getNodeCount() const {
+    return nodeCount;
+}
+
+const SearchCounters& BranchAndBound::getSearchCounters() const {
+    return counters;
+}
+
+std::string BranchAndBound::checkpointParameters() const {
+    // The warm start settings only seed the incumbent, and a resumed run keeps the better one, so they are not part of it
+    return "mirroredPruning=" + std::to_string(matrix.isSymmetric());
+}
+
+void BranchAndBound::saveCheckpoint() {
+    CheckpointBuffer buffer;
+    buffer.putString("bnb");
+    buffer.putString(matrix.getFingerprint());
+    buffer.putParameters(checkpointParameters());
+    buffer.putInt(bestCost);
+    buffer.putInt(static_cast<int>(bestPath.size()));
+    buffer.putInts(bestPath.data(), static_cast<int>(bestPath.size()));
+    buffer.putInt(static_cast<int>(branchStack.size()));
+    buffer.putInts(branchStack.data(), static_cast<int>(branchStack.size()));
+    checkpointer->save(checkpointPath, buffer);
+}
+
+bool BranchAndBound::loadCheckpoint() {
+    CheckpointBuffer buffer;
+    if (!checkpointer->load(checkpointPath, buffer)) {
+        return false;
+    }
+    try {
+        if (buffer.getString() != "bnb" || buffer.getString() != matrix.getFingerprint() ||
+            !buffer.matchesParameters(checkpointParameters())) {
+            LOG_WARNING("checkpoint " << checkpointPath << " was written with a different configuration, starting over");
+            return false;
+        }
+        int cost = buffer.getInt();
+        int pathLength = buffer.getInt();
+        if (pathLength < 0 || pathLength > matrix.getSize() + 1) {
+            throw std::runtime_error("invalid incumbent length");
+        }
+        std::vector<int> path(pathLength);
+        buffer.getInts(path.data(), pathLength);
+        int depth = buffer.getInt();
+        if (depth < 0 || depth >= matrix.getSize()) {
+            throw std::runtime_error("invalid search depth");
+        }
+        std::vector<int> stack(depth);
+        buffer.getInts(stack.data(), depth);
+
+        // Only commit once everything was read; a warm start may already be better than the saved incumbent
+        if (cost < Matrix::FORBIDDEN_COST && cost < bestCost) {
+            bestCost = cost;
+            bestPath = path;
+        }
+        resumeStack = stack;
+        return true;
+    } catch (const std::runtime_error& e) {
+        LOG_WARNING("ignoring checkpoint " << checkpointPath << ": " << e.what());
+        return false;
+    }
 }
 
 void BranchAndBound::printSolution() const {
@@ -82,3 +361,83 @@ void BranchAndBound::printSolution() const {
     }
     std::cout << std::endl;
 }
+
+int BranchAndBound::getBestCost() const {
+    return bestCost;
+}
+
+const std::vector<int>& BranchAndBound::getBestPath() const {
+    return bestPath;
+}
+
+
+/**
+ * @class BranchAndBoundSolver
+ * @brief ISolver adapter of BranchAndBound, registered as "bnb".
+ *
+ * Parameters: "initialTour" (optional initial incumbent), "warmStart" (default true: improve the incumbent
+ * with a nearest neighbour tour and a short Tabu Search first), "warmStartIterations" (default 1000) and
+ * "warmStartTabuSize" (default 10). None of them changes the optimum, only how early pruning starts.
+ */
+class BranchAndBoundSolver : public ISolver {
+public:
+    std::string name() const override { return "bnb"; }
+    std::string description() const override { return "Branch and Bound"; }
+    bool isExact() const override { return true; }
+
+    SolveResult solve(const SolveRequest& request) override {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const Matrix& matrix = requireMatrix(request);
+        bool warmStart = request.parameters.value("warmStart", true);
+        int warmStartIterations = request.parameters.value("warmStartIterations", 1000);
+        int warmStartTabuSize = request.parameters.value("warmStartTabuSize", 10);
+        if (warmStartIterations < 0 || warmStartTabuSize < 1) {
+            throw std::invalid_argument("Branch and Bound needs warmStartIterations >= 0 and warmStartTabuSize >= 1");
+        }
+        BranchAndBound bnb(matrix);
+        bnb.setCheckpointer(request.checkpointer, request.run);
+        bnb.setDeadline(request.deadline);
+        bnb.setIncumbent(request.incumbent);
+        if (request.parameters.contains("initialTour")) {
+            bnb.setInitialTour(request.parameters.at("initialTour").get<std::vector<int>>());
+        }
+
+        SolveResult result;
+        result.solver = name();
+        result.parameters = {{"warmStart", warmStart}, {"warmStartIterations", warmStartIterations},
+                             {"warmStartTabuSize", warmStartTabuSize}};
+        result.timings.setupMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        if (warmStart) {
+            int warmStartCost = bnb.warmStart(warmStartIterations, warmStartTabuSize, seedFor(request));
+            if (warmStartCost != INT_MAX) {
+                result.stats["warmStartCost"] = static_cast<unsigned long long>(warmStartCost);
+            }
+        }
+        bnb.runBranchAndBound();
+        result.timings.solveMs = millisecondsSince(start);
+
+        result.cost = bnb.getBestCost();
+        if (result.cost != INT_MAX) {
+            result.tour.assign(bnb.getBestPath().begin(), bnb.getBestPath().end() - 1); // Drop the return to the start
+        }
+        if (request.incumbent != nullptr && request.incumbent->getCost() < result.cost) {
+            // Pruned against a cheaper tour of another solver; a complete run proves that one optimal unless it is infeasible
+            std::vector<int> tour;
+            std::string origin;
+            int cost = request.incumbent->get(tour, origin);
+            if (!usesForbiddenEdge(matrix, tour)) {
+                result.cost = cost;
+                result.tour = std::move(tour);
+            }
+        }
+        result.timedOut = !bnb.isComplete();
+        result.optimal = bnb.isComplete() && result.cost != INT_MAX && !usesForbiddenEdge(matrix, result.tour);
+        result.bound = bnb.getLowerBound();
+        result.stats["nodes"] = bnb.getNodeCount();
+        bnb.getSearchCounters().writeTo(result.stats);
+        return result;
+    }
+};
+
+REGISTER_SOLVER(BranchAndBoundSolver, "bnb");
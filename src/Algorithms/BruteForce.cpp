@@ -1,10 +1,12 @@
 #include "../../include/Algorithms/BruteForce.h"
+#include "../../include/Algorithms/Solver.h"
 #include <iostream>
 #include <climits> // For INT_MAX
 #include <cstring> // For std::memcpy
 
 BruteForce::BruteForce(const Matrix& matrix)
-    : matrix(matrix), n(matrix.getSize()), bestCost(INT_MAX) {
+    : matrix(matrix), n(matrix.getSize()), bestCost(INT_MAX), tourCount(0),
+      deadline(std::chrono::steady_clock::time_point::max()), stopped(false), incumbent(nullptr) {
     // Allocate memory for bestPath and currentPath
     bestPath = new int[n];
     currentPath = new int[n];
@@ -28,18 +30,27 @@ void BruteForce::swap(int& a, int& b) {
 }
 
 int BruteForce::calculatePathCost(const Node& node) const {
-    int cost = 0;
+    long long cost = 0; // 64-bit so that forbidden-edge sentinels cannot overflow
     for (int i = 0; i < n - 1; ++i) {
         cost += matrix.getCost(node.path[i], node.path[i + 1]);
     }
     cost += matrix.getCost(node.path[n - 1], node.path[0]); // Return to the starting city
-    return cost;
+    return Matrix::saturateCost(cost);
 }
 
 void BruteForce::generatePermutations(int depth) {
+    if (stopped) {
+        return;
+    }
     if (depth == n) {
+        // Only every 65536th tour reads the clock
+        if ((++tourCount & 65535) == 0 &&
+            (std::chrono::steady_clock::now() >= deadline || (incumbent != nullptr && incumbent->shouldStop()))) {
+            stopped = true;
+        }
+
         // Calculate the cost of the current permutation
-        int currentCost = 0;
+        long long currentCost = 0;
         for (int i = 0; i < n - 1; ++i) {
             currentCost += matrix.getCost(currentPath[i], currentPath[i + 1]);
         }
@@ -47,12 +58,20 @@ void BruteForce::generatePermutations(int depth) {
 
         // Update the best cost and path if needed
         if (currentCost < bestCost) {
-            bestCost = currentCost;
+            bestCost = Matrix::saturateCost(currentCost);
             std::memcpy(bestPath, currentPath, n * sizeof(int));
+            if (incumbent != nullptr) {
+                incumbent->offer(bestCost, std::vector<int>(currentPath, currentPath + n), "bf");
+            }
         }
     } else {
         for (int i = depth; i < n; ++i) {
             swap(currentPath[depth], currentPath[i]);
+            // Skip every permutation whose prefix already uses a forbidden edge
+            if (depth > 0 && matrix.hasForbiddenEdges() && matrix.isForbidden(currentPath[depth - 1], currentPath[depth])) {
+                swap(currentPath[depth], currentPath[i]);
+                continue;
+            }
             generatePermutations(depth + 1);
             swap(currentPath[depth], currentPath[i]); // Backtrack
         }
@@ -61,9 +80,27 @@ void BruteForce::generatePermutations(int depth) {
 
 void BruteForce::runBruteForce() {
     // Generate all permutations of the cities and find the best path
+    tourCount = 0;
+    stopped = false;
     generatePermutations(0);
 }
 
+void BruteForce::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+}
+
+void BruteForce::setIncumbent(SharedIncumbent* incumbent) {
+    this->incumbent = incumbent;
+}
+
+bool BruteForce::isComplete() const {
+    return !stopped;
+}
+
+unsigned long long BruteForce::getTourCount() const {
+    return tourCount;
+}
+
 void BruteForce::printSolution() const {
     std::cout << "\nMinimum cost (Brute Force): " << bestCost << std::endl;
     std::cout << "Best path (Brute Force): ";
@@ -72,4 +109,51 @@ void BruteForce::printSolution() const {
     }
     std::cout << bestPath[0];  // Return to the start city
     std::cout << std::endl;
-}
\ No newline at end of file
+}
+
+int BruteForce::getBestCost() const {
+    return bestCost;
+}
+
+std::vector<int> BruteForce::getBestPath() const {
+    return std::vector<int>(bestPath, bestPath + n);
+}
+
+
+/**
+ * @class BruteForceSolver
+ * @brief ISolver adapter of BruteForce, registered as "bf". Takes no parameters.
+ */
+class BruteForceSolver : public ISolver {
+public:
+    std::string name() const override { return "bf"; }
+    std::string description() const override { return "Brute Force"; }
+    bool isExact() const override { return true; }
+
+    SolveResult solve(const SolveRequest& request) override {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        BruteForce bf(requireMatrix(request));
+        bf.setDeadline(request.deadline);
+        bf.setIncumbent(request.incumbent);
+
+        SolveResult result;
+        result.solver = name();
+        result.parameters = nlohmann::json::object();
+        result.timings.setupMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        bf.runBruteForce();
+        result.timings.solveMs = millisecondsSince(start);
+
+        result.cost = bf.getBestCost();
+        if (result.cost != INT_MAX) {
+            result.tour = bf.getBestPath();
+        }
+        result.timedOut = !bf.isComplete();
+        result.optimal = bf.isComplete() && result.cost != INT_MAX;
+        result.bound = result.optimal ? result.cost : 0;
+        result.stats["tours"] = bf.getTourCount();
+        return result;
+    }
+};
+
+REGISTER_SOLVER(BruteForceSolver, "bf");
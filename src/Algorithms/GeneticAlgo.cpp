@@ -1,15 +1,40 @@
 #include "../../include/Algorithms/GeneticAlgo.h"
+#include "../../include/Algorithms/Solver.h"
+#include "../../include/logger.h"
+#include "../../include/phase_timer.h"
+#include <climits> // For INT_MAX
+#include <algorithm> // For std::copy, std::sort
+#include <utility>
+#include <vector>
 
 // Constructor
-GeneticAlgorithm::GeneticAlgorithm(const Matrix& matrix, std::string geneticConfigFilePath)
+GeneticAlgorithm::GeneticAlgorithm(const Matrix& matrix, std::string geneticConfigFilePath, unsigned int seed)
+    : GeneticAlgorithm(matrix, readConfigFile(geneticConfigFilePath), seed) {
+    this->geneticConfigFilePath = std::move(geneticConfigFilePath);
+}
+
+nlohmann::json GeneticAlgorithm::readConfigFile(const std::string& path) {
+    std::ifstream config_file(path);
+    if (!config_file.is_open()) {
+        throw std::runtime_error("Could not open config file: " + path);
+    }
+
+    // Parse the config file as JSON
+    nlohmann::json config_json;
+    config_file >> config_json;
+    return config_json;
+}
+
+GeneticAlgorithm::GeneticAlgorithm(const Matrix& matrix, const nlohmann::json& config, unsigned int seed)
     : matrix(matrix),                     // Initialize the reference
       problemSize(matrix.getSize()),     // Assuming Matrix has a getSize() method
       population(nullptr),               // Initialize pointers to nullptr
       offspring(nullptr),
       offspringPopulation(nullptr),
+      scratchChromosome(nullptr),
+      capacity(0),
       bestPath(nullptr),
       bestSolution(std::numeric_limits<int>::max()), // Set a large default value for bestSolution
-      geneticConfigFilePath(std::move(geneticConfigFilePath)), // Use std::move for efficiency
       populationSize(0),                 // Initialize with a sensible default
       iterationNum(0),
       crossingSegmentSizeRate(0),
@@ -17,56 +42,109 @@ GeneticAlgorithm::GeneticAlgorithm(const Matrix& matrix, std::string geneticConf
       mutationType('i'),                 // Default to 'i' for inversion
       mutationRate(0),
       randomRate(0),
-      randomRateNewGen(0) {
-    // Construct the full path to the config file
-    std::string fullPath = this->geneticConfigFilePath;
-
-    //Debugging
-    // std::cout << "Full path to config file: " << fullPath << std::endl;
+      randomRateNewGen(0),
+      rng(seed),
+      checkpointer(nullptr),
+      deadline(std::chrono::steady_clock::time_point::max()),
+      stopped(false),
+      incumbent(nullptr),
+      completedGenerations(0) {
+    parseParametersFromJSON(config);
 
-    // Read the config file
-    std::ifstream config_file(fullPath);
-    if (!config_file.is_open()) {
-        throw std::runtime_error("Could not open config file: " + fullPath);
+    // Initial population generation
+    allocateBuffers(populationSize);
+    for (int i = 0; i < populationSize; ++i) {
+        fillRandomChromosome(population[i], problemSize - 1); // Exclude the 0th city for ATSP
     }
+}
 
-    // Parse the config file as JSON
-    nlohmann::json config_json;
-    config_file >> config_json;
-    parseParametersFromJSON(config_json);
-
-    // Initial population generation
-    population = new int*[populationSize];
-    offspringPopulation = new int*[populationSize];
-    int chromosomeLength = matrix.getSize() - 1; // Exclude the 0th city for ATSP
+void GeneticAlgorithm::reconfigure(const nlohmann::json& config, unsigned int seed) {
+    parseParametersFromJSON(config);
+    if (populationSize > capacity) {
+        freeBuffers();
+        allocateBuffers(populationSize);
+    }
+    rng.seed(seed);
+    bestSolution = std::numeric_limits<int>::max();
+    stopped = false;
+    completedGenerations = 0;
+    for (int i = 0; i < populationSize; ++i) {
+        fillRandomChromosome(population[i], problemSize - 1);
+    }
+}
 
+void GeneticAlgorithm::allocateBuffers(int slots) {
+    int chromosomeLength = problemSize - 1;
+    if (chromosomeLength <= 0) {
+        throw std::invalid_argument("Chromosome length must be positive.");
+    }
+    capacity = slots;
+    population = new int*[slots]();
+    offspringPopulation = new int*[slots + 1](); // Spare slot for the second child of the last crossover
     try {
-        for (int i = 0; i < populationSize; ++i) {
-            population[i] = generateChromosome(chromosomeLength);
+        for (int i = 0; i < slots; ++i) {
+            population[i] = new int[chromosomeLength];
+        }
+        for (int i = 0; i <= slots; ++i) {
             offspringPopulation[i] = new int[chromosomeLength];
         }
+        scratchChromosome = new int[chromosomeLength];
     } catch (...) {
-        // Clean up allocated memory in case of an exception
-        for (int i = 0; i < populationSize; ++i) {
-            delete[] population[i];
-            delete[] offspringPopulation[i];
-        }
-        delete[] population;
-        delete[] offspringPopulation;
-        throw; // Re-throw the exception
+        freeBuffers(); // Clean up allocated memory in case of an exception
+        throw;
     }
 }
 
-
-// Destructor
-GeneticAlgorithm::~GeneticAlgorithm() {
-    // std::cout << "Destroying GeneticAlgorithm object" << std::endl;
-    for (int i = 0; i < populationSize; ++i) {
+void GeneticAlgorithm::freeBuffers() {
+    // Selection only exchanges buffers between the first populationSize slots, so every slot still owns one
+    for (int i = 0; population != nullptr && i < capacity; ++i) {
         delete[] population[i];
+    }
+    for (int i = 0; offspringPopulation != nullptr && i <= capacity; ++i) {
         delete[] offspringPopulation[i];
     }
     delete[] population;
     delete[] offspringPopulation;
+    delete[] scratchChromosome;
+    population = nullptr;
+    offspringPopulation = nullptr;
+    scratchChromosome = nullptr;
+    capacity = 0;
+}
+
+
+// Destructor
+GeneticAlgorithm::~GeneticAlgorithm() {
+    freeBuffers();
+}
+
+void GeneticAlgorithm::setCheckpointer(Checkpointer* checkpointer, const std::string& run) {
+    this->checkpointer = checkpointer;
+    this->checkpointRun = run;
+}
+
+void GeneticAlgorithm::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+}
+
+void GeneticAlgorithm::setIncumbent(SharedIncumbent* incumbent) {
+    this->incumbent = incumbent;
+}
+
+bool GeneticAlgorithm::isStopped() const {
+    return stopped;
+}
+
+int GeneticAlgorithm::getGenerationCount() const {
+    return completedGenerations;
+}
+
+const SearchCounters& GeneticAlgorithm::getSearchCounters() const {
+    return counters;
+}
+
+int GeneticAlgorithm::randomInt(int bound) {
+    return static_cast<int>(rng() % static_cast<unsigned>(bound));
 }
 
 // // Generate initial population
@@ -83,23 +161,9 @@ int* GeneticAlgorithm::generateChromosome(int chromosomeLength) {
         throw std::invalid_argument("Chromosome length must be positive.");
     }
 
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned>(time(nullptr)));
-        seeded = true;
-    }
-
     // Create a 1D array to store city IDs
     int* chromosome = new int[chromosomeLength];
-    for (int i = 0; i < chromosomeLength; ++i) {
-        chromosome[i] = i + 1; // Cities start from 1
-    }
-
-    // Shuffle the chromosome
-    for (int i = chromosomeLength - 1; i > 0; --i) {
-        int j = rand() % (i + 1);
-        std::swap(chromosome[i], chromosome[j]);
-    }
+    fillRandomChromosome(chromosome, chromosomeLength);
 
     // debugging
     // for (int i = 0; i < chromosomeLength; ++i) {
@@ -111,72 +175,75 @@ int* GeneticAlgorithm::generateChromosome(int chromosomeLength) {
     return chromosome;
 }
 
+void GeneticAlgorithm::fillRandomChromosome(int* chromosome, int chromosomeLength) {
+    for (int i = 0; i < chromosomeLength; ++i) {
+        chromosome[i] = i + 1; // Cities start from 1
+    }
+
+    // Shuffle the chromosome
+    for (int i = chromosomeLength - 1; i > 0; --i) {
+        int j = randomInt(i + 1);
+        std::swap(chromosome[i], chromosome[j]);
+    }
+}
+
 
 int diversityThreshold = 0; // At least 30% difference
 
 // Generate offspring with mutation and crossing
 void GeneticAlgorithm::generateOffspring(int chromosomeLength) {
+    PHASE_TIMER(Phase::GaGenerateOffspring);
     int offspringIndex = 0;
 
+    // Offspring are written into the preallocated buffers of offspringPopulation
+
     // Generate random chromosomes
     for (; offspringIndex < populationSize * (randomRate / 100.0); ++offspringIndex) {
-        offspringPopulation[offspringIndex] = generateChromosome(chromosomeLength);
+        fillRandomChromosome(offspringPopulation[offspringIndex], chromosomeLength);
     }
 
     // Perform mutation
     for (; offspringIndex < populationSize * ((randomRate + mutationRate) / 100.0); ++offspringIndex) {
-        int parentIndex = rand() % populationSize;
-        offspringPopulation[offspringIndex] = new int[chromosomeLength];
+        int parentIndex = randomInt(populationSize);
 
         // Copy parent chromosome
-        for (int i = 0; i < chromosomeLength; ++i) {
-            offspringPopulation[offspringIndex][i] = population[parentIndex][i];
-        }
+        std::copy(population[parentIndex], population[parentIndex] + chromosomeLength, offspringPopulation[offspringIndex]);
 
         // Apply mutation
-        if (mutationType == 'i') {
-            performInversionMutation(offspringIndex, chromosomeLength, mutationSegmentSizeRate);
-        } else if (mutationType == 's') {
-            performShuffleMutation(offspringIndex, chromosomeLength, mutationSegmentSizeRate);
+        bool changed = true;
+        {
+            PHASE_TIMER(Phase::GaMutation);
+            if (mutationType == 'i') {
+                changed = performInversionMutation(offspringPopulation[offspringIndex], chromosomeLength, mutationSegmentSizeRate);
+            } else if (mutationType == 's') {
+                changed = performShuffleMutation(offspringPopulation[offspringIndex], chromosomeLength, mutationSegmentSizeRate);
+            }
         }
+        ++counters.mutations;
+        counters.duplicateOffspring += !changed;
     }
 
     // Perform crossover with diversification mechanism
     for (; offspringIndex < populationSize; offspringIndex += 2) {
-        int parent1 = rand() % populationSize;
+        int parent1 = randomInt(populationSize);
         int parent2;
         int retries = 0;
         const int maxRetries = 10;
 
         // Ensure parent2 is diverse from parent1
         do {
-            parent2 = rand() % populationSize;
+            parent2 = randomInt(populationSize);
             retries++;
         } while (calculateDiversity(population[parent1], population[parent2], chromosomeLength) < diversityThreshold && retries < maxRetries);
+        counters.diversityRetries += retries - 1; // The first draw is not a retry
 
-        // Diversification mechanism if retries exceed limit
-        if (retries >= maxRetries) {
-            if (rand() % 2 == 0) {
-                // Randomly generate a new chromosome as parent2
-                parent2 = offspringIndex; // Use a new random chromosome
-                offspringPopulation[parent2] = generateChromosome(chromosomeLength);
-            } else {
-                // Apply mutation to an existing chromosome to create diversity
-                parent2 = rand() % populationSize;
-                offspringPopulation[parent2] = new int[chromosomeLength];
-                for (int i = 0; i < chromosomeLength; ++i) {
-                    offspringPopulation[parent2][i] = population[parent2][i];
-                }
-                performInversionMutation(parent2, chromosomeLength, mutationSegmentSizeRate);
-            }
-        }
-
+        // performCrossing replaces parent2 itself if it is still too similar to parent1
         performCrossing(parent1, parent2, offspringIndex, chromosomeLength, crossingSegmentSizeRate);
     }
 }
 
 
-int GeneticAlgorithm::calculateDiversity(int* chromosome1, int* chromosome2, int length) {
+int GeneticAlgorithm::calculateDiversity(const int* chromosome1, const int* chromosome2, int length) {
     int diversity = 0;
     for (int i = 0; i < length; ++i) {
         if (chromosome1[i] != chromosome2[i]) {
@@ -189,7 +256,7 @@ int GeneticAlgorithm::calculateDiversity(int* chromosome1, int* chromosome2, int
 
 
 // Perform inversion mutation
-void GeneticAlgorithm::performInversionMutation(int currentChromosome, int chromosomeLength, int mutationSegmentSizeRate) {
+bool GeneticAlgorithm::performInversionMutation(int* chromosome, int chromosomeLength, int mutationSegmentSizeRate) {
     // Calculate the actual segment size based on the mutationSegmentSizeRate rate (1 to 100)
     int segmentSize = (mutationSegmentSizeRate * chromosomeLength) / 100;
 
@@ -199,22 +266,43 @@ void GeneticAlgorithm::performInversionMutation(int currentChromosome, int chrom
     }
 
     // Choose the start and end indices of the inversion segment
-    int start = rand() % (chromosomeLength - segmentSize + 1);
+    int start = randomInt(chromosomeLength - segmentSize + 1);
     int end = start + segmentSize - 1;
 
-    // Perform the inversion
+    // With candidate lists, invert the segment that makes a city adjacent to one of its nearest successors
+    const CandidateLists* candidates = matrix.getCandidateLists();
+    if (candidates != nullptr && candidates->getK() > 0 && chromosomeLength > 2) {
+        int anchor = randomInt(chromosomeLength - 1);
+        int successor = candidates->getSuccessors(chromosome[anchor])[randomInt(candidates->getK())];
+
+        int successorIndex = -1;
+        for (int i = anchor + 2; i < chromosomeLength; ++i) {
+            if (chromosome[i] == successor) {
+                successorIndex = i;
+                break;
+            }
+        }
+        if (successorIndex != -1) {
+            start = anchor + 1;
+            end = successorIndex;
+        }
+    }
+
+    // Perform the inversion; the genes are distinct, so any segment of two or more changes the chromosome
+    bool changed = start < end;
     while (start < end) {
-        int temp = offspringPopulation[currentChromosome][start];
-        offspringPopulation[currentChromosome][start] = offspringPopulation[currentChromosome][end];
-        offspringPopulation[currentChromosome][end] = temp;
+        int temp = chromosome[start];
+        chromosome[start] = chromosome[end];
+        chromosome[end] = temp;
         start++;
         end--;
     }
+    return changed;
 }
 
 
 // Perform shuffle mutation
-void GeneticAlgorithm::performShuffleMutation(int currentChromosome, int chromosomeLength, int mutationSegmentSizeRate) {
+bool GeneticAlgorithm::performShuffleMutation(int* chromosome, int chromosomeLength, int mutationSegmentSizeRate) {
     // Calculate the actual segment size based on the mutationSegmentSizeRate rate (1 to 100)
     int segmentSize = (mutationSegmentSizeRate * chromosomeLength) / 100;
 
@@ -224,54 +312,58 @@ void GeneticAlgorithm::performShuffleMutation(int currentChromosome, int chromos
     }
 
     // Choose the start index for the shuffle
-    int start = rand() % (chromosomeLength - segmentSize + 1);
+    int start = randomInt(chromosomeLength - segmentSize + 1);
 
     // Perform Fisher-Yates shuffle within the segment
+    bool changed = false;
     for (int i = 0; i < segmentSize - 1; ++i) {
-        int randomIndex = start + (rand() % (segmentSize - i));
+        int randomIndex = start + randomInt(segmentSize - i);
         int currentIndex = start + i;
+        changed = changed || randomIndex != currentIndex; // Swaps that cancel each other out still count as a change
 
         // Swap the elements
-        int temp = offspringPopulation[currentChromosome][currentIndex];
-        offspringPopulation[currentChromosome][currentIndex] = offspringPopulation[currentChromosome][randomIndex];
-        offspringPopulation[currentChromosome][randomIndex] = temp;
+        int temp = chromosome[currentIndex];
+        chromosome[currentIndex] = chromosome[randomIndex];
+        chromosome[randomIndex] = temp;
     }
+    return changed;
 }
 
 
 // Perform crossing
 void GeneticAlgorithm::performCrossing(int parent1, int parent2, int offspringIndex, int chromosomeLength, int crossingSegmentSizeRate) {
+    PHASE_TIMER(Phase::GaCrossover);
     int retries = 0;
     const int maxRetries = 10; // Maximum retries to ensure diversity
     const double diversityThreshold = chromosomeLength * 0.3; // At least 30% diversity
 
     // Ensure parents are diverse enough
     while (calculateDiversity(population[parent1], population[parent2], chromosomeLength) < diversityThreshold && retries < maxRetries) {
-        parent2 = rand() % populationSize; // Select a new random parent2
+        parent2 = randomInt(populationSize); // Select a new random parent2
         retries++;
     }
+    counters.diversityRetries += retries;
+    ++counters.crossovers;
+    const int* firstParent = population[parent1];
+    const int* secondParent = population[parent2];
 
     // Diversification mechanism: If retries exceed limit
     if (retries >= maxRetries) {
-        if (rand() % 2 == 0) {
+        if (randomInt(2) == 0) {
             // Option 1: Replace parent2 with a new random chromosome
-            parent2 = offspringIndex;
-            offspringPopulation[parent2] = generateChromosome(chromosomeLength);
+            fillRandomChromosome(scratchChromosome, chromosomeLength);
         } else {
-            // Option 2: Apply mutation to ensure diversity
-            parent2 = rand() % populationSize;
-            int* mutatedChromosome = new int[chromosomeLength];
-            for (int i = 0; i < chromosomeLength; ++i) {
-                mutatedChromosome[i] = population[parent2][i];
-            }
-            performInversionMutation(parent2, chromosomeLength, mutationSegmentSizeRate);
-            population[parent2] = mutatedChromosome;
+            // Option 2: Use a mutated copy of a random chromosome to ensure diversity
+            parent2 = randomInt(populationSize);
+            std::copy(population[parent2], population[parent2] + chromosomeLength, scratchChromosome);
+            performInversionMutation(scratchChromosome, chromosomeLength, mutationSegmentSizeRate);
         }
+        secondParent = scratchChromosome;
     }
 
-    // Allocate memory for two offspring
-    offspringPopulation[offspringIndex] = new int[chromosomeLength];
-    offspringPopulation[offspringIndex + 1] = new int[chromosomeLength];
+    // The two offspring go to offspringIndex and offspringIndex + 1 (the spare slot when offspringIndex is the last one)
+    int* child1 = offspringPopulation[offspringIndex];
+    int* child2 = offspringPopulation[offspringIndex + 1];
 
     // Initialize used markers for crossover
     bool* used1 = new bool[chromosomeLength + 1](); // For offspring 1
@@ -286,109 +378,109 @@ void GeneticAlgorithm::performCrossing(int parent1, int parent2, int offspringIn
     }
 
     // Choose random segment for crossover
-    int start = rand() % (chromosomeLength - segmentSize + 1);
+    int start = randomInt(chromosomeLength - segmentSize + 1);
     int end = start + segmentSize;
 
+    // Duplicate offspring are detected while the genes are written, without another pass over the chromosomes:
+    // a child can only equal the parent its segment came from if the parents share that segment
+    bool segmentShared = true;
+
     // Copy the segment from parents to offspring
     for (int i = start; i < end; ++i) {
-        offspringPopulation[offspringIndex][i] = population[parent1][i];
-        offspringPopulation[offspringIndex + 1][i] = population[parent2][i];
+        child1[i] = firstParent[i];
+        child2[i] = secondParent[i];
+        segmentShared = segmentShared && firstParent[i] == secondParent[i];
 
-        used1[population[parent1][i]] = true;
-        used2[population[parent2][i]] = true;
+        used1[firstParent[i]] = true;
+        used2[secondParent[i]] = true;
     }
 
     // Fill remaining genes
     int index1 = 0, index2 = 0;
+    bool child1DiffersFromFirst = false, child1DiffersFromSecond = !segmentShared;
+    bool child2DiffersFromSecond = false, child2DiffersFromFirst = !segmentShared;
     for (int i = 0; i < chromosomeLength; ++i) {
         // Fill offspring 1
         if (i < start || i >= end) {
-            while (used1[population[parent2][index1]]) {
+            while (used1[secondParent[index1]]) {
                 index1++;
             }
-            offspringPopulation[offspringIndex][i] = population[parent2][index1];
-            used1[population[parent2][index1]] = true;
+            child1[i] = secondParent[index1];
+            used1[secondParent[index1]] = true;
             index1++;
+            child1DiffersFromFirst = child1DiffersFromFirst || child1[i] != firstParent[i];
+            child1DiffersFromSecond = child1DiffersFromSecond || child1[i] != secondParent[i];
         }
 
         // Fill offspring 2
         if (i < start || i >= end) {
-            while (used2[population[parent1][index2]]) {
+            while (used2[firstParent[index2]]) {
                 index2++;
             }
-            offspringPopulation[offspringIndex + 1][i] = population[parent1][index2];
-            used2[population[parent1][index2]] = true;
+            child2[i] = firstParent[index2];
+            used2[firstParent[index2]] = true;
             index2++;
+            child2DiffersFromSecond = child2DiffersFromSecond || child2[i] != secondParent[i];
+            child2DiffersFromFirst = child2DiffersFromFirst || child2[i] != firstParent[i];
         }
     }
 
+    // Offspring that equal a parent add nothing new to the population
+    counters.duplicateOffspring += !(child1DiffersFromFirst && child1DiffersFromSecond);
+    if (offspringIndex + 1 < populationSize) { // Not the spare slot
+        counters.duplicateOffspring += !(child2DiffersFromSecond && child2DiffersFromFirst);
+    }
+
     // Clean up
     delete[] used1;
     delete[] used2;
 }
 
-void swap(int*& a, int*& b) {
-    int* temp = a;
-    a = b;
-    b = temp;
-}
-
-void swap(int& a, int& b) {
-    int temp = a;
-    a = b;
-    b = temp;
-}
-
 void GeneticAlgorithm::selection(int chromosomeLength) {
+    PHASE_TIMER(Phase::GaSelection);
     // Combine population and offspring
     int totalSize = 2 * populationSize;
     int** combinedPopulation = new int*[totalSize];
-    int* fitnessScores = new int[totalSize];
+    std::vector<std::pair<int, int>> ranking(totalSize); // (fitness, index in combinedPopulation)
 
     for (int i = 0; i < populationSize; ++i) {
         combinedPopulation[i] = population[i];
-        fitnessScores[i] = calculatePathCost(population[i]);
-    }
-    for (int i = 0; i < populationSize; ++i) {
         combinedPopulation[populationSize + i] = offspringPopulation[i];
-        fitnessScores[populationSize + i] = calculatePathCost(offspringPopulation[i]);
     }
-
-    // Sort combinedPopulation by fitnessScores
-    for (int i = 0; i < totalSize - 1; ++i) {
-        for (int j = i + 1; j < totalSize; ++j) {
-            if (fitnessScores[i] > fitnessScores[j]) {
-                swap(fitnessScores[i], fitnessScores[j]); // Use custom swap for integers
-                swap(combinedPopulation[i], combinedPopulation[j]); // Use custom swap for pointers
-            }
+    {
+        PHASE_TIMER(Phase::GaFitness);
+        for (int i = 0; i < totalSize; ++i) {
+            ranking[i] = std::make_pair(calculatePathCost(combinedPopulation[i]), i);
         }
     }
 
+    // Rank combinedPopulation by fitness
+    std::sort(ranking.begin(), ranking.end());
+
     // Calculate the number of chromosomes to replace for diversity
     int numDiverseChromosomes = (populationSize * randomRateNewGen) / 100;
 
-    // Select top chromosomes for the next generation
+    // Select top chromosomes for the next generation; buffers change owner instead of being copied
     for (int i = 0; i < populationSize - numDiverseChromosomes; ++i) {
-        for (int j = 0; j < chromosomeLength; ++j) {
-            population[i][j] = combinedPopulation[i][j];
-        }
+        population[i] = combinedPopulation[ranking[i].second];
     }
 
-    // Introduce diversity by picking from the lower half of the sorted population
+    // Introduce diversity by picking from the lower half of the sorted population. The picks are copied
+    // into the buffers ranked just above that half, which are never picked themselves.
     int startIndex = populationSize; // Start picking from the offspring
     for (int i = populationSize - numDiverseChromosomes; i < populationSize; ++i) {
-        int randomIndex = startIndex + (rand() % (totalSize - startIndex)); // Pick from the lower-ranked half
-        delete[] population[i]; // Clean up old chromosome
-        population[i] = new int[chromosomeLength];
+        int randomIndex = startIndex + randomInt(totalSize - startIndex); // Pick from the lower-ranked half
+        const int* picked = combinedPopulation[ranking[randomIndex].second];
+        population[i] = combinedPopulation[ranking[i].second];
+        std::copy(picked, picked + chromosomeLength, population[i]);
+    }
 
-        // Copy the randomly picked chromosome
-        for (int j = 0; j < chromosomeLength; ++j) {
-            population[i][j] = combinedPopulation[randomIndex][j];
-        }
+    // The lower-ranked half becomes the offspring buffers of the next generation
+    for (int i = 0; i < populationSize; ++i) {
+        offspringPopulation[i] = combinedPopulation[ranking[populationSize + i].second];
     }
 
     // Clean up
-    delete[] fitnessScores;
     delete[] combinedPopulation;
 }
 
@@ -396,8 +488,12 @@ void GeneticAlgorithm::selection(int chromosomeLength) {
 
 void GeneticAlgorithm::parseParametersFromJSON(const nlohmann::json& config_json) {
     try {
-        // Validate and parse the configuration
-        const auto& config = config_json.at("geneticAlgorithmConfiguration");
+        // Validate and parse the configuration; a tuned profile of the instance's size class overrides its values
+        nlohmann::json config = config_json.at("geneticAlgorithmConfiguration");
+        nlohmann::json profile = sizeProfile(config_json, problemSize);
+        if (profile.contains("geneticAlgorithmConfiguration")) {
+            config.update(profile.at("geneticAlgorithmConfiguration"));
+        }
 
         // Validate and parse crossingSegmentSizeRate
         if (config.contains("crossingSegmentSizeRate") && config["crossingSegmentSizeRate"].is_number_integer()) {
@@ -496,7 +592,7 @@ void GeneticAlgorithm::parseParametersFromJSON(const nlohmann::json& config_json
 
 
 int GeneticAlgorithm::calculatePathCost(const int *path) {
-    int totalCost = 0;
+    long long totalCost = 0; // 64-bit so that forbidden-edge sentinels cannot overflow
 
     // Include city 0 as the start and end point
     int prevCity = 0; // Starting from city 0
@@ -510,7 +606,7 @@ int GeneticAlgorithm::calculatePathCost(const int *path) {
     // Add cost from the last city back to city 0
     totalCost += matrix.getCost(prevCity, 0);
 
-    return totalCost;
+    return Matrix::saturateCost(totalCost);
 }
 
 
@@ -518,8 +614,21 @@ void GeneticAlgorithm::runGeneticAlgorithm() {
     // Initialize variables for tracking the best solution
     int bestCost = INT_MAX;
     int* bestPath = nullptr;
+    int firstIteration = 0;
+    stopped = false;
+    completedGenerations = 0;
+    counters = SearchCounters();
+
+    std::string checkpointPath;
+    if (checkpointer != nullptr) {
+        checkpointPath = checkpointer->pathFor("ga", matrix, checkpointRun);
+        if (loadCheckpoint(checkpointPath, firstIteration, bestCost)) {
+            LOG_INFO("Resuming genetic algorithm from generation " << firstIteration + 1);
+        }
+        lastCheckpoint = std::chrono::steady_clock::now();
+    }
 
-    for (int iteration = 0; iteration < iterationNum; ++iteration) {
+    for (int iteration = firstIteration; iteration < iterationNum; ++iteration) {
         // Step 1: Generate offspring
         generateOffspring(problemSize - 1);
 
@@ -537,10 +646,32 @@ void GeneticAlgorithm::runGeneticAlgorithm() {
             for (int i = 0; i < problemSize - 1; ++i) {
                 bestPath[i] = population[0][i];
             }
+            if (incumbent != nullptr) {
+                std::vector<int> tour(1, 0); // Chromosomes leave out the start city
+                tour.insert(tour.end(), bestPath, bestPath + problemSize - 1);
+                incumbent->offer(bestCost, tour, "ga");
+            }
         }
 
-        std::cout << "Iteration " << iteration + 1 << ": Best cost = " << bestCost << std::endl;
+        LOG_DEBUG("Iteration " << iteration + 1 << ": Best cost = " << bestCost);
+        completedGenerations = iteration + 1;
+
+        if (iteration + 1 < iterationNum &&
+            (std::chrono::steady_clock::now() >= deadline || (incumbent != nullptr && incumbent->shouldStop()))) {
+            stopped = true;
+            if (checkpointer != nullptr) {
+                saveCheckpoint(checkpointPath, iteration + 1, bestCost); // Lets a later run continue from here
+            }
+            break;
+        }
+        if (checkpointer != nullptr && checkpointer->due(lastCheckpoint)) {
+            saveCheckpoint(checkpointPath, iteration + 1, bestCost);
+        }
     }
+    if (checkpointer != nullptr && !stopped) {
+        checkpointer->remove(checkpointPath); // The run is complete
+    }
+    Logger::instance().flush(); // The caller prints the result directly
 
     // // Output the best solution
     // std::cout << "Best solution found:" << std::endl;
@@ -558,6 +689,63 @@ void GeneticAlgorithm::runGeneticAlgorithm() {
 }
 
 
+std::string GeneticAlgorithm::checkpointParameters() const {
+    return "populationSize=" + std::to_string(populationSize) + ";iterationNum=" + std::to_string(iterationNum) +
+           ";crossingSegmentSizeRate=" + std::to_string(crossingSegmentSizeRate) +
+           ";mutationSegmentSizeRate=" + std::to_string(mutationSegmentSizeRate) + ";mutationType=" + mutationType +
+           ";mutationRate=" + std::to_string(mutationRate) + ";randomRate=" + std::to_string(randomRate) +
+           ";randomRateNewGen=" + std::to_string(randomRateNewGen);
+}
+
+void GeneticAlgorithm::saveCheckpoint(const std::string& path, int nextIteration, int bestCost) {
+    CheckpointBuffer buffer;
+    buffer.putString("ga");
+    buffer.putString(matrix.getFingerprint());
+    buffer.putParameters(checkpointParameters());
+    buffer.putInt(nextIteration);
+    buffer.putInt(bestCost);
+    buffer.putRng(rng);
+    for (int i = 0; i < populationSize; ++i) {
+        buffer.putInts(population[i], problemSize - 1);
+    }
+    checkpointer->save(path, buffer);
+}
+
+bool GeneticAlgorithm::loadCheckpoint(const std::string& path, int& nextIteration, int& bestCost) {
+    CheckpointBuffer buffer;
+    if (!checkpointer->load(path, buffer)) {
+        return false;
+    }
+    try {
+        if (buffer.getString() != "ga" || buffer.getString() != matrix.getFingerprint() ||
+            !buffer.matchesParameters(checkpointParameters())) {
+            LOG_WARNING("checkpoint " << path << " was written with a different configuration, starting over");
+            return false;
+        }
+        int iteration = buffer.getInt();
+        int cost = buffer.getInt();
+        std::mt19937 restoredRng;
+        buffer.getRng(restoredRng);
+        std::vector<int> genes(static_cast<size_t>(populationSize) * (problemSize - 1));
+        if (!genes.empty()) {
+            buffer.getInts(genes.data(), static_cast<int>(genes.size()));
+        }
+
+        // Only commit once everything was read
+        for (int i = 0; i < populationSize; ++i) {
+            std::copy(genes.begin() + static_cast<size_t>(i) * (problemSize - 1),
+                      genes.begin() + static_cast<size_t>(i + 1) * (problemSize - 1), population[i]);
+        }
+        rng = restoredRng;
+        nextIteration = iteration;
+        bestCost = cost;
+        return true;
+    } catch (const std::runtime_error& e) {
+        LOG_WARNING("ignoring checkpoint " << path << ": " << e.what());
+        return false;
+    }
+}
+
 int* GeneticAlgorithm::getBestPath() {
     // Allocate memory for the best path
     int* bestPath = new int[problemSize + 1];
@@ -651,3 +839,75 @@ void GeneticAlgorithm::printSolution() {
 }
 
 
+/**
+ * @class GeneticAlgorithmSolver
+ * @brief ISolver adapter of GeneticAlgorithm, registered as "ga".
+ *
+ * Parameters: either "configPath", the path of a GA configuration file, or the
+ * "geneticAlgorithmConfiguration" object of such a file inline. Consecutive runs on the same matrix
+ * reuse the chromosome buffers (see GeneticAlgorithm::reconfigure()).
+ */
+class GeneticAlgorithmSolver : public ISolver {
+public:
+    std::string name() const override { return "ga"; }
+    std::string description() const override { return "Genetic"; }
+    bool isExact() const override { return false; }
+
+    SolveResult solve(const SolveRequest& request) override {
+        const Matrix& matrix = requireMatrix(request);
+        if (!request.parameters.contains("configPath") && !request.parameters.contains("geneticAlgorithmConfiguration")) {
+            throw std::invalid_argument("Genetic algorithm needs a 'configPath' or 'geneticAlgorithmConfiguration' parameter");
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const nlohmann::json& config = request.parameters.contains("geneticAlgorithmConfiguration")
+                                           ? request.parameters
+                                           : GeneticAlgorithm::readConfigFile(request.parameters.at("configPath").get<std::string>());
+        if (ga && gaMatrix == &matrix && gaSize == matrix.getSize()) {
+            try {
+                ga->reconfigure(config, seedFor(request)); // Keeps the chromosome buffers of the previous run
+            } catch (...) {
+                ga.reset();
+                throw;
+            }
+        } else {
+            ga.reset(new GeneticAlgorithm(matrix, config, seedFor(request)));
+            gaMatrix = &matrix;
+            gaSize = matrix.getSize();
+        }
+        ga->setCheckpointer(request.checkpointer, request.run);
+        ga->setDeadline(request.deadline);
+        ga->setIncumbent(request.incumbent);
+
+        SolveResult result;
+        result.solver = name();
+        result.parameters = request.parameters;
+        result.parameters["geneticAlgorithmConfiguration"] = {
+            {"populationSize", ga->getPopulationSize()}, {"iterationNum", ga->getIterationNum()},
+            {"crossingSegmentSizeRate", ga->getCrossingSegmentSizeRate()}, {"mutationSegmentSizeRate", ga->getMutationSegmentSizeRate()},
+            {"mutationType", std::string(1, ga->getMutationType())}, {"mutationRate", static_cast<int>(ga->getMutationRate())},
+            {"randomRate", ga->getRandomRate()}, {"randomRateNewGen", ga->getRandomRateNewGen()}}; // Accepted by the inline form
+        result.timings.setupMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        ga->runGeneticAlgorithm();
+        result.timings.solveMs = millisecondsSince(start);
+
+        result.cost = ga->getBestSolution();
+        int* path = ga->getBestPath();
+        if (path != nullptr) {
+            result.tour.assign(path, path + matrix.getSize()); // Drop the return to the start
+            delete[] path;
+        }
+        result.timedOut = ga->isStopped();
+        result.stats["generations"] = static_cast<unsigned long long>(ga->getGenerationCount());
+        ga->getSearchCounters().writeTo(result.stats);
+        return result;
+    }
+
+private:
+    std::unique_ptr<GeneticAlgorithm> ga; ///< Algorithm of the last run, reused while the matrix stays the same.
+    const Matrix* gaMatrix = nullptr;     ///< Matrix ga was built for.
+    int gaSize = 0;                       ///< Its size, so a new matrix at the same address is not mistaken for it.
+};
+
+REGISTER_SOLVER(GeneticAlgorithmSolver, "ga");
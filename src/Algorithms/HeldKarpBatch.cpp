@@ -0,0 +1,192 @@
+#include "../../include/Algorithms/HeldKarpBatch.h"
+#include "../../include/matrix.h"
+
+#include <algorithm>
+#include <climits>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+static_assert(HeldKarpBatch::LANES == 8, "The AVX2 kernel holds one group in a 256-bit register");
+#endif
+
+namespace {
+
+// Cost of a forbidden edge and cap of every DP value. A feasible tour of at most MAX_SIZE edges below FORBIDDEN_COST
+// stays below it, so a lane is infeasible exactly when it reaches it, however large its feasible costs are. Values
+// never exceed it (relax() starts from it), so a value plus an edge fits into 32 unsigned bits.
+const uint32_t UNREACHABLE = static_cast<uint32_t>(HeldKarpBatch::MAX_SIZE) * Matrix::FORBIDDEN_COST;
+static_assert(static_cast<unsigned long long>(HeldKarpBatch::MAX_SIZE) * Matrix::FORBIDDEN_COST * 2 <= UINT32_MAX,
+              "Two capped values must not overflow a 32-bit lane");
+
+/**
+ * @brief Writes the lane-wise minimum of paths[k] + edges[k] over the cities k of a subset.
+ *
+ * @param out LANES values.
+ * @param paths DP values of the subset, free * LANES values.
+ * @param edges Costs from each city k + 1 to the next city; consecutive k are edgeStride apart.
+ */
+inline void relax(uint32_t* out, const uint32_t* paths, const uint32_t* edges, int edgeStride, int subset, int free) {
+#ifdef __AVX2__
+    __m256i best = _mm256_set1_epi32(static_cast<int>(UNREACHABLE));
+    for (int k = 0; k < free; ++k) {
+        if (subset & (1 << k)) {
+            __m256i path = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(paths + k * HeldKarpBatch::LANES));
+            __m256i edge = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(edges + k * edgeStride));
+            best = _mm256_min_epu32(best, _mm256_add_epi32(path, edge));
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), best);
+#else
+    uint32_t best[HeldKarpBatch::LANES];
+    std::fill(best, best + HeldKarpBatch::LANES, UNREACHABLE);
+    for (int k = 0; k < free; ++k) {
+        if (subset & (1 << k)) {
+            const uint32_t* path = paths + k * HeldKarpBatch::LANES;
+            const uint32_t* edge = edges + k * edgeStride;
+            for (int lane = 0; lane < HeldKarpBatch::LANES; ++lane) {
+                best[lane] = std::min(best[lane], path[lane] + edge[lane]);
+            }
+        }
+    }
+    std::copy(best, best + HeldKarpBatch::LANES, out);
+#endif
+}
+
+} // namespace
+
+HeldKarpBatch::HeldKarpBatch(int size) : size(size), free(size - 1) {
+    if (size < 1 || size > MAX_SIZE) {
+        throw std::invalid_argument("Batch instances must have between 1 and " + std::to_string(MAX_SIZE) + " cities");
+    }
+    lanes.resize(static_cast<size_t>(size) * size * LANES);
+    table.resize((static_cast<size_t>(1) << free) * free * LANES);
+}
+
+void HeldKarpBatch::solve(const int* costs, size_t count, int* tourCosts, int* tours) {
+    size_t cells = static_cast<size_t>(size) * size;
+    for (size_t first = 0; first < count; first += LANES) {
+        int used = static_cast<int>(std::min<size_t>(LANES, count - first));
+        solveGroup(costs + first * cells, used, tourCosts + first, tours == nullptr ? nullptr : tours + first * size);
+    }
+}
+
+void HeldKarpBatch::solveGroup(const int* costs, int used, int* tourCosts, int* tours) {
+    // Interleave the costs: lanes[(i * size + j) * LANES + lane] is the cost of edge (i, j) in instance lane
+    size_t cells = static_cast<size_t>(size) * size;
+    for (int lane = 0; lane < LANES; ++lane) {
+        const int* instance = costs + (lane < used ? lane : 0) * cells;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            int cost = instance[cell];
+            if (cost < 0 && cell % (size + 1) != 0) {
+                throw std::invalid_argument("Batch costs must not be negative");
+            }
+            lanes[cell * LANES + lane] = cell % (size + 1) == 0 ? 0 : (cost < Matrix::FORBIDDEN_COST ? static_cast<uint32_t>(cost) : UNREACHABLE);
+        }
+    }
+
+    if (free == 0) {
+        for (int lane = 0; lane < used; ++lane) {
+            tourCosts[lane] = 0;
+            if (tours != nullptr) tours[lane] = 0;
+        }
+        return;
+    }
+
+    // City c of the DP is city c + 1 of the instance; subsets are ordered so every subset follows its subsets
+    int full = (1 << free) - 1;
+    int edgeStride = size * LANES;
+    for (int subset = 1; subset <= full; ++subset) {
+        for (int last = 0; last < free; ++last) {
+            if (!(subset & (1 << last))) continue;
+            uint32_t* state = &table[(static_cast<size_t>(subset) * free + last) * LANES];
+            int rest = subset ^ (1 << last);
+            if (rest == 0) {
+                std::copy_n(&lanes[(last + 1) * LANES], LANES, state); // Directly from city 0
+            } else {
+                relax(state, &table[static_cast<size_t>(rest) * free * LANES], &lanes[(size + last + 1) * LANES], edgeStride, rest, free);
+            }
+        }
+    }
+
+    // Close the tours at city 0
+    uint32_t closing[LANES];
+    relax(closing, &table[static_cast<size_t>(full) * free * LANES], &lanes[size * LANES], edgeStride, full, free);
+    for (int lane = 0; lane < used; ++lane) {
+        int* tour = tours == nullptr ? nullptr : tours + lane * size;
+        if (closing[lane] >= UNREACHABLE) {
+            tourCosts[lane] = INT_MAX;
+            if (tour != nullptr) std::fill(tour, tour + size, -1);
+            continue;
+        }
+        tourCosts[lane] = static_cast<int>(closing[lane]);
+        if (tour != nullptr) {
+            for (int last = 0; last < free; ++last) {
+                if (table[(static_cast<size_t>(full) * free + last) * LANES + lane] + lanes[((last + 1) * size) * LANES + lane] == closing[lane]) {
+                    reconstruct(lane, last, tour);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void HeldKarpBatch::reconstruct(int lane, int last, int* tour) const {
+    int subset = (1 << free) - 1;
+    tour[0] = 0;
+    for (int position = size - 1; position > 0; --position) {
+        tour[position] = last + 1;
+        int rest = subset ^ (1 << last);
+        uint32_t value = table[(static_cast<size_t>(subset) * free + last) * LANES + lane];
+        for (int k = 0; k < free; ++k) {
+            if ((rest & (1 << k)) &&
+                table[(static_cast<size_t>(rest) * free + k) * LANES + lane] + lanes[((k + 1) * size + last + 1) * LANES + lane] == value) {
+                last = k;
+                break;
+            }
+        }
+        subset = rest;
+    }
+}
+
+void solveBatch(const int* costs, int size, size_t count, int* tourCosts, int* tours, int threads) {
+    if (size < 1 || size > HeldKarpBatch::MAX_SIZE) {
+        throw std::invalid_argument("Batch instances must have between 1 and " + std::to_string(HeldKarpBatch::MAX_SIZE) + " cities");
+    }
+    size_t groups = (count + HeldKarpBatch::LANES - 1) / HeldKarpBatch::LANES;
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(static_cast<size_t>(std::max(threads, 1)), groups)));
+
+    // Contiguous ranges of whole groups, so no group straddles two threads
+    size_t cells = static_cast<size_t>(size) * size;
+    size_t chunk = (groups + threads - 1) / threads * HeldKarpBatch::LANES;
+    std::vector<std::exception_ptr> errors(threads);
+    auto work = [&](int t) {
+        size_t first = t * chunk;
+        size_t last = std::min(count, first + chunk);
+        if (first >= last) return;
+        try {
+            HeldKarpBatch batch(size);
+            batch.solve(costs + first * cells, last - first, tourCosts + first, tours == nullptr ? nullptr : tours + first * size);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
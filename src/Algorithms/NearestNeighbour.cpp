@@ -0,0 +1,84 @@
+#include "../../include/Algorithms/NearestNeighbour.h"
+#include "../../include/Algorithms/Solver.h"
+
+#include <climits>
+#include <stdexcept>
+
+NearestNeighbour::NearestNeighbour(const Matrix& matrix) : matrix(matrix), bestCost(INT_MAX) {}
+
+void NearestNeighbour::run(int start) {
+    int n = matrix.getSize();
+    if (start < 0 || start >= n) {
+        throw std::invalid_argument("Nearest neighbour start city out of range");
+    }
+
+    std::vector<bool> visited(n, false);
+    tour.assign(1, start);
+    visited[start] = true;
+    long long cost = 0; // 64-bit so that forbidden-edge sentinels cannot overflow
+
+    for (int step = 1; step < n; ++step) {
+        int from = tour.back();
+        int next = -1;
+        bool nextForbidden = true;
+        int nextCost = INT_MAX;
+        for (int city = 0; city < n; ++city) {
+            if (visited[city]) continue;
+            bool forbidden = matrix.isForbidden(from, city);
+            int edgeCost = matrix.getCost(from, city);
+            // Any allowed edge beats a forbidden one, then the cheaper edge wins
+            if (next == -1 || (nextForbidden && !forbidden) || (forbidden == nextForbidden && edgeCost < nextCost)) {
+                next = city;
+                nextForbidden = forbidden;
+                nextCost = edgeCost;
+            }
+        }
+        tour.push_back(next);
+        visited[next] = true;
+        cost += nextCost;
+    }
+    cost += matrix.getCost(tour.back(), start);
+    bestCost = Matrix::saturateCost(cost);
+}
+
+int NearestNeighbour::getBestCost() const {
+    return bestCost;
+}
+
+const std::vector<int>& NearestNeighbour::getBestPath() const {
+    return tour;
+}
+
+
+/**
+ * @class NearestNeighbourSolver
+ * @brief ISolver adapter of NearestNeighbour, registered as "nn". Parameter: "start" (default 0).
+ */
+class NearestNeighbourSolver : public ISolver {
+public:
+    std::string name() const override { return "nn"; }
+    std::string description() const override { return "Nearest Neighbour"; }
+    bool isExact() const override { return false; }
+
+    SolveResult solve(const SolveRequest& request) override {
+        const Matrix& matrix = requireMatrix(request);
+        int start = request.parameters.value("start", 0);
+
+        SolveResult result;
+        result.solver = name();
+        result.parameters = {{"start", start}};
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        NearestNeighbour nn(matrix);
+        nn.run(start);
+        result.timings.solveMs = millisecondsSince(begin);
+
+        result.cost = nn.getBestCost();
+        result.tour = nn.getBestPath();
+        if (request.incumbent != nullptr) {
+            request.incumbent->offer(result.cost, result.tour, name());
+        }
+        return result;
+    }
+};
+
+REGISTER_SOLVER(NearestNeighbourSolver, "nn");
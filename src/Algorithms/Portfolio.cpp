@@ -0,0 +1,91 @@
+#include "../../include/Algorithms/Portfolio.h"
+#include "../../include/logger.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+SolveResult PortfolioSolver::solve(const SolveRequest& request) {
+    requireMatrix(request);
+    std::vector<std::string> names = request.parameters.value("solvers", std::vector<std::string>{"bnb", "tabu", "ga"});
+    if (names.empty() || std::find(names.begin(), names.end(), name()) != names.end()) {
+        throw std::invalid_argument("Portfolio needs a non-empty list of solvers other than 'portfolio'");
+    }
+
+    // Create every member first so that an unknown name fails before any thread starts
+    std::vector<std::unique_ptr<ISolver>> members;
+    for (const std::string& member : names) {
+        members.push_back(SolverRegistry::instance().create(member));
+    }
+
+    // Members share the caller's incumbent if there is one, so that its listener, pauses and cancellation reach them
+    SharedIncumbent ownIncumbent;
+    SharedIncumbent& incumbent = request.incumbent != nullptr ? *request.incumbent : ownIncumbent;
+    std::vector<SolveResult> results(members.size());
+    std::vector<std::exception_ptr> errors(members.size());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < members.size(); ++i) {
+        threads.emplace_back([&, i] {
+            SolveRequest memberRequest = request;
+            memberRequest.parameters = request.parameters.value(names[i], nlohmann::json::object());
+            memberRequest.seed = request.seed != 0 ? request.seed + static_cast<unsigned int>(i) : 0;
+            memberRequest.incumbent = &incumbent;
+            try {
+                results[i] = members[i]->solve(memberRequest);
+                if (results[i].optimal) {
+                    incumbent.cancel(); // Nothing left to find
+                }
+            } catch (...) {
+                errors[i] = std::current_exception();
+                incumbent.cancel();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    SolveResult result;
+    result.solver = name();
+    result.timings.solveMs = millisecondsSince(start);
+    result.parameters = {{"solvers", names}};
+    std::string winner;
+    result.cost = incumbent.get(result.tour, winner);
+    SearchCounters counters; // Each member counted on its own thread; summed once they have all finished
+    for (size_t i = 0; i < members.size(); ++i) {
+        const SolveResult& member = results[i];
+        result.parameters[names[i]] = member.parameters;
+        result.optimal = result.optimal || member.optimal;
+        result.timedOut = result.timedOut || member.timedOut;
+        result.bound = std::max(result.bound, member.bound);
+        if (member.cost < result.cost) {
+            // A member that does not publish its tours still competes with its final result
+            result.cost = member.cost;
+            result.tour = member.tour;
+            winner = names[i];
+        }
+        for (const auto& stat : member.stats) {
+            result.stats[names[i] + "." + stat.first] = stat.second;
+        }
+        counters += SearchCounters::fromStats(member.stats);
+    }
+    counters.writeTo(result.stats);
+    if (result.optimal) {
+        result.timedOut = false;
+        result.bound = result.cost;
+    }
+
+    LOG_INFO("Portfolio best tour by " << (winner.empty() ? std::string("none") : winner)
+             << (result.optimal ? " (proven optimal)" : ""));
+    return result;
+}
+
+REGISTER_SOLVER(PortfolioSolver, "portfolio");
@@ -0,0 +1,96 @@
+#include "../../include/Algorithms/Solver.h"
+
+#include <random>
+#include <stdexcept>
+
+unsigned int ISolver::seedFor(const SolveRequest& request) {
+    return request.seed != 0 ? request.seed : std::random_device{}();
+}
+
+double ISolver::millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+const Matrix& ISolver::requireMatrix(const SolveRequest& request) {
+    if (request.matrix == nullptr) {
+        throw std::invalid_argument("Solve request has no matrix");
+    }
+    return *request.matrix;
+}
+
+
+// Defined by REGISTER_SOLVER in the built-in solvers' translation units
+extern int BranchAndBoundSolverAnchor, BruteForceSolverAnchor, GeneticAlgorithmSolverAnchor, NearestNeighbourSolverAnchor,
+    PortfolioSolverAnchor, TabuSearchSolverAnchor;
+
+SolverRegistry& SolverRegistry::instance() {
+    static SolverRegistry registry;
+    static volatile int anchors = BranchAndBoundSolverAnchor + BruteForceSolverAnchor + GeneticAlgorithmSolverAnchor +
+                                  NearestNeighbourSolverAnchor + PortfolioSolverAnchor + TabuSearchSolverAnchor;
+    (void)anchors;
+    return registry;
+}
+
+void SolverRegistry::add(const std::string& name, Factory factory) {
+    if (!factories.emplace(name, std::move(factory)).second) {
+        throw std::logic_error("Solver '" + name + "' is registered twice");
+    }
+}
+
+std::unique_ptr<ISolver> SolverRegistry::create(const std::string& name) const {
+    auto it = factories.find(name);
+    if (it == factories.end()) {
+        std::string known;
+        for (const auto& entry : factories) {
+            known += (known.empty() ? "" : ", ") + entry.first;
+        }
+        throw std::runtime_error("Unknown solver '" + name + "'. Registered solvers: " + known);
+    }
+    return it->second();
+}
+
+bool SolverRegistry::contains(const std::string& name) const {
+    return factories.count(name) != 0;
+}
+
+std::vector<std::string> SolverRegistry::names() const {
+    std::vector<std::string> result;
+    for (const auto& entry : factories) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+
+SolverPool::SolverPool(std::string solver) : solver(std::move(solver)) {}
+
+SolveResult SolverPool::solve(const SolveRequest& request) {
+    std::unique_ptr<ISolver> instance;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idle.empty()) {
+            instance = std::move(idle.back());
+            idle.pop_back();
+        }
+    }
+    if (!instance) {
+        instance = SolverRegistry::instance().create(solver);
+    }
+    SolveResult result = instance->solve(request);
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(std::move(instance));
+    return result;
+}
+
+
+nlohmann::json sizeProfile(const nlohmann::json& parameters, int size) {
+    if (!parameters.contains("profiles") || !parameters.at("profiles").is_array()) {
+        return nlohmann::json::object();
+    }
+    for (const nlohmann::json& profile : parameters.at("profiles")) {
+        if (!profile.contains("maxSize") || profile.at("maxSize").get<int>() >= size) {
+            return profile;
+        }
+    }
+    return nlohmann::json::object();
+}
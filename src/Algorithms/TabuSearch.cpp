@@ -1,36 +1,66 @@
 #include "../../include/Algorithms/TabuSearch.h"
+#include "../../include/Algorithms/Solver.h"
+#include "../../include/logger.h"
+#include "../../include/phase_timer.h"
+#include <climits> // For INT_MAX
+#include <cstring> // For std::memcpy
+#include <algorithm> // For std::reverse
+#include <stdexcept>
+#include <vector>
 
 
-TabuSearch::TabuSearch(const Matrix& matrix, int tabuListSize, int maxIterations)
-    : matrix(matrix), tabuListSize(tabuListSize), maxIterations(maxIterations) {
+TabuSearch::TabuSearch(const Matrix& matrix, int tabuListSize, int maxIterations, unsigned int seed)
+    : matrix(matrix), useReversal(matrix.isSymmetric()), tabuListSize(tabuListSize), maxIterations(maxIterations),
+      rng(seed), checkpointer(nullptr), deadline(std::chrono::steady_clock::time_point::max()), stopped(false),
+      incumbent(nullptr), completedIterations(0) {
     size = matrix.getSize();
-    bestCost = INT_MAX;
+    bestCost = LLONG_MAX;
     bestPath = new int[size + 1];  // Corrected to size + 1
     currentPath = new int[size + 1];  // Corrected to size + 1
+    position = new int[size];
 
     // Initialize a random path
     currentPath[0] = 0;  // Start at city 0
     bool visited[size] = {false};
     visited[0] = true; // Mark city 0 as visited
-    srand(time(nullptr));
 
+    std::vector<int> feasible;
     for (int i = 1; i < size; ++i) {
-        int city;
-        do {
-            city = rand() % size; // Pick a random city
-        } while (visited[city] || city == 0); // Ensure it's not visited and not city 0
+        int city = -1;
+
+        // On sparse instances prefer a random allowed successor so the start path avoids forbidden edges
+        if (matrix.hasForbiddenEdges()) {
+            feasible.clear();
+            const int* successors = matrix.getAllowedSuccessors(currentPath[i - 1]);
+            int count = matrix.getAllowedSuccessorCount(currentPath[i - 1]);
+            for (int s = 0; s < count; ++s) {
+                if (!visited[successors[s]]) feasible.push_back(successors[s]);
+            }
+            if (!feasible.empty()) city = feasible[rng() % feasible.size()];
+        }
+
+        if (city == -1) {
+            do {
+                city = static_cast<int>(rng() % size); // Pick a random city
+            } while (visited[city] || city == 0); // Ensure it's not visited and not city 0
+        }
 
         currentPath[i] = city;
         visited[city] = true; // Mark as visited
     }
     currentPath[size] = 0; // End at city 0
+    for (int i = 0; i < size; ++i) {
+        position[currentPath[i]] = i;
+    }
 
     // Print the initial path
-    std::cout << "\nInitial Path: ";
-    for (int i = 0; i <= size; i++) {
-        std::cout << currentPath[i] << " ";
+    if (LOG_DEBUG_ENABLED()) {
+        std::ostringstream initialPath;
+        for (int i = 0; i <= size; i++) {
+            initialPath << currentPath[i] << " ";
+        }
+        LOG_DEBUG("Initial Path: " << initialPath.str());
     }
-    std::cout << std::endl;
 
     initializeTabuList();
 }
@@ -38,6 +68,7 @@ TabuSearch::TabuSearch(const Matrix& matrix, int tabuListSize, int maxIterations
 TabuSearch::~TabuSearch() {
     delete[] bestPath;
     delete[] currentPath;
+    delete[] position;
     for (int i = 0; i < tabuListSize; i++) {
         delete[] tabuList[i];
     }
@@ -45,8 +76,8 @@ TabuSearch::~TabuSearch() {
 }
 
 void TabuSearch::initializeTabuList() {
-    std::cout<< "Iterations number: "<< maxIterations << std::endl;
-    std::cout<< "Tabu List Size: "<< tabuListSize << std::endl;
+    LOG_INFO("Iterations number: " << maxIterations);
+    LOG_INFO("Tabu List Size: " << tabuListSize);
     tabuList = new int*[tabuListSize];
     for (int i = 0; i < tabuListSize; i++) {
         tabuList[i] = new int[2];  // Each move is represented by two integers (i, j)
@@ -56,6 +87,7 @@ void TabuSearch::initializeTabuList() {
 }
 
 bool TabuSearch::isTabu(int i, int j) {
+    PHASE_TIMER(Phase::TabuCheck);
     for (int k = 0; k < tabuListSize; k++) {
         if ((tabuList[k][0] == i && tabuList[k][1] == j) || (tabuList[k][0] == j && tabuList[k][1] == i)) {
             return true;
@@ -82,76 +114,320 @@ void TabuSearch::swapCities(int* path, int i, int j) {
     path[j] = temp;
 }
 
-int TabuSearch::calculateCost(const int* path) {
-    int totalCost = 0;
+long long TabuSearch::calculateCost(const int* path) {
+    long long totalCost = 0;  // 64-bit so that forbidden-edge sentinels cannot overflow
     for (int i = 0; i < size; i++) {
         totalCost += matrix.getCost(path[i], path[i + 1]);  // Use getCost method from Matrix
     }
     return totalCost;
 }
 
+long long TabuSearch::swapDelta(const int* path, int i, int j) const {
+    if (i == 0 || i == size || j == 0 || j == size || i == j) {
+        return 0;  // swapCities leaves the path unchanged
+    }
+    if (i > j) std::swap(i, j);
+
+    int a = path[i - 1], b = path[i], c = path[i + 1];
+    int d = path[j - 1], e = path[j], f = path[j + 1];
+
+    if (j == i + 1) {
+        // Adjacent positions: a b e f -> a e b f
+        return (long long)matrix.getCost(a, e) + matrix.getCost(e, b) + matrix.getCost(b, f)
+             - matrix.getCost(a, b) - matrix.getCost(b, e) - matrix.getCost(e, f);
+    }
+    // a b c ... d e f -> a e c ... d b f
+    return (long long)matrix.getCost(a, e) + matrix.getCost(e, c) + matrix.getCost(d, b) + matrix.getCost(b, f)
+         - matrix.getCost(a, b) - matrix.getCost(b, c) - matrix.getCost(d, e) - matrix.getCost(e, f);
+}
+
+long long TabuSearch::reversalDelta(const int* path, int i, int j) const {
+    if (i == 0 || i == size || j == 0 || j == size || i == j) {
+        return 0;  // The start and end positions are fixed
+    }
+    if (i > j) std::swap(i, j);
+
+    // a b ... e f -> a e ... b f; inner edges keep their cost because the matrix is symmetric
+    int a = path[i - 1], b = path[i];
+    int e = path[j], f = path[j + 1];
+    return (long long)matrix.getCost(a, e) + matrix.getCost(b, f) - matrix.getCost(a, b) - matrix.getCost(e, f);
+}
+
+bool TabuSearch::createsForbiddenEdge(const int* path, int i, int j) const {
+    if (i == 0 || i == size || j == 0 || j == size || i == j) {
+        return false;
+    }
+    if (i > j) std::swap(i, j);
+
+    int a = path[i - 1], b = path[i], c = path[i + 1];
+    int e = path[j], f = path[j + 1];
+
+    if (useReversal) {
+        // Inner edges are only reversed, which keeps them allowed on symmetric instances
+        return matrix.isForbidden(a, e) || matrix.isForbidden(b, f);
+    }
+    if (j == i + 1) {
+        return matrix.isForbidden(a, e) || matrix.isForbidden(e, b) || matrix.isForbidden(b, f);
+    }
+    int d = path[j - 1];
+    return matrix.isForbidden(a, e) || matrix.isForbidden(e, c) || matrix.isForbidden(d, b) || matrix.isForbidden(b, f);
+}
+
+void TabuSearch::evaluateMove(int i, int j, long long currentCost, long long& bestNeighborCost, int* bestMove) {
+    // Skip infeasible moves on sparse instances before scoring them
+    if (matrix.hasForbiddenEdges() && createsForbiddenEdge(currentPath, i, j)) {
+        return;
+    }
+
+    ++counters.movesEvaluated;
+    long long delta = useReversal ? reversalDelta(currentPath, i, j) : swapDelta(currentPath, i, j);
+    long long neighborCost = currentCost + delta;
+
+    // Check tabu status or aspiration criteria
+    if (isTabu(i, j) && neighborCost >= bestCost) {
+        ++counters.tabuRejected;
+        return;
+    }
+
+    // Update the best neighbor
+    if (neighborCost < bestNeighborCost) {
+        bestNeighborCost = neighborCost;
+        bestMove[0] = i;
+        bestMove[1] = j;
+    }
+}
+
+void TabuSearch::applyMove(int i, int j) {
+    if (!useReversal) {
+        swapCities(currentPath, i, j);
+        position[currentPath[i]] = i;
+        position[currentPath[j]] = j;
+        return;
+    }
+    if (i == 0 || i == size || j == 0 || j == size) {
+        return;  // Do not move the start or end positions
+    }
+    if (i > j) std::swap(i, j);
+    std::reverse(currentPath + i, currentPath + j + 1);
+    for (int k = i; k <= j; ++k) {
+        position[currentPath[k]] = k;
+    }
+}
+
 const int* TabuSearch::runTabuSearch() {
-    int currentCost = calculateCost(currentPath);
+    long long currentCost = calculateCost(currentPath);
     bestCost = currentCost;
     memcpy(bestPath, currentPath, (size + 1) * sizeof(int));  // Copy initial path
 
-    int iterations = 0;
-    while (iterations < maxIterations) {
-        int bestNeighborCost = INT_MAX;
-        int bestSwap[2] = {-1, -1};
+    const CandidateLists* candidates = matrix.getCandidateLists();
 
-        int sampleSize = size * (size - 1) / 3;  // Define the neighborhood size
+    int iterations = 0;
+    stopped = false;
+    counters = SearchCounters();
+    std::string checkpointPath;
+    if (checkpointer != nullptr) {
+        checkpointPath = checkpointer->pathFor("tabu", matrix, checkpointRun);
+        if (loadCheckpoint(checkpointPath, iterations, currentCost)) {
+            LOG_INFO("Resuming tabu search from iteration " << iterations);
+        }
+        lastCheckpoint = std::chrono::steady_clock::now();
+    }
 
-        for (int k = 0; k < sampleSize; k++) {
-            int i = rand() % size;
-            int j = rand() % size;
-            if (i == j) continue;  // Avoid swapping the same city
+    while (iterations < maxIterations) {
+        long long bestNeighborCost = LLONG_MAX;
+        int bestMove[2] = {-1, -1};
 
-            // Evaluate the neighbor
-            swapCities(currentPath, i, j);
-            int neighborCost = calculateCost(currentPath);
+        {
+            PHASE_TIMER(Phase::TabuNeighbourhood);
+            if (candidates != nullptr) {
+                // Restricted neighbourhood: bring one of the k nearest successors of each city next to it
+                int k = candidates->getK();
+                for (int i = 0; i < size - 1; ++i) {
+                    const int* successors = candidates->getSuccessors(currentPath[i]);
+                    for (int c = 0; c < k; ++c) {
+                        int target = position[successors[c]];
+                        if (target == 0 || target == i + 1) continue;  // City 0 is fixed, or already adjacent
+                        if (!useReversal) {
+                            evaluateMove(i + 1, target, currentCost, bestNeighborCost, bestMove);
+                        } else if (target > i + 1) {
+                            evaluateMove(i + 1, target, currentCost, bestNeighborCost, bestMove);
+                        } else if (target < i - 1) {
+                            evaluateMove(target, i - 1, currentCost, bestNeighborCost, bestMove);  // Makes the pair adjacent in reverse
+                        }
+                    }
+                }
+            } else {
+                int sampleSize = size * (size - 1) / 3;  // Define the neighborhood size
 
-            // Check tabu status or aspiration criteria
-            if (isTabu(i, j) && neighborCost >= bestCost) {
-                swapCities(currentPath, i, j);  // Undo the swap
-                continue;
-            }
+                for (int k = 0; k < sampleSize; k++) {
+                    int i = static_cast<int>(rng() % size);
+                    int j = static_cast<int>(rng() % size);
+                    if (i == j) continue;  // Avoid swapping the same city
 
-            // Update the best neighbor
-            if (neighborCost < bestNeighborCost) {
-                bestNeighborCost = neighborCost;
-                bestSwap[0] = i;
-                bestSwap[1] = j;
+                    evaluateMove(i, j, currentCost, bestNeighborCost, bestMove);
+                }
             }
-            swapCities(currentPath, i, j);  // Undo the swap
         }
 
-        // Apply the best swap if one was found
-        if (bestSwap[0] != -1 && bestSwap[1] != -1) {
-            swapCities(currentPath, bestSwap[0], bestSwap[1]);
-            updateTabuList(bestSwap[0], bestSwap[1]);
+        // Apply the best move if one was found
+        if (bestMove[0] != -1 && bestMove[1] != -1) {
+            applyMove(bestMove[0], bestMove[1]);
+            updateTabuList(bestMove[0], bestMove[1]);
             currentCost = bestNeighborCost;
 
             // Update the global best solution
             if (currentCost < bestCost) {
                 bestCost = currentCost;
                 memcpy(bestPath, currentPath, (size + 1) * sizeof(int));  // Update best path
+                if (incumbent != nullptr) {
+                    incumbent->offer(Matrix::saturateCost(bestCost), std::vector<int>(bestPath, bestPath + size), "tabu");
+                }
             }
         }
 
         iterations++;
+
+        if (iterations < maxIterations &&
+            (std::chrono::steady_clock::now() >= deadline || (incumbent != nullptr && incumbent->shouldStop()))) {
+            stopped = true;
+            if (checkpointer != nullptr) {
+                saveCheckpoint(checkpointPath, iterations, currentCost); // Lets a later run continue from here
+            }
+            break;
+        }
+        if (checkpointer != nullptr && checkpointer->due(lastCheckpoint)) {
+            saveCheckpoint(checkpointPath, iterations, currentCost);
+        }
     }
+    completedIterations = iterations;
+    if (checkpointer != nullptr && !stopped) {
+        checkpointer->remove(checkpointPath); // The run is complete
+    }
+    Logger::instance().flush(); // The caller prints the result directly
 
     return bestPath;
 }
 
+void TabuSearch::setCheckpointer(Checkpointer* checkpointer, const std::string& run) {
+    this->checkpointer = checkpointer;
+    this->checkpointRun = run;
+}
+
+void TabuSearch::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+}
+
+void TabuSearch::setInitialPath(const std::vector<int>& tour) {
+    if (static_cast<int>(tour.size()) != size) {
+        throw std::invalid_argument("Initial tabu search path has the wrong length");
+    }
+    std::vector<bool> seen(size, false);
+    int startIndex = 0;
+    for (int k = 0; k < size; ++k) {
+        if (tour[k] < 0 || tour[k] >= size || seen[tour[k]]) {
+            throw std::invalid_argument("Initial tabu search path is not a permutation of the cities");
+        }
+        seen[tour[k]] = true;
+        if (tour[k] == 0) startIndex = k;
+    }
+
+    // Rotate so that the path starts and ends at city 0 like the random one
+    for (int k = 0; k < size; ++k) {
+        currentPath[k] = tour[(startIndex + k) % size];
+        position[currentPath[k]] = k;
+    }
+    currentPath[size] = 0;
+}
+
+void TabuSearch::setIncumbent(SharedIncumbent* incumbent) {
+    this->incumbent = incumbent;
+}
+
+bool TabuSearch::isStopped() const {
+    return stopped;
+}
+
+int TabuSearch::getIterationCount() const {
+    return completedIterations;
+}
+
+const SearchCounters& TabuSearch::getSearchCounters() const {
+    return counters;
+}
+
+std::string TabuSearch::checkpointParameters() const {
+    return "tabuSize=" + std::to_string(tabuListSize) + ";maxIterations=" + std::to_string(maxIterations) +
+           ";reversal=" + std::to_string(useReversal);
+}
+
+void TabuSearch::saveCheckpoint(const std::string& path, int iterations, long long currentCost) {
+    CheckpointBuffer buffer;
+    buffer.putString("tabu");
+    buffer.putString(matrix.getFingerprint());
+    buffer.putParameters(checkpointParameters());
+    buffer.putInt(iterations);
+    buffer.putLong(currentCost);
+    buffer.putLong(bestCost);
+    buffer.putRng(rng);
+    buffer.putInts(currentPath, size + 1);
+    buffer.putInts(bestPath, size + 1);
+    for (int k = 0; k < tabuListSize; ++k) {
+        buffer.putInts(tabuList[k], 2);
+    }
+    checkpointer->save(path, buffer);
+}
+
+bool TabuSearch::loadCheckpoint(const std::string& path, int& iterations, long long& currentCost) {
+    CheckpointBuffer buffer;
+    if (!checkpointer->load(path, buffer)) {
+        return false;
+    }
+    try {
+        if (buffer.getString() != "tabu" || buffer.getString() != matrix.getFingerprint() ||
+            !buffer.matchesParameters(checkpointParameters())) {
+            LOG_WARNING("checkpoint " << path << " was written with a different configuration, starting over");
+            return false;
+        }
+        int savedIterations = buffer.getInt();
+        long long savedCurrentCost = buffer.getLong();
+        long long savedBestCost = buffer.getLong();
+        std::mt19937 savedRng;
+        buffer.getRng(savedRng);
+        std::vector<int> paths(2 * (size + 1));
+        std::vector<int> moves(2 * tabuListSize);
+        buffer.getInts(paths.data(), 2 * (size + 1));
+        if (tabuListSize > 0) {
+            buffer.getInts(moves.data(), 2 * tabuListSize);
+        }
+
+        // Only commit once everything was read
+        iterations = savedIterations;
+        currentCost = savedCurrentCost;
+        bestCost = savedBestCost;
+        rng = savedRng;
+        std::copy(paths.begin(), paths.begin() + size + 1, currentPath);
+        std::copy(paths.begin() + size + 1, paths.end(), bestPath);
+        for (int k = 0; k < tabuListSize; ++k) {
+            tabuList[k][0] = moves[2 * k];
+            tabuList[k][1] = moves[2 * k + 1];
+        }
+        for (int i = 0; i < size; ++i) {
+            position[currentPath[i]] = i;
+        }
+        return true;
+    } catch (const std::runtime_error& e) {
+        LOG_WARNING("ignoring checkpoint " << path << ": " << e.what());
+        return false;
+    }
+}
+
 
 const int* TabuSearch::getBestPath() const {
     return bestPath;
 }
 
 int TabuSearch::getBestCost() const {
-    return bestCost;
+    return Matrix::saturateCost(bestCost);
 }
 
 void TabuSearch::printSolutionTabu() const {
@@ -163,3 +439,54 @@ void TabuSearch::printSolutionTabu() const {
 
     std::cout << "Best Cost: " << bestCost << std::endl;
 }
+
+
+/**
+ * @class TabuSearchSolver
+ * @brief ISolver adapter of TabuSearch, registered as "tabu".
+ *
+ * Parameters: "tabuSize" (default 10), "maxIterations" (default 1000), "initialTour" (optional start
+ * tour instead of a random one) and "profiles" (tuned values per size class, see sizeProfile()).
+ */
+class TabuSearchSolver : public ISolver {
+public:
+    std::string name() const override { return "tabu"; }
+    std::string description() const override { return "Tabu Search"; }
+    bool isExact() const override { return false; }
+
+    SolveResult solve(const SolveRequest& request) override {
+        const Matrix& matrix = requireMatrix(request);
+        nlohmann::json profile = sizeProfile(request.parameters, matrix.getSize());
+        int tabuSize = profile.value("tabuSize", request.parameters.value("tabuSize", 10));
+        int maxIterations = profile.value("maxIterations", request.parameters.value("maxIterations", 1000));
+        if (tabuSize < 1 || maxIterations < 0) {
+            throw std::invalid_argument("Tabu Search needs tabuSize >= 1 and maxIterations >= 0");
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        TabuSearch tabu(matrix, tabuSize, maxIterations, seedFor(request));
+        tabu.setCheckpointer(request.checkpointer, request.run);
+        tabu.setDeadline(request.deadline);
+        tabu.setIncumbent(request.incumbent);
+        if (request.parameters.contains("initialTour")) {
+            tabu.setInitialPath(request.parameters.at("initialTour").get<std::vector<int>>());
+        }
+
+        SolveResult result;
+        result.solver = name();
+        result.parameters = {{"tabuSize", tabuSize}, {"maxIterations", maxIterations}};
+        result.timings.setupMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        tabu.runTabuSearch();
+        result.timings.solveMs = millisecondsSince(start);
+
+        result.cost = tabu.getBestCost();
+        result.tour.assign(tabu.getBestPath(), tabu.getBestPath() + matrix.getSize());
+        result.timedOut = tabu.isStopped();
+        result.stats["iterations"] = static_cast<unsigned long long>(tabu.getIterationCount());
+        tabu.getSearchCounters().writeTo(result.stats);
+        return result;
+    }
+};
+
+REGISTER_SOLVER(TabuSearchSolver, "tabu");
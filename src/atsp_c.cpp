@@ -0,0 +1,260 @@
+#include "../include/atsp_c.h"
+#include "../include/Algorithms/HeldKarpBatch.h"
+#include "../include/Algorithms/Solver.h"
+#include "../include/matrix.h"
+
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct atsp_matrix {
+    Matrix matrix{0};        ///< The instance.
+    std::string fingerprint; ///< Kept for atsp_matrix_fingerprint().
+};
+
+struct atsp_result {
+    SolveResult result; ///< The solver's result.
+    std::string json;   ///< Kept for atsp_result_json().
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+/**
+ * @brief Runs the body of an interface function, turning exceptions into a status and atsp_last_error().
+ */
+template <typename Body>
+atsp_status guarded(Body body) {
+    lastError.clear();
+    try {
+        body();
+        return ATSP_OK;
+    } catch (const std::invalid_argument& e) {
+        lastError = e.what();
+        return ATSP_ERROR_INVALID_ARGUMENT;
+    } catch (const nlohmann::json::exception& e) {
+        lastError = e.what();
+        return ATSP_ERROR_INVALID_ARGUMENT;
+    } catch (const std::bad_alloc&) {
+        lastError = "Out of memory";
+        return ATSP_ERROR_OUT_OF_MEMORY;
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return ATSP_ERROR_INTERNAL;
+    } catch (...) {
+        lastError = "Unknown error";
+        return ATSP_ERROR_INTERNAL;
+    }
+}
+
+void requireMatrix(const atsp_matrix* matrix) {
+    if (matrix == nullptr) {
+        throw std::invalid_argument("Matrix handle is null");
+    }
+}
+
+void requireCosts(const int32_t* costs, int32_t size, atsp_matrix** out) {
+    if (costs == nullptr || out == nullptr) {
+        throw std::invalid_argument("Costs and output handle must not be null");
+    }
+    if (size <= 0 || size > 46340) {
+        throw std::invalid_argument("Matrix size must be between 1 and 46340");
+    }
+}
+
+/**
+ * @brief Registry names, built once; the registry does not change after static initialization.
+ */
+const std::vector<std::string>& solverNames() {
+    static const std::vector<std::string> names = SolverRegistry::instance().names();
+    return names;
+}
+
+} // namespace
+
+uint32_t atsp_abi_version(void) {
+    return ATSP_C_ABI_VERSION;
+}
+
+const char* atsp_last_error(void) {
+    return lastError.c_str();
+}
+
+atsp_status atsp_matrix_create_view(const int32_t* costs, int32_t size, atsp_matrix** out) {
+    return guarded([&] {
+        requireCosts(costs, size, out);
+        std::unique_ptr<atsp_matrix> handle(new atsp_matrix());
+        handle->matrix.setView(size, costs, nullptr);
+        handle->fingerprint = handle->matrix.getFingerprint();
+        *out = handle.release();
+    });
+}
+
+atsp_status atsp_matrix_create_copy(const int32_t* costs, int32_t size, atsp_matrix** out) {
+    return guarded([&] {
+        requireCosts(costs, size, out);
+        std::unique_ptr<atsp_matrix> handle(new atsp_matrix());
+        handle->matrix.setCosts(size, std::vector<int>(costs, costs + static_cast<size_t>(size) * size));
+        handle->fingerprint = handle->matrix.getFingerprint();
+        *out = handle.release();
+    });
+}
+
+atsp_status atsp_matrix_load(const char* path, atsp_matrix** out) {
+    atsp_status status = guarded([&] {
+        if (path == nullptr || out == nullptr) {
+            throw std::invalid_argument("Path and output handle must not be null");
+        }
+        std::unique_ptr<atsp_matrix> handle(new atsp_matrix());
+        handle->matrix.readFromFile(path);
+        handle->fingerprint = handle->matrix.getFingerprint();
+        *out = handle.release();
+    });
+    return status == ATSP_ERROR_INTERNAL ? ATSP_ERROR_IO : status; // readFromFile reports every failure as runtime_error
+}
+
+atsp_status atsp_matrix_prepare(atsp_matrix* matrix, int32_t candidate_list_size) {
+    return guarded([&] {
+        requireMatrix(matrix);
+        if (candidate_list_size < 0) {
+            throw std::invalid_argument("Candidate list size must not be negative");
+        }
+        matrix->matrix.buildTransposed();
+        if (candidate_list_size > 0) {
+            matrix->matrix.buildCandidateLists(candidate_list_size);
+        }
+    });
+}
+
+int32_t atsp_matrix_size(const atsp_matrix* matrix) {
+    return matrix == nullptr ? 0 : matrix->matrix.getSize();
+}
+
+const char* atsp_matrix_fingerprint(const atsp_matrix* matrix) {
+    return matrix == nullptr ? "" : matrix->fingerprint.c_str();
+}
+
+void atsp_matrix_destroy(atsp_matrix* matrix) {
+    delete matrix;
+}
+
+size_t atsp_solver_count(void) {
+    return solverNames().size();
+}
+
+const char* atsp_solver_name(size_t index) {
+    return index < solverNames().size() ? solverNames()[index].c_str() : nullptr;
+}
+
+atsp_status atsp_solve(const atsp_matrix* matrix, const char* solver, const char* parameters_json, double time_limit_seconds,
+                       uint32_t seed, atsp_progress_callback progress, void* user, atsp_result** out) {
+    lastError.clear();
+    if (solver == nullptr || !SolverRegistry::instance().contains(solver)) {
+        lastError = std::string("Unknown solver '") + (solver == nullptr ? "" : solver) + "'";
+        return ATSP_ERROR_UNKNOWN_SOLVER;
+    }
+    return guarded([&] {
+        requireMatrix(matrix);
+        if (out == nullptr) {
+            throw std::invalid_argument("Output handle must not be null");
+        }
+        if (!(time_limit_seconds >= 0)) {
+            throw std::invalid_argument("Time limit must not be negative");
+        }
+
+        SolveRequest request;
+        request.matrix = &matrix->matrix;
+        if (parameters_json != nullptr) {
+            request.parameters = nlohmann::json::parse(parameters_json);
+            if (!request.parameters.is_object()) {
+                throw std::invalid_argument("Solver parameters must be a JSON object");
+            }
+        }
+        if (time_limit_seconds > 0 && time_limit_seconds < 1e9) {
+            request.deadline = std::chrono::steady_clock::now() +
+                               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_limit_seconds));
+        }
+        request.seed = seed;
+
+        SharedIncumbent incumbent;
+        if (progress != nullptr) {
+            incumbent.setListener([&](int cost, const std::vector<int>& tour, const std::string& name) {
+                std::vector<int32_t> cities(tour.begin(), tour.end());
+                if (progress(cost, cities.data(), static_cast<int32_t>(cities.size()), name.c_str(), user) != 0) {
+                    incumbent.cancel();
+                }
+            });
+        }
+        request.incumbent = &incumbent;
+
+        std::unique_ptr<atsp_result> handle(new atsp_result());
+        handle->result = SolverRegistry::instance().create(solver)->solve(request);
+        const SolveResult& result = handle->result;
+        nlohmann::json json = {
+            {"solver", result.solver},
+            {"fingerprint", matrix->fingerprint},
+            {"size", matrix->matrix.getSize()},
+            {"cost", result.cost == INT_MAX ? nlohmann::json() : nlohmann::json(result.cost)},
+            {"tour", result.tour},
+            {"bound", result.bound},
+            {"optimal", result.optimal},
+            {"timedOut", result.timedOut},
+            {"parameters", result.parameters},
+            {"stats", result.stats},
+            {"setupMs", result.timings.setupMs},
+            {"solveMs", result.timings.solveMs},
+        };
+        handle->json = json.dump();
+        *out = handle.release();
+    });
+}
+
+atsp_status atsp_solve_batch(const int32_t* costs, int32_t size, size_t count, int32_t* tour_costs, int32_t* tours, int32_t threads) {
+    return guarded([&] {
+        if (count > 0 && (costs == nullptr || tour_costs == nullptr)) {
+            throw std::invalid_argument("Costs and tour costs must not be null");
+        }
+        solveBatch(costs, size, count, tour_costs, tours, threads);
+    });
+}
+
+int32_t atsp_result_cost(const atsp_result* result) {
+    return result == nullptr ? INT32_MAX : result->result.cost;
+}
+
+int32_t atsp_result_tour(const atsp_result* result, int32_t* tour, int32_t capacity) {
+    if (result == nullptr) {
+        return 0;
+    }
+    const std::vector<int>& cities = result->result.tour;
+    for (int32_t i = 0; tour != nullptr && i < capacity && i < static_cast<int32_t>(cities.size()); ++i) {
+        tour[i] = cities[i];
+    }
+    return static_cast<int32_t>(cities.size());
+}
+
+int32_t atsp_result_bound(const atsp_result* result) {
+    return result == nullptr ? 0 : result->result.bound;
+}
+
+int atsp_result_optimal(const atsp_result* result) {
+    return result != nullptr && result->result.optimal ? 1 : 0;
+}
+
+int atsp_result_timed_out(const atsp_result* result) {
+    return result != nullptr && result->result.timedOut ? 1 : 0;
+}
+
+double atsp_result_solve_ms(const atsp_result* result) {
+    return result == nullptr ? 0 : result->result.timings.solveMs;
+}
+
+const char* atsp_result_json(const atsp_result* result) {
+    return result == nullptr ? "" : result->json.c_str();
+}
+
+void atsp_result_destroy(atsp_result* result) {
+    delete result;
+}
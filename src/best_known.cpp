@@ -0,0 +1,29 @@
+#include "../include/best_known.h"
+
+#include <map>
+
+namespace {
+
+// TSPLIB ATSP optima as published with the library (all proven optimal)
+const std::map<std::string, int> BEST_KNOWN = {
+    {"br17", 39},      {"ft53", 6905},     {"ft70", 38673},   {"ftv33", 1286},   {"ftv35", 1473},
+    {"ftv38", 1530},   {"ftv44", 1613},    {"ftv47", 1776},   {"ftv55", 1608},   {"ftv64", 1839},
+    {"ftv70", 1950},   {"ftv170", 2755},   {"kro124p", 36230}, {"p43", 5620},    {"rbg323", 1326},
+    {"rbg358", 1163},  {"rbg403", 2465},   {"rbg443", 2720},  {"ry48p", 14422},
+};
+
+} // namespace
+
+std::string instanceName(const std::string& path) {
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    return name.substr(0, name.find('.'));
+}
+
+int bestKnownCost(const std::string& instance) {
+    auto it = BEST_KNOWN.find(instanceName(instance));
+    return it == BEST_KNOWN.end() ? -1 : it->second;
+}
+
+double gapPercent(long long cost, int bestKnown) {
+    return bestKnown > 0 ? 100.0 * static_cast<double>(cost - bestKnown) / bestKnown : 0.0;
+}
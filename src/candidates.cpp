@@ -0,0 +1,88 @@
+#include "../include/candidates.h"
+#include "../include/matrix.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+CandidateLists::CandidateLists(const Matrix& matrix, int k)
+    : size(matrix.getSize()), k(std::max(0, std::min(k, matrix.getSize() - 1))),
+      successors(nullptr), predecessors(nullptr) {
+    successors = new int[size * this->k];
+    predecessors = new int[size * this->k];
+    if (this->k == 0) {
+        return;
+    }
+
+    // Split the cities between the available hardware threads; each city is sorted independently
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min(numThreads, size / 64 + 1));
+
+    std::vector<std::thread> workers;
+    int chunk = (size + numThreads - 1) / numThreads;
+    for (int t = 0; t < numThreads; ++t) {
+        int first = t * chunk;
+        int last = std::min(size, first + chunk);
+        if (first >= last) break;
+        workers.emplace_back(&CandidateLists::buildRange, this, std::cref(matrix), first, last);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+CandidateLists::~CandidateLists() {
+    delete[] successors;
+    delete[] predecessors;
+}
+
+void CandidateLists::buildRange(const Matrix& matrix, int first, int last) {
+    std::vector<int> order(size - 1);
+    std::vector<int> costs(size);
+
+    // Candidates are every other city, cheapest first; ties broken by city index for determinism
+    auto selectCheapest = [&](int city, int* out) {
+        int index = 0;
+        for (int j = 0; j < size; ++j) {
+            if (j != city) order[index++] = j;
+        }
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&costs](int a, int b) {
+            return costs[a] < costs[b] || (costs[a] == costs[b] && a < b);
+        });
+        std::copy(order.begin(), order.begin() + k, out);
+    };
+
+    for (int city = first; city < last; ++city) {
+        // k cheapest outgoing edges
+        const int* row = matrix.getRow(city);
+        for (int j = 0; j < size; ++j) {
+            costs[j] = row != nullptr ? row[j] : matrix.getCost(city, j);
+        }
+        selectCheapest(city, successors + city * k);
+
+        // Incoming edges equal outgoing ones on symmetric instances
+        if (matrix.isSymmetric()) {
+            std::copy(successors + city * k, successors + (city + 1) * k, predecessors + city * k);
+            continue;
+        }
+
+        // k cheapest incoming edges, read from the transposed copy when it exists
+        const int* column = matrix.getColumn(city);
+        for (int j = 0; j < size; ++j) {
+            costs[j] = column != nullptr ? column[j] : matrix.getCost(j, city);
+        }
+        selectCheapest(city, predecessors + city * k);
+    }
+}
+
+const int* CandidateLists::getSuccessors(int city) const {
+    return successors + city * k;
+}
+
+const int* CandidateLists::getPredecessors(int city) const {
+    return predecessors + city * k;
+}
+
+int CandidateLists::getK() const {
+    return k;
+}
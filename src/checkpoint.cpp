@@ -0,0 +1,293 @@
+#include "../include/checkpoint.h"
+#include "../include/matrix.h"
+#include "../include/logger.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#define ATSP_GETPID() _getpid()
+#else
+#include <signal.h>
+#include <unistd.h>
+#define ATSP_GETPID() getpid()
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'A', 'T', 'S', 'P', 'C', 'K', 'P', '1'};
+
+// FNV-1a checksum of the payload, detects truncated or corrupted files
+unsigned long long checksum(const std::vector<char>& payload) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (char c : payload) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const std::string TEMPORARY_INFIX = ".ckpt.tmp.";
+
+// A temporary older than this is stale even if its pid looks alive (the pid may have been reused)
+const std::chrono::hours STALE_TEMPORARY_AGE(24);
+
+// Whether the process that named a temporary still runs; unknown (always true) without kill()
+bool processAlive(long pid) {
+#ifdef _WIN32
+    (void) pid;
+    return true;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+} // namespace
+
+void CheckpointBuffer::put(const void* value, size_t length) {
+    const char* bytes = static_cast<const char*>(value);
+    data.insert(data.end(), bytes, bytes + length);
+}
+
+void CheckpointBuffer::get(void* value, size_t length) {
+    if (data.size() - readOffset < length) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    std::memcpy(value, data.data() + readOffset, length);
+    readOffset += length;
+}
+
+void CheckpointBuffer::putInt(int value) {
+    put(&value, sizeof(value));
+}
+
+void CheckpointBuffer::putLong(long long value) {
+    put(&value, sizeof(value));
+}
+
+void CheckpointBuffer::putInts(const int* values, int count) {
+    put(values, count * sizeof(int));
+}
+
+void CheckpointBuffer::putString(const std::string& value) {
+    putInt(static_cast<int>(value.size()));
+    put(value.data(), value.size());
+}
+
+void CheckpointBuffer::putRng(const std::mt19937& rng) {
+    std::ostringstream state;
+    state << rng; // The standard textual form round-trips the full engine state
+    putString(state.str());
+}
+
+void CheckpointBuffer::putParameters(const std::string& parameters) {
+    putLong(static_cast<long long>(checksum(std::vector<char>(parameters.begin(), parameters.end()))));
+}
+
+int CheckpointBuffer::getInt() {
+    int value;
+    get(&value, sizeof(value));
+    return value;
+}
+
+long long CheckpointBuffer::getLong() {
+    long long value;
+    get(&value, sizeof(value));
+    return value;
+}
+
+void CheckpointBuffer::getInts(int* values, int count) {
+    get(values, count * sizeof(int));
+}
+
+std::string CheckpointBuffer::getString() {
+    int length = getInt();
+    if (length < 0 || data.size() - readOffset < static_cast<size_t>(length)) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    std::string value(data.data() + readOffset, length);
+    readOffset += length;
+    return value;
+}
+
+bool CheckpointBuffer::matchesParameters(const std::string& parameters) {
+    return static_cast<unsigned long long>(getLong()) == checksum(std::vector<char>(parameters.begin(), parameters.end()));
+}
+
+void CheckpointBuffer::getRng(std::mt19937& rng) {
+    std::istringstream state(getString());
+    state >> rng;
+    if (!state) {
+        throw std::runtime_error("Checkpoint holds an invalid random engine state");
+    }
+}
+
+
+Checkpointer::Checkpointer(const std::string& directory, double intervalSeconds, bool resume)
+    : directory(directory),
+      interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(intervalSeconds))),
+      resume(resume) {
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error || !fs::is_directory(directory)) {
+        throw std::runtime_error("Could not create checkpoint directory: " + directory);
+    }
+    removeStaleTemporaries();
+    worker = std::thread(&Checkpointer::run, this);
+}
+
+Checkpointer::~Checkpointer() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    worker.join();
+}
+
+std::string Checkpointer::pathFor(const std::string& solver, const Matrix& matrix, const std::string& run) const {
+    std::string name = solver + "-" + matrix.getFingerprint() + (run.empty() ? "" : "-" + run);
+    return (fs::path(directory) / (name + ".ckpt")).string();
+}
+
+bool Checkpointer::due(std::chrono::steady_clock::time_point& lastSave) const {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - lastSave < interval) {
+        return false;
+    }
+    lastSave = now;
+    return true;
+}
+
+void Checkpointer::save(const std::string& path, CheckpointBuffer& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending[path] = std::move(buffer.bytes()); // Replaces an older snapshot that was not written yet
+    }
+    wakeUp.notify_one();
+}
+
+bool Checkpointer::load(const std::string& path, CheckpointBuffer& buffer) const {
+    if (!resume) {
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    unsigned long long length = 0, expected = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    file.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+    if (!file || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 || length > (1ULL << 40)) {
+        LOG_WARNING("ignoring invalid checkpoint " << path);
+        return false;
+    }
+
+    std::vector<char> payload(length);
+    file.read(payload.data(), static_cast<std::streamsize>(length));
+    if (!file || checksum(payload) != expected) {
+        LOG_WARNING("ignoring corrupted checkpoint " << path);
+        return false;
+    }
+    buffer = CheckpointBuffer();
+    buffer.bytes() = std::move(payload);
+    return true;
+}
+
+void Checkpointer::remove(const std::string& path) {
+    // Same lock order as the writer thread, so a snapshot taken off the queue is never written after this
+    std::lock_guard<std::mutex> io(ioMutex);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.erase(path);
+    }
+    std::error_code error;
+    fs::remove(path, error);
+}
+
+void Checkpointer::removeStaleTemporaries() {
+    // A crash between writing and renaming leaves the temporary behind; the checkpoint itself stays valid.
+    // Other processes may share the directory, so only temporaries of dead processes or old ones are removed.
+    long self = static_cast<long>(ATSP_GETPID());
+    fs::file_time_type now = fs::file_time_type::clock::now();
+    std::error_code error;
+    for (fs::directory_iterator entry(directory, error), end; !error && entry != end; entry.increment(error)) {
+        std::string name = entry->path().filename().string();
+        size_t infix = name.rfind(TEMPORARY_INFIX);
+        if (infix == std::string::npos) {
+            continue;
+        }
+        char* rest = nullptr;
+        long owner = std::strtol(name.c_str() + infix + TEMPORARY_INFIX.size(), &rest, 10);
+        std::error_code ignored;
+        fs::file_time_type modified = fs::last_write_time(entry->path(), ignored);
+        bool dead = *rest == '\0' && owner > 0 && owner != self && !processAlive(owner);
+        if (dead || (!ignored && now - modified > STALE_TEMPORARY_AGE)) {
+            fs::remove(entry->path(), ignored);
+        }
+    }
+}
+
+void Checkpointer::run() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return; // Stopping and everything written
+            }
+        }
+
+        std::lock_guard<std::mutex> io(ioMutex);
+        std::string path;
+        std::vector<char> payload;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (pending.empty()) {
+                continue; // Removed in the meantime
+            }
+            path = pending.begin()->first;
+            payload = std::move(pending.begin()->second);
+            pending.erase(pending.begin());
+        }
+        writeFile(path, payload);
+    }
+}
+
+void Checkpointer::writeFile(const std::string& path, const std::vector<char>& payload) {
+    std::string temporary = path + ".tmp." + std::to_string(ATSP_GETPID()); // Unique per process sharing the directory
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        unsigned long long length = payload.size(), sum = checksum(payload);
+        file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        file.close();
+        if (!file) {
+            LOG_WARNING("could not write checkpoint " << temporary);
+            std::error_code ignored;
+            fs::remove(temporary, ignored);
+            return;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, path, error); // Atomic replacement of the previous checkpoint
+    if (error) {
+        LOG_WARNING("could not replace checkpoint " << path << ": " << error.message());
+    }
+}
@@ -0,0 +1,56 @@
+#include "../include/cost_provider.h"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+CoordinateCostProvider::CoordinateCostProvider(std::vector<double> x, std::vector<double> y, double directionPenalty)
+    : x(std::move(x)), y(std::move(y)), directionPenalty(directionPenalty) {
+    if (this->x.size() != this->y.size()) {
+        throw std::invalid_argument("Coordinate vectors must have the same length");
+    }
+    if (directionPenalty < 0) {
+        throw std::invalid_argument("Direction penalty must not be negative");
+    }
+}
+
+int CoordinateCostProvider::getSize() const {
+    return static_cast<int>(x.size());
+}
+
+int CoordinateCostProvider::getCost(int i, int j) const {
+    if (i == j) {
+        return 0;
+    }
+    double dx = x[j] - x[i];
+    double dy = y[j] - y[i];
+    double cost = std::sqrt(dx * dx + dy * dy);
+    if (dy > 0) {
+        cost += directionPenalty * dy; // Uphill edges cost extra
+    }
+    return static_cast<int>(cost + 0.5);
+}
+
+bool CoordinateCostProvider::isSymmetric() const {
+    return directionPenalty == 0;
+}
+
+unsigned long long CoordinateCostProvider::fingerprint() const {
+    // FNV-1a over the cost model tag, the penalty and the coordinates
+    unsigned long long hash = 14695981039346656037ULL;
+    auto mix = [&hash](double value) {
+        unsigned char bytes[sizeof(double)];
+        std::memcpy(bytes, &value, sizeof(double));
+        for (unsigned char byte : bytes) {
+            hash ^= byte;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(1.0); // CoordinateCostProvider
+    mix(directionPenalty);
+    for (size_t i = 0; i < x.size(); ++i) {
+        mix(x[i]);
+        mix(y[i]);
+    }
+    return hash;
+}
@@ -0,0 +1,827 @@
+#include "../include/daemon.h"
+#include "../include/Algorithms/Solver.h"
+#include "../include/logger.h"
+#include "../include/matrix_image.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+SolverDaemon* signalTarget = nullptr; ///< Daemon stopped by SIGINT and SIGTERM while run() executes.
+
+std::atomic<bool> interrupted{false}; ///< Set by SIGINT and SIGTERM.
+
+void onSignal(int) {
+    interrupted = true;
+    if (signalTarget != nullptr) {
+        signalTarget->stop();
+    }
+}
+
+/**
+ * @brief Creates a response event, echoing the id of its request.
+ */
+nlohmann::json event(const nlohmann::json& request, const char* name) {
+    nlohmann::json response = {{"event", name}};
+    if (request.is_object() && request.contains("id")) {
+        response["id"] = request["id"];
+    }
+    return response;
+}
+
+double millisecondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+/**
+ * @brief Adds a duration to a time point, saturating at time_point::max() (which stands for "no deadline").
+ */
+std::chrono::steady_clock::time_point later(std::chrono::steady_clock::time_point time, std::chrono::steady_clock::duration span) {
+    if (time == std::chrono::steady_clock::time_point::max() || span >= std::chrono::steady_clock::time_point::max() - time) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return time + span;
+}
+
+std::chrono::steady_clock::duration secondsToDuration(double seconds) {
+    if (seconds <= 0) {
+        return std::chrono::steady_clock::duration::max(); // Unlimited
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+/**
+ * @class Rejected
+ * @brief Thrown when admission control refuses a request.
+ */
+class Rejected : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @struct DescriptorGuard
+ * @brief Closes a received descriptor once its request has been handled.
+ */
+struct DescriptorGuard {
+    int fd = -1; ///< The descriptor (-1 if none).
+
+    ~DescriptorGuard() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @struct SolverDaemon::Connection
+ * @brief A client connection; shared by its reader thread and its queued jobs, closed with the last of them.
+ */
+struct SolverDaemon::Connection {
+    int fd;                                ///< The connected socket.
+    std::mutex writeMutex;                 ///< Keeps response lines of concurrent jobs apart.
+    bool writable = true;                  ///< Cleared after a failed write.
+    std::atomic<bool> closed{false};       ///< Set when the client has gone.
+    std::atomic<bool> finished{false};     ///< Set when the reader thread has returned.
+    std::mutex activeMutex;                ///< Guards active.
+    std::set<SharedIncumbent*> active;     ///< Incumbents of the running jobs, cancelled when the client goes.
+    std::deque<int> descriptors;           ///< Matrix images received with SCM_RIGHTS and not yet used (reader thread only).
+
+    explicit Connection(int fd) : fd(fd) {}
+
+    ~Connection() {
+        for (int descriptor : descriptors) {
+            close(descriptor);
+        }
+        close(fd);
+    }
+
+    /**
+     * @brief Takes the oldest received descriptor.
+     *
+     * @throws std::invalid_argument If none was received.
+     */
+    int takeDescriptor() {
+        if (descriptors.empty()) {
+            throw std::invalid_argument("Request expects a matrix image descriptor but none was sent with it");
+        }
+        int descriptor = descriptors.front();
+        descriptors.pop_front();
+        return descriptor;
+    }
+
+    /**
+     * @brief Sends one response line; errors mark the connection as closed.
+     */
+    void send(const nlohmann::json& response) {
+        std::string line = response.dump() + "\n";
+        std::lock_guard<std::mutex> lock(writeMutex);
+        size_t written = 0;
+        while (writable && written < line.size()) {
+            ssize_t count = ::send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                writable = false;
+                closed = true;
+                break;
+            }
+            written += static_cast<size_t>(count);
+        }
+    }
+
+    /**
+     * @brief Marks the client as gone and cancels its running jobs.
+     */
+    void disconnect() {
+        closed = true;
+        std::lock_guard<std::mutex> lock(activeMutex);
+        for (SharedIncumbent* incumbent : active) {
+            incumbent->cancel();
+        }
+    }
+};
+
+/**
+ * @struct SolverDaemon::Job
+ * @brief A solve request waiting for a solve thread.
+ */
+struct SolverDaemon::Job {
+    std::shared_ptr<Connection> connection;         ///< Where the events go.
+    nlohmann::json request;                         ///< The request.
+    std::string solver;                             ///< Solver that runs; the fallback solver once degraded.
+    std::shared_ptr<const Matrix> matrix;           ///< The prepared instance.
+    JobKey key;                                     ///< Deadline (time_point::max() if none) and arrival number.
+    std::chrono::steady_clock::time_point received; ///< When the request was read; budget and deadline count from here.
+    std::chrono::steady_clock::duration budget;     ///< Longest run time (duration::max() if unlimited).
+    std::chrono::steady_clock::time_point stopAt = std::chrono::steady_clock::time_point::max(); ///< End of the budget, set when the job starts and moved by suspensions.
+    std::chrono::steady_clock::time_point suspendedAt; ///< When the job was last suspended.
+    bool degradable = true;                         ///< Whether admission control may switch to the fallback solver.
+    bool degraded = false;                          ///< Whether it did.
+    bool yielding = false;                          ///< Asked to suspend and not yet suspended.
+    bool resumed = false;                           ///< Set when a suspended job is granted a slot again.
+    unsigned int suspensions = 0;                   ///< Times the job was suspended.
+    std::condition_variable resumeReady;            ///< Signalled when resumed is set.
+    SharedIncumbent incumbent;                      ///< Best tour, cancellation and pause point of the run.
+};
+
+
+SolverDaemon::SolverDaemon(DaemonOptions options) : options(std::move(options)), listenFd(-1), wakeFds{-1, -1} {
+    const std::string& path = this->options.socketPath;
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Daemon socket path must have 1 to " + std::to_string(sizeof(address.sun_path) - 1) + " characters");
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            throw std::runtime_error("Daemon socket path exists and is not a socket: " + path);
+        }
+        unlink(path.c_str()); // Left behind by a daemon that did not shut down cleanly
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("Could not create daemon socket: ") + std::strerror(errno));
+    }
+    mode_t previousMask = umask(0077); // Local clients of the same user only
+    int bound = bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    umask(previousMask);
+    if (bound != 0 || listen(listenFd, 64) != 0 || pipe2(wakeFds, O_CLOEXEC | O_NONBLOCK) != 0) {
+        std::string reason = std::strerror(errno);
+        close(listenFd);
+        unlink(path.c_str());
+        throw std::runtime_error("Could not listen on " + path + ": " + reason);
+    }
+
+    for (const std::string& name : SolverRegistry::instance().names()) {
+        pools.emplace(name, std::unique_ptr<SolverPool>(new SolverPool(name)));
+    }
+
+    int count = this->options.workers > 0 ? this->options.workers : static_cast<int>(std::thread::hardware_concurrency());
+    slots = freeSlots = std::max(count, 1);
+    for (int i = 0; i < 2 * slots; ++i) {
+        workers.emplace_back(&SolverDaemon::work, this);
+    }
+}
+
+SolverDaemon::~SolverDaemon() {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        closing = true;
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    for (auto& connection : connections) {
+        shutdown(connection.first->fd, SHUT_RDWR);
+        connection.second.join();
+    }
+    close(listenFd);
+    close(wakeFds[0]);
+    close(wakeFds[1]);
+    unlink(options.socketPath.c_str());
+}
+
+void SolverDaemon::stop() {
+    stopping = true;
+    char wake = 1;
+    ssize_t ignored = write(wakeFds[1], &wake, 1); // Async-signal-safe; a full pipe already wakes the loop
+    (void)ignored;
+}
+
+void SolverDaemon::run() {
+    interrupted = false;
+    signalTarget = this;
+    struct sigaction action, previousInt, previousTerm;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &previousInt);
+    sigaction(SIGTERM, &action, &previousTerm);
+
+    LOG_INFO("Solver daemon listening on " << options.socketPath << " with " << slots << " solve slots");
+    while (!stopping) {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Daemon poll failed: ") + std::strerror(errno));
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue; // The client gave up before being accepted
+        }
+
+        // Reap the readers of connections that have closed
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (it->first->finished) {
+                it->second.join();
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+        connections.emplace_back(connection, std::thread(&SolverDaemon::serve, this, connection));
+    }
+
+    if (interrupted) {
+        // A signal asks for a prompt exit: running requests stop with their best tour, queued ones are dropped
+        for (auto& connection : connections) {
+            connection.first->disconnect();
+        }
+    }
+
+    // Let the solve threads answer the queued requests; connections stay open so that clients leaving
+    // meanwhile still cancel their runs, and new solve requests are refused
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        closing = true;
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (auto& connection : connections) {
+        shutdown(connection.first->fd, SHUT_RDWR);
+        connection.second.join();
+    }
+    connections.clear();
+
+    sigaction(SIGINT, &previousInt, nullptr);
+    sigaction(SIGTERM, &previousTerm, nullptr);
+    signalTarget = nullptr;
+    LOG_INFO("Solver daemon stopped after " << served.load() << " solve requests (" << degraded.load() << " degraded, "
+             << rejected.load() << " rejected, " << preempted.load() << " suspensions)");
+}
+
+void SolverDaemon::serve(std::shared_ptr<Connection> connection) {
+    std::string buffer;
+    char chunk[65536];
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+    while (true) {
+        iovec data = {chunk, sizeof(chunk)};
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ssize_t count = recvmsg(connection->fd, &message, MSG_CMSG_CLOEXEC);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        // Descriptors arrive with the first bytes of the request that uses them, so they are queued before it is parsed
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+                size_t received = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (size_t i = 0; i < received; ++i) {
+                    int descriptor;
+                    std::memcpy(&descriptor, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+                    connection->descriptors.push_back(descriptor);
+                }
+            }
+        }
+        buffer.append(chunk, static_cast<size_t>(count));
+        size_t begin = 0, end;
+        while ((end = buffer.find('\n', begin)) != std::string::npos) {
+            handle(connection, buffer.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        buffer.erase(0, begin);
+    }
+    connection->disconnect(); // Nobody is waiting for the results of this connection any more
+    connection->finished = true;
+}
+
+void SolverDaemon::handle(const std::shared_ptr<Connection>& connection, const std::string& line) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        return;
+    }
+    nlohmann::json request;
+    DescriptorGuard image;
+    try {
+        request = nlohmann::json::parse(line);
+        if (!request.is_object()) {
+            throw std::invalid_argument("Request must be a JSON object");
+        }
+        // Take the descriptor sent with this request first, so that a failure cannot hand it to the next one
+        image.fd = request.value("matrixFd", false) ? connection->takeDescriptor() : -1;
+        std::string op = request.value("op", std::string("solve"));
+        if (op == "solve") {
+            std::unique_ptr<Job> job(new Job());
+            job->received = std::chrono::steady_clock::now();
+            job->solver = request.at("solver").get<std::string>();
+            if (!SolverRegistry::instance().contains(job->solver)) {
+                throw std::invalid_argument("Unknown solver '" + job->solver + "'");
+            }
+            double timeLimit = request.value("timeLimitSeconds", options.timeLimitSeconds);
+            std::chrono::steady_clock::time_point deadline = later(job->received, secondsToDuration(request.value("deadlineSeconds", timeLimit)));
+            job->budget = std::min(secondsToDuration(timeLimit), deadline - job->received);
+            job->degradable = request.value("degrade", true);
+            job->matrix = resolveMatrix(request, image.fd);
+            job->connection = connection;
+            job->request = std::move(request);
+
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (closing) {
+                throw std::runtime_error("Daemon is shutting down");
+            }
+            job->key = {deadline, arrivals++};
+            admit(std::move(job));
+        } else if (op == "load") {
+            std::shared_ptr<const Matrix> matrix = resolveMatrix(request, image.fd);
+            nlohmann::json response = event(request, "loaded");
+            response["fingerprint"] = matrix->getFingerprint();
+            response["size"] = matrix->getSize();
+            connection->send(response);
+        } else if (op == "lookup") {
+            nlohmann::json response = event(request, "lookup");
+            response["known"] = static_cast<bool>(findMatrix(request.at("fingerprint").get<std::string>()));
+            connection->send(response);
+        } else if (op == "ping") {
+            connection->send(event(request, "pong"));
+        } else if (op == "stats") {
+            nlohmann::json response = event(request, "stats");
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                response["queued"] = queued.size();
+                response["running"] = running.size();
+                response["suspended"] = suspended.size();
+            }
+            {
+                std::lock_guard<std::mutex> lock(matricesMutex);
+                response["matrices"] = recent.size();
+            }
+            response["slots"] = slots;
+            response["served"] = served.load();
+            response["degraded"] = degraded.load();
+            response["rejected"] = rejected.load();
+            response["preempted"] = preempted.load();
+            {
+                std::lock_guard<std::mutex> lock(latencyMutex);
+                std::vector<double> sorted(latencies);
+                std::sort(sorted.begin(), sorted.end());
+                nlohmann::json percentiles = nlohmann::json::object();
+                for (int percent : {50, 95, 99}) {
+                    if (!sorted.empty()) {
+                        percentiles["p" + std::to_string(percent)] = sorted[(sorted.size() - 1) * percent / 100];
+                    }
+                }
+                response["latencyMs"] = percentiles;
+            }
+            response["solvers"] = SolverRegistry::instance().names();
+            connection->send(response);
+        } else if (op == "shutdown") {
+            connection->send(event(request, "bye"));
+            stop();
+        } else {
+            throw std::invalid_argument("Unknown op '" + op + "'");
+        }
+    } catch (const Rejected& e) {
+        ++rejected;
+        nlohmann::json response = event(request, "rejected");
+        response["message"] = e.what();
+        connection->send(response);
+    } catch (const std::exception& e) {
+        nlohmann::json response = event(request, "error");
+        response["message"] = e.what();
+        connection->send(response);
+    }
+}
+
+void SolverDaemon::admit(std::unique_ptr<Job> job) {
+    std::chrono::steady_clock::time_point deadline = job->key.first;
+    if (deadline != std::chrono::steady_clock::time_point::max()) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (deadline - projectedStart(job->key, now) < secondsToDuration(options.minSolveSeconds)) {
+            if (!job->degradable || options.fallbackSolver.empty() || job->solver == options.fallbackSolver) {
+                throw Rejected("Deadline cannot be met with the current load");
+            }
+            job->solver = options.fallbackSolver;
+            job->degraded = true;
+            ++degraded;
+        }
+    }
+    queued[job->key] = std::move(job);
+    schedule();
+}
+
+std::chrono::steady_clock::time_point SolverDaemon::projectedStart(const JobKey& key, std::chrono::steady_clock::time_point now) const {
+    // Running jobs with a later deadline would be suspended, so only earlier ones keep their slot
+    std::vector<std::chrono::steady_clock::time_point> freeAt;
+    for (const auto& entry : running) {
+        if (entry.first < key) {
+            freeAt.push_back(std::max(std::min(entry.second->stopAt, entry.first.first), now));
+        }
+    }
+    freeAt.resize(slots, now);
+
+    // The waiting jobs ahead of it take the slot that frees up first, in deadline order
+    std::vector<std::pair<JobKey, std::chrono::steady_clock::duration>> ahead;
+    for (const auto& entry : suspended) {
+        if (entry.first < key) {
+            const Job& job = *entry.second;
+            ahead.emplace_back(entry.first, std::min(job.stopAt - job.suspendedAt, std::max(job.key.first - now, std::chrono::steady_clock::duration::zero())));
+        }
+    }
+    for (const auto& entry : queued) {
+        if (!(entry.first < key)) {
+            break;
+        }
+        const Job& job = *entry.second;
+        ahead.emplace_back(entry.first, job.degraded ? std::chrono::steady_clock::duration::zero() : std::min(job.budget, std::max(job.key.first - now, std::chrono::steady_clock::duration::zero())));
+    }
+    std::sort(ahead.begin(), ahead.end());
+    for (const auto& job : ahead) {
+        std::vector<std::chrono::steady_clock::time_point>::iterator first = std::min_element(freeAt.begin(), freeAt.end());
+        *first = later(*first, job.second);
+    }
+    return *std::min_element(freeAt.begin(), freeAt.end());
+}
+
+void SolverDaemon::schedule() {
+    // A suspended job resumes when it is the earliest waiting one
+    while (freeSlots > 0 && !suspended.empty() && (queued.empty() || suspended.begin()->first < queued.begin()->first)) {
+        Job* job = suspended.begin()->second;
+        suspended.erase(suspended.begin());
+        running[job->key] = job;
+        --freeSlots;
+        job->stopAt = later(job->stopAt, std::chrono::steady_clock::now() - job->suspendedAt); // The pause does not count against the budget
+        job->incumbent.stopAt(job->stopAt);
+        job->incumbent.requestYield(false);
+        job->resumed = true;
+        job->resumeReady.notify_all();
+    }
+    if (freeSlots > 0 && !queued.empty()) {
+        queueReady.notify_all();
+        return;
+    }
+
+    // Without a free slot, the running job with the latest deadline makes room for an earlier waiting one.
+    // One suspension at a time; the next is decided when it has happened.
+    if (freeSlots > 0 || pendingYields > 0 || running.empty() || (queued.empty() && suspended.empty())) {
+        return;
+    }
+    bool waitingIsQueued = suspended.empty() || (!queued.empty() && queued.begin()->first < suspended.begin()->first);
+    const JobKey& waiting = waitingIsQueued ? queued.begin()->first : suspended.begin()->first;
+    Job* victim = running.rbegin()->second;
+    bool threadAvailable = !waitingIsQueued || static_cast<int>(running.size() + suspended.size()) < static_cast<int>(workers.size());
+    if (waiting < victim->key && threadAvailable) {
+        victim->yielding = true;
+        ++pendingYields;
+        victim->incumbent.requestYield(true);
+    }
+}
+
+void SolverDaemon::suspend(Job& job) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (job.yielding) {
+        // First thread of the run to reach a pause point; the others of a portfolio wait below as well
+        job.yielding = false;
+        --pendingYields;
+        running.erase(job.key);
+        suspended[job.key] = &job;
+        ++freeSlots;
+        ++job.suspensions;
+        ++preempted;
+        job.suspendedAt = std::chrono::steady_clock::now();
+        job.resumed = false;
+        schedule();
+    }
+    job.resumeReady.wait(lock, [&job] { return job.resumed; });
+}
+
+void SolverDaemon::recordLatency(double milliseconds) {
+    const size_t window = 1024;
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    if (latencies.size() < window) {
+        latencies.push_back(milliseconds);
+    } else {
+        latencies[latencyCount % window] = milliseconds;
+    }
+    ++latencyCount;
+}
+
+void SolverDaemon::work() {
+    while (true) {
+        std::unique_ptr<Job> job;
+        std::string rejection;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] {
+                bool startable = freeSlots > 0 && !queued.empty() && (suspended.empty() || queued.begin()->first < suspended.begin()->first);
+                return startable || (closing && queued.empty());
+            });
+            if (queued.empty()) {
+                return; // Closing and drained
+            }
+            job = std::move(queued.begin()->second);
+            queued.erase(queued.begin());
+            running[job->key] = job.get();
+            --freeSlots;
+
+            // The queue may have grown since admission; repeat the check with the actual start time
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (!job->degraded && job->key.first - now < secondsToDuration(options.minSolveSeconds)) {
+                if (job->degradable && !options.fallbackSolver.empty() && job->solver != options.fallbackSolver) {
+                    job->solver = options.fallbackSolver;
+                    job->degraded = true;
+                    ++degraded;
+                } else {
+                    rejection = "Deadline passed while queued";
+                }
+            }
+            job->stopAt = job->degraded ? std::chrono::steady_clock::time_point::max() : later(now, job->budget);
+        }
+
+        if (!rejection.empty()) {
+            ++rejected;
+            nlohmann::json response = event(job->request, "rejected");
+            response["message"] = rejection;
+            job->connection->send(response);
+        } else if (!job->connection->closed) {
+            try {
+                solve(*job);
+            } catch (const std::exception& e) {
+                nlohmann::json response = event(job->request, "error");
+                response["message"] = e.what();
+                job->connection->send(response);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (job->yielding) {
+            --pendingYields; // Finished before reaching a pause point
+        }
+        running.erase(job->key);
+        ++freeSlots;
+        schedule();
+    }
+}
+
+void SolverDaemon::solve(Job& job) {
+    const nlohmann::json& request = job.request;
+    const std::string& name = job.solver;
+    SolverPool& pool = *pools.at(name); // Registered names only; checked when the request was queued
+
+    SolveRequest solveRequest;
+    solveRequest.matrix = job.matrix.get();
+    solveRequest.parameters = options.defaultParameters.count(name) ? options.defaultParameters.at(name) : nlohmann::json::object();
+    if (!job.degraded) {
+        solveRequest.parameters.update(request.value("parameters", nlohmann::json::object()));
+    }
+    solveRequest.seed = request.value("seed", 0u);
+    solveRequest.deadline = job.key.first; // The budget is enforced through the incumbent, which suspensions can move
+
+    SharedIncumbent& incumbent = job.incumbent;
+    incumbent.stopAt(job.stopAt);
+    incumbent.setYieldHandler([this, &job] { suspend(job); });
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (request.value("stream", true)) {
+        Connection* connection = job.connection.get();
+        incumbent.setListener([&request, connection, start](int cost, const std::vector<int>& tour, const std::string& by) {
+            nlohmann::json response = event(request, "incumbent");
+            response["cost"] = cost;
+            response["tour"] = tour;
+            response["solver"] = by;
+            response["elapsedMs"] = millisecondsBetween(start, std::chrono::steady_clock::now());
+            connection->send(response);
+        });
+    }
+    solveRequest.incumbent = &incumbent;
+
+    {
+        std::lock_guard<std::mutex> lock(job.connection->activeMutex);
+        job.connection->active.insert(&incumbent);
+    }
+    if (job.connection->closed) {
+        incumbent.cancel(); // The client left between dequeuing and registering
+    }
+    SolveResult result;
+    try {
+        result = pool.solve(solveRequest);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job.connection->activeMutex);
+        job.connection->active.erase(&incumbent);
+        throw;
+    }
+    {
+        std::lock_guard<std::mutex> lock(job.connection->activeMutex);
+        job.connection->active.erase(&incumbent);
+    }
+
+    nlohmann::json response = event(request, "result");
+    response["solver"] = result.solver;
+    response["fingerprint"] = job.matrix->getFingerprint();
+    response["size"] = job.matrix->getSize();
+    response["cost"] = result.cost == INT_MAX ? nlohmann::json() : nlohmann::json(result.cost);
+    response["tour"] = result.tour;
+    response["bound"] = result.bound;
+    response["optimal"] = result.optimal;
+    response["timedOut"] = result.timedOut;
+    response["parameters"] = result.parameters;
+    response["stats"] = result.stats;
+    response["queueMs"] = millisecondsBetween(job.received, start);
+    response["setupMs"] = result.timings.setupMs;
+    response["solveMs"] = result.timings.solveMs;
+    response["degraded"] = job.degraded;
+    response["requestedSolver"] = request.at("solver");
+    response["suspensions"] = job.suspensions;
+    ++served;
+    recordLatency(millisecondsBetween(job.received, std::chrono::steady_clock::now()));
+    job.connection->send(response);
+}
+
+std::shared_ptr<const Matrix> SolverDaemon::resolveMatrix(const nlohmann::json& request, int descriptor) {
+    if (request.contains("fingerprint")) {
+        std::shared_ptr<const Matrix> cached = findMatrix(request.at("fingerprint").get<std::string>());
+        if (cached) {
+            return cached; // Handshake: a known instance is not loaded again
+        }
+        if (descriptor < 0 && !request.contains("matrix") && !request.contains("path")) {
+            throw std::invalid_argument("Unknown fingerprint " + request.at("fingerprint").get<std::string>() + "; send the matrix");
+        }
+    }
+
+    if (descriptor >= 0) {
+        return cacheMatrix(mapMatrixImage(descriptor));
+    }
+
+    if (request.contains("matrix")) {
+        const nlohmann::json& rows = request.at("matrix");
+        int size = static_cast<int>(rows.size());
+        std::vector<int> costs;
+        costs.reserve(static_cast<size_t>(size) * size);
+        for (const nlohmann::json& row : rows) {
+            if (!row.is_array() || static_cast<int>(row.size()) != size) {
+                throw std::invalid_argument("Inline matrix must be a square array of rows");
+            }
+            for (const nlohmann::json& cost : row) {
+                costs.push_back(cost.get<int>());
+            }
+        }
+        std::unique_ptr<Matrix> matrix(new Matrix(0));
+        matrix->setCosts(size, costs);
+        return cacheMatrix(std::move(matrix));
+    }
+
+    if (request.contains("path")) {
+        std::string path = request.at("path").get<std::string>();
+        struct stat file;
+        if (stat(path.c_str(), &file) != 0) {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        long long modified = static_cast<long long>(file.st_mtim.tv_sec) * 1000000000LL + file.st_mtim.tv_nsec;
+        std::string fingerprint;
+        {
+            std::lock_guard<std::mutex> lock(matricesMutex);
+            auto known = paths.find(path);
+            if (known != paths.end() && known->second.first == modified) {
+                fingerprint = known->second.second;
+            }
+        }
+        if (!fingerprint.empty()) {
+            std::shared_ptr<const Matrix> cached = findMatrix(fingerprint);
+            if (cached) {
+                return cached;
+            }
+        }
+        std::unique_ptr<Matrix> matrix(new Matrix(0));
+        matrix->readFromFile(path);
+        std::shared_ptr<const Matrix> loaded = cacheMatrix(std::move(matrix));
+        std::lock_guard<std::mutex> lock(matricesMutex);
+        paths[path] = {modified, loaded->getFingerprint()};
+        return loaded;
+    }
+
+    throw std::invalid_argument("Request needs a 'matrix', 'path', 'matrixFd' or 'fingerprint'");
+}
+
+std::shared_ptr<const Matrix> SolverDaemon::cacheMatrix(std::unique_ptr<Matrix> matrix) {
+    std::shared_ptr<const Matrix> cached = findMatrix(matrix->getFingerprint());
+    if (cached) {
+        return cached;
+    }
+
+    // Prepare outside the lock; the instance is read-only once it is shared
+    matrix->buildTransposed();
+    if (options.candidateListSize > 0 && matrix->getSize() > 1) {
+        matrix->buildCandidateLists(options.candidateListSize);
+    }
+    std::shared_ptr<const Matrix> prepared(matrix.release());
+
+    std::lock_guard<std::mutex> lock(matricesMutex);
+    auto existing = matrices.find(prepared->getFingerprint());
+    if (existing != matrices.end()) {
+        return *existing->second; // Prepared concurrently by another request
+    }
+    recent.push_front(prepared);
+    matrices[prepared->getFingerprint()] = recent.begin();
+    while (static_cast<int>(recent.size()) > std::max(options.maxMatrices, 1)) {
+        // Running jobs keep their own reference, so evicting never invalidates a solve
+        matrices.erase(recent.back()->getFingerprint());
+        recent.pop_back();
+    }
+    return prepared;
+}
+
+std::shared_ptr<const Matrix> SolverDaemon::findMatrix(const std::string& fingerprint) {
+    std::lock_guard<std::mutex> lock(matricesMutex);
+    auto found = matrices.find(fingerprint);
+    if (found == matrices.end()) {
+        return nullptr;
+    }
+    recent.splice(recent.begin(), recent, found->second);
+    return recent.front();
+}
+
+#else
+
+// UNIX domain sockets, accept4 and pipe2 are only used on Linux; elsewhere daemon mode reports an error
+struct SolverDaemon::Connection {};
+struct SolverDaemon::Job {};
+
+SolverDaemon::SolverDaemon(DaemonOptions options) : options(std::move(options)), listenFd(-1), wakeFds{-1, -1} {
+    throw std::runtime_error("Daemon mode is only available on Linux");
+}
+
+SolverDaemon::~SolverDaemon() {}
+void SolverDaemon::stop() {}
+void SolverDaemon::run() {}
+
+#endif // __linux__
@@ -0,0 +1,25 @@
+#include "../include/incumbent.h"
+
+bool SharedIncumbent::offer(int cost, const std::vector<int>& tour, const std::string& solver) {
+    if (cost >= getCost()) {
+        return false; // Common case, no lock needed
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cost >= this->cost.load(std::memory_order_relaxed)) {
+        return false; // Another solver was faster
+    }
+    this->tour = tour;
+    this->solver = solver;
+    this->cost.store(cost, std::memory_order_release);
+    if (listener) {
+        listener(cost, tour, solver);
+    }
+    return true;
+}
+
+int SharedIncumbent::get(std::vector<int>& tour, std::string& solver) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    tour = this->tour;
+    solver = this->solver;
+    return cost.load(std::memory_order_relaxed);
+}
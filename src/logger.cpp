@@ -0,0 +1,138 @@
+#include "../include/logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+const size_t RING_CAPACITY = 8192;                // Messages that can be queued without blocking
+const std::chrono::milliseconds IDLE_TIMEOUT(50); // Upper bound on the latency of a missed wake-up
+
+} // namespace
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : ring(RING_CAPACITY), minLevel(static_cast<int>(LogLevel::Info)) {
+    worker = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    worker.join();
+}
+
+void Logger::setLevel(LogLevel level) {
+    minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::parseLevel(const std::string& name) {
+    if (name == "debug") return LogLevel::Debug;
+    if (name == "info") return LogLevel::Info;
+    if (name == "warning") return LogLevel::Warning;
+    if (name == "error") return LogLevel::Error;
+    if (name == "off") return LogLevel::Off;
+    throw std::runtime_error("Invalid log level '" + name + "'. Must be 'debug', 'info', 'warning', 'error' or 'off'.");
+}
+
+void Logger::log(LogLevel level, std::string message) {
+    LogEntry entry;
+    entry.level = level;
+    entry.message = std::move(message);
+    while (!ring.tryPush(entry)) {
+        notifyWriter(); // Full: make sure the writer is draining, then wait for a free slot
+        std::this_thread::yield();
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    notifyWriter();
+}
+
+void Logger::notifyWriter() {
+    if (writerIdle.load(std::memory_order_acquire)) {
+        wakeUp.notify_one();
+    }
+}
+
+void Logger::flush() {
+    unsigned long long target = queued.load(std::memory_order_acquire);
+    if (written.load(std::memory_order_acquire) >= target) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeUp.notify_one();
+    drained.wait(lock, [this, target] { return written.load(std::memory_order_acquire) >= target; });
+}
+
+unsigned long long Logger::drain() {
+    std::string out, err;
+    unsigned long long count = 0;
+    LogEntry entry;
+    while (ring.pop(entry)) {
+        switch (entry.level) {
+        case LogLevel::Debug:
+            out += "[debug] ";
+            out += entry.message;
+            out += '\n';
+            break;
+        case LogLevel::Warning:
+            err += "Warning: ";
+            err += entry.message;
+            err += '\n';
+            break;
+        case LogLevel::Error:
+            err += "Error: ";
+            err += entry.message;
+            err += '\n';
+            break;
+        default:
+            out += entry.message;
+            out += '\n';
+            break;
+        }
+        ++count;
+    }
+
+    // One write and one flush per batch instead of per line
+    if (!out.empty()) {
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+    }
+    if (!err.empty()) {
+        std::fwrite(err.data(), 1, err.size(), stderr);
+        std::fflush(stderr);
+    }
+    return count;
+}
+
+void Logger::run() {
+    for (;;) {
+        unsigned long long count = drain();
+        if (count > 0) {
+            written.fetch_add(count, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(mutex);
+            drained.notify_all();
+            continue; // Check for more before sleeping
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) {
+            break;
+        }
+        writerIdle.store(true, std::memory_order_release);
+        bool pending = queued.load(std::memory_order_acquire) > written.load(std::memory_order_acquire);
+        if (!pending) {
+            wakeUp.wait_for(lock, IDLE_TIMEOUT);
+        }
+        writerIdle.store(false, std::memory_order_relaxed);
+    }
+
+    // Messages logged during shutdown
+    written.fetch_add(drain(), std::memory_order_release);
+}
@@ -2,11 +2,44 @@
 
 // Global variables
 int numSamples;
-bool isRandom, doBNB, doBF, doTabu, doGA;
+bool isRandom, isImplicit, doBNB, doBF, doTabu, doGA, doPortfolio, displayMatrix;
 int initial_size, final_size, minValue, maxValue, symmetricity, asymRangeMin, asymRangeMax, step, tabuSize, maxIterations;
-std::string input_path, GAPath;
+int candidateListSize, implicitSize, implicitRowCacheSize;
+nlohmann::json branchAndBoundParameters;
+double implicitMaxCoordinate, implicitDirectionPenalty, timeLimitSeconds;
+std::string input_path, GAPath, coordinatesPath;
+std::vector<std::string> portfolioSolvers;
+ResultCache* resultCache = nullptr;
+Checkpointer* checkpointer = nullptr;
+bool useScheduler, schedulerPinThreads;
+int schedulerWorkers;
+ExperimentScheduler::Isolation schedulerIsolation;
+std::map<std::string, int> schedulerPriorities;
+std::string daemonSocketPath, daemonFallbackSolver;
+int daemonWorkers, daemonMaxMatrices;
+double daemonMinSolveSeconds;
+bool doSweep;
+nlohmann::json sweepSpecification;
+std::string sweepOutputPath;
+bool doTune;
+nlohmann::json tunerSpecification, tabuProfiles;
+std::vector<std::string> tunerInstances;
+std::string tunerOutputPath;
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool daemonMode = false;
+    std::string socketOverride;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--daemon") {
+            daemonMode = true;
+        } else if (argument == "--socket" && i + 1 < argc) {
+            socketOverride = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--daemon [--socket <path>]]" << std::endl;
+            return 1;
+        }
+    }
 
     // Read the config file
     std::ifstream config_file("../config/config.json");
@@ -21,12 +54,59 @@ int main() {
     readConfig(config_json);
 
     try {
-        if (isRandom) {
+        if (daemonMode) {
+            if (!socketOverride.empty()) {
+                daemonSocketPath = socketOverride;
+            }
+            runDaemon();
+        } else if (doTune) {
+            runTuner();
+        } else if (doSweep) {
+            // One instance, loaded once and shared by every point of the sweep
+            Matrix mat(0);
+            if (isRandom) {
+                mat.generateRandomMatrix(initial_size, minValue, maxValue, symmetricity, asymRangeMin, asymRangeMax);
+                std::cout << "Random matrix generated:" << std::endl;
+            } else {
+                mat.readFromFile(input_path);
+                std::cout << "Matrix loaded from file: " << input_path.substr(input_path.find_last_of("/\\") + 1) << std::endl;
+            }
+            runSweep(mat);
+        } else if (isImplicit) {
+            // Costs are computed from coordinates on demand; the matrix is never materialized
+            Matrix mat(0);
+            if (!coordinatesPath.empty()) {
+                mat.readCoordinatesFromFile(coordinatesPath, implicitDirectionPenalty, implicitRowCacheSize);
+                std::cout << "Coordinates loaded from file: " << coordinatesPath << std::endl;
+            } else {
+                mat.generateRandomCoordinates(implicitSize, implicitMaxCoordinate, implicitDirectionPenalty, implicitRowCacheSize);
+                std::cout << "Random coordinates generated for " << mat.getSize() << " cities" << std::endl;
+            }
+            // Without candidate lists the heuristics would evaluate O(n^2) moves per step
+            mat.buildCandidateLists(candidateListSize > 0 ? candidateListSize : 10);
+            if (useScheduler) {
+                runScheduled({&mat});
+            } else {
+                runMultipleAlgorithms(numSamples, mat);
+            }
+        } else if (isRandom && useScheduler) {
+            // Every size is generated up front so that all jobs can be scheduled together
+            std::vector<std::unique_ptr<Matrix>> matrices;
+            std::vector<Matrix*> instances;
+            for (int size = initial_size; size <= final_size; size += step) {
+                matrices.emplace_back(new Matrix(size));
+                matrices.back()->generateRandomMatrix(size, minValue, maxValue, symmetricity, asymRangeMin, asymRangeMax);
+                std::cout << "Random matrix generated:" << std::endl;
+                prepareMatrix(*matrices.back());
+                instances.push_back(matrices.back().get());
+            }
+            runScheduled(instances);
+        } else if (isRandom) {
             for (int size = initial_size; size <= final_size; size += step) {
                 Matrix mat(size);
                 mat.generateRandomMatrix(size, minValue, maxValue, symmetricity, asymRangeMin, asymRangeMax);
                 std::cout << "Random matrix generated:" << std::endl;
-                mat.display();
+                prepareMatrix(mat);
                 runMultipleAlgorithms(numSamples, mat);
             }
         } else {
@@ -35,104 +115,295 @@ int main() {
             mat.readFromFile(input_path);
             std::string file_name = input_path.substr(input_path.find_last_of("/\\") + 1);
             std::cout << "Matrix loaded from file: " << file_name << std::endl;
-            mat.display();
-            if (doBNB){
-                BranchAndBound bnb(mat);
-                Util util1;
-                util1.getStartTime();
-                bnb.runBranchAndBound();
-                util1.getEndTime();
-                std::cout << "Branch and Bound algorithm completed for sample " << file_name << std::endl;
-                bnb.printSolution();
-                util1.printElapsedTimeMilliseconds();
-            }
-            if (doBF){
-                BruteForce bf(mat);
-                Util util2;
-                util2.getStartTime();
-                bf.runBruteForce();
-                util2.getEndTime();
-                std::cout << "Brute Force algorithm completed for sample " << file_name << std::endl;
-                bf.printSolution();
-                util2.printElapsedTimeMilliseconds();
-            }
-            if (doTabu){
-                runMultipleAlgorithms(numSamples, mat);
-            }
-            if (doGA){
+            prepareMatrix(mat);
+            if (useScheduler) {
+                runScheduled({&mat});
+            } else {
                 runMultipleAlgorithms(numSamples, mat);
             }
         }
 
+        // Wait for the results writer so that write errors are reported here
+        ResultsWriter::instance().flush();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
+        delete resultCache;
+        delete checkpointer;
         return 1;
     }
+    delete resultCache;
+    delete checkpointer; // Writes the snapshots that are still queued
 
+    PHASE_TIMER_REPORT(std::cout); // Only with the ATSP_PHASE_TIMERS build option; every solver has finished here
     std::cout<<"Program completed successfully."<<std::endl;
     return 0;
 }
 
 
+bool serveExactFromCache(const Matrix& mat, const std::string& solver, bool print) {
+    CachedResult cached;
+    if (resultCache == nullptr || !resultCache->lookup(mat, solver, "", cached) || !cached.exact) {
+        return false;
+    }
+    if (!print) {
+        return true;
+    }
+    std::cout << "Result of " << solver << " served from cache for instance " << mat.getFingerprint() << std::endl;
+    printTour(solver, cached.cost, cached.tour);
+    return true;
+}
+
+
+void storeResult(const Matrix& mat, const std::string& solver, const std::string& parameters, bool exact, int cost, std::vector<int> tour) {
+    if (resultCache == nullptr || cost == INT_MAX) {
+        return; // Caching disabled or no feasible tour found
+    }
+    if (static_cast<int>(tour.size()) == mat.getSize() + 1 && tour.back() == tour.front()) {
+        tour.pop_back(); // Closed tour
+    }
+    if (static_cast<int>(tour.size()) != mat.getSize()) {
+        return;
+    }
+    CachedResult result;
+    result.solver = solver;
+    result.parameters = parameters;
+    result.exact = exact;
+    result.cost = cost;
+    result.tour = std::move(tour);
+    resultCache->store(mat, result);
+}
+
+
 void runMultipleAlgorithms(int numSamples, Matrix& mat) {
     for (int i = 0; i < numSamples; ++i) {
         std::cout << "Running sample " << (i + 1) << " of " << numSamples << std::endl;
-        if(doBNB){
-            // Run the Branch and Bound algorithm
-            BranchAndBound bnb(mat);
-
-            Util util1;
-            util1.getStartTime();
-            bnb.runBranchAndBound();
-            util1.getEndTime();
-            std::cout << "Branch and Bound algorithm completed for sample " << (i + 1) << std::endl;
-            bnb.printSolution();
-            util1.printElapsedTimeMilliseconds();
-            util1.saveResults("../results/resultsBNB_" + std::to_string(mat.getSize()) + "x" + std::to_string(mat.getSize()) + ".csv", 
-            "bnb", mat.getSize(), util1.returnElapsedTimeMilliseconds());
-        };
-        if(doBF){
-            // Run the Brute Force algorithm
-            BruteForce bf(mat);
-
-            Util util2;
-            util2.getStartTime();
-            bf.runBruteForce();
-            util2.getEndTime();
-            std::cout << "Brute Force algorithm completed for sample " << (i + 1) << std::endl;
-            bf.printSolution();
-            util2.printElapsedTimeMilliseconds();
-            util2.saveResults("../results/resultsBF_" + std::to_string(mat.getSize()) + "x" + std::to_string(mat.getSize()) + ".csv", 
-            "bf", mat.getSize(), util2.returnElapsedTimeMilliseconds());
-        };
-        if(doTabu){
-            // Run the Tabu Search algorithm
-            TabuSearch tabu(mat, tabuSize, maxIterations);
-            Util util3;
-            util3.getStartTime();
-            tabu.runTabuSearch();
-            util3.getEndTime();
-            std::cout << "Tabu Search algorithm completed for sample " << (i + 1) << std::endl;
-            tabu.printSolutionTabu();
-            util3.printElapsedTimeMilliseconds();
-            util3.saveResultsTabuSearch("../results/resultsTabu_" + std::to_string(mat.getSize()) + "x" + std::to_string(mat.getSize()) + ".csv", 
-            "tabu", mat.getSize(), util3.returnElapsedTimeMilliseconds(), tabu.getBestCost());
-        }
-        if(doGA){
-            GeneticAlgorithm ga(mat, GAPath);
-            Util util4;
-            util4.getStartTime();
-            ga.runGeneticAlgorithm();
-            util4.getEndTime();
-            std::cout << "Genetic algorithm completed for sample " << (i + 1) << std::endl;
-            ga.printSolution();
-            util4.printElapsedTimeMilliseconds();
-            util4.saveResultsGA("../results/results_mut_type_bigger/resultsGA_" + std::to_string(mat.getSize()) + "x" + std::to_string(mat.getSize()) + ".csv", 
-            "ga", mat.getSize(), util4.returnElapsedTimeMilliseconds(), ga.getBestSolution(), ga.getPopulationSize(),
-            ga.getMutationRate(), ga.getCrossOverRate(), ga.getMutationType(), ga.getRandomRateNewGen(), ga.getIterationNum(),
-            ga.getCrossingSegmentSizeRate(), ga.getMutationSegmentSizeRate(), ga.getRandomRate());
+        for (const std::string& algorithm : enabledAlgorithms()) {
+            runAlgorithm(algorithm, mat, i + 1, "", true);
+        }
+    }
+}
+
+
+std::vector<std::string> enabledAlgorithms() {
+    std::vector<std::string> algorithms;
+    if (doBNB) algorithms.push_back("bnb");
+    if (doBF) algorithms.push_back("bf");
+    if (doTabu) algorithms.push_back("tabu");
+    if (doGA) algorithms.push_back("ga");
+    if (doPortfolio) algorithms.push_back("portfolio");
+    return algorithms;
+}
+
+
+std::string runAlgorithm(const std::string& algorithm, Matrix& mat, int sample, const std::string& run, bool verbose) {
+    std::unique_ptr<ISolver> solver = SolverRegistry::instance().create(algorithm);
+    if (solver->isExact() && serveExactFromCache(mat, algorithm, verbose)) {
+        return "served from cache";
+    }
+
+    SolveRequest request;
+    request.matrix = &mat;
+    request.parameters = solverParameters(algorithm);
+    CachedResult known;
+    if (algorithm == "bnb" && resultCache != nullptr && resultCache->bestKnownTour(mat, known)) {
+        request.parameters["initialTour"] = known.tour; // Any earlier tour of this instance prunes from the root
+    }
+    request.checkpointer = checkpointer;
+    request.run = run;
+    if (timeLimitSeconds > 0) {
+        request.deadline = std::chrono::steady_clock::now() +
+                           std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+    }
+    SolveResult result = solver->solve(request);
+
+    if (verbose) {
+        std::cout << solver->description() << " algorithm " << (result.timedOut ? "stopped at the time limit" : "completed")
+                  << " for sample " << sample << std::endl;
+        printTour(algorithm, result.cost, result.tour);
+        if (!result.stats.empty()) {
+            std::cout << "Search statistics:";
+            for (const auto& stat : result.stats) {
+                std::cout << " " << stat.first << "=" << stat.second;
+                if (SearchCounters::isCounter(stat.first)) {
+                    std::cout << " (" << static_cast<unsigned long long>(SearchCounters::perSecond(stat.second, result.timings.solveMs) + 0.5) << "/s)";
+                }
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Elapsed time: " << result.timings.solveMs << " milliseconds" << std::endl;
+    }
+    saveResult(result, mat.getSize());
+    // Heuristic tours are kept as warm starts for later runs, never served in place of a run
+    storeResult(mat, algorithm, solver->isExact() ? "" : result.parameters.dump(), result.optimal, result.cost, result.tour);
+
+    std::ostringstream summary;
+    summary << "cost " << (result.cost == INT_MAX ? std::string("none") : std::to_string(result.cost)) << ", "
+            << std::fixed << std::setprecision(3) << result.timings.solveMs << " ms" << (result.timedOut ? " (time limit)" : "");
+    return summary.str();
+}
+
+
+nlohmann::json solverParameters(const std::string& algorithm) {
+    if (algorithm == "bnb") {
+        return branchAndBoundParameters;
+    }
+    if (algorithm == "tabu") {
+        nlohmann::json parameters = {{"tabuSize", tabuSize}, {"maxIterations", maxIterations}};
+        if (!tabuProfiles.is_null()) {
+            parameters["profiles"] = tabuProfiles;
+        }
+        return parameters;
+    }
+    if (algorithm == "ga") {
+        return {{"configPath", GAPath}};
+    }
+    if (algorithm == "portfolio") {
+        nlohmann::json parameters = {{"solvers", portfolioSolvers}};
+        for (const std::string& member : portfolioSolvers) {
+            parameters[member] = solverParameters(member);
+        }
+        return parameters;
+    }
+    return nlohmann::json::object();
+}
+
+
+void saveResult(const SolveResult& result, int size) {
+    std::string dimensions = std::to_string(size) + "x" + std::to_string(size);
+    float time = static_cast<float>(result.timings.solveMs);
+    Util util;
+    util.setSearchCounters(SearchCounters::fromStats(result.stats));
+    if (result.solver == "bnb") {
+        util.saveResults("../results/resultsBNB_" + dimensions + ".csv", "bnb", size, time);
+    } else if (result.solver == "bf") {
+        util.saveResults("../results/resultsBF_" + dimensions + ".csv", "bf", size, time);
+    } else if (result.solver == "tabu") {
+        util.saveResultsTabuSearch("../results/resultsTabu_" + dimensions + ".csv", "tabu", size, time, result.cost);
+    } else if (result.solver == "ga") {
+        const nlohmann::json& ga = result.parameters.at("geneticAlgorithmConfiguration");
+        int mutationRate = ga.at("mutationRate").get<int>(), randomRate = ga.at("randomRate").get<int>();
+        util.saveResultsGA("../results/results_mut_type_bigger/resultsGA_" + dimensions + ".csv",
+        "ga", size, time, result.cost, ga.at("populationSize").get<int>(),
+        mutationRate, 100 - mutationRate - randomRate, ga.at("mutationType").get<std::string>()[0], ga.at("randomRateNewGen").get<int>(),
+        ga.at("iterationNum").get<int>(), ga.at("crossingSegmentSizeRate").get<int>(), ga.at("mutationSegmentSizeRate").get<int>(), randomRate);
+    } else {
+        util.saveResults("../results/results_" + result.solver + "_" + dimensions + ".csv", result.solver, size, time);
+    }
+}
+
+
+void printTour(const std::string& solver, int cost, const std::vector<int>& tour) {
+    if (tour.empty()) {
+        std::cout << "No feasible tour found (" << solver << ")" << std::endl;
+        return;
+    }
+    std::cout << "Minimum cost (" << solver << "): " << cost << std::endl;
+    int bestKnown = isRandom || isImplicit ? -1 : bestKnownCost(input_path);
+    if (bestKnown > 0) {
+        std::ostringstream gap; // A local stream, so the precision does not stick to std::cout
+        gap << std::fixed << std::setprecision(2) << gapPercent(cost, bestKnown);
+        std::cout << "Gap to best known " << bestKnown << " (" << solver << "): " << gap.str() << "%" << std::endl;
+    }
+    std::cout << "Best path (" << solver << "): ";
+    for (int city : tour) {
+        std::cout << city << " ";
+    }
+    std::cout << tour[0] << std::endl;
+}
+
+
+void runScheduled(const std::vector<Matrix*>& matrices) {
+    ExperimentScheduler scheduler(schedulerWorkers, schedulerIsolation, schedulerPinThreads);
+    for (Matrix* mat : matrices) {
+        std::string size = std::to_string(mat->getSize()) + "x" + std::to_string(mat->getSize());
+        for (int sample = 1; sample <= numSamples; ++sample) {
+            // Concurrent samples of one solver on one instance need their own checkpoint files
+            std::string run = numSamples > 1 ? "s" + std::to_string(sample) : "";
+            for (const std::string& algorithm : enabledAlgorithms()) {
+                ExperimentJob job;
+                job.label = algorithm + " " + size + " sample " + std::to_string(sample) + "/" + std::to_string(numSamples);
+                job.priority = schedulerPriorities.count(algorithm) ? schedulerPriorities.at(algorithm) : 0;
+                job.run = [algorithm, mat, sample, run] { return runAlgorithm(algorithm, *mat, sample, run, false); };
+                scheduler.submit(job);
+            }
         }
     }
+    scheduler.run();
+}
+
+
+void runDaemon() {
+    DaemonOptions options;
+    options.socketPath = daemonSocketPath;
+    options.workers = daemonWorkers;
+    options.maxMatrices = daemonMaxMatrices;
+    options.candidateListSize = candidateListSize > 0 ? candidateListSize : 10;
+    options.timeLimitSeconds = timeLimitSeconds;
+    options.minSolveSeconds = daemonMinSolveSeconds;
+    options.fallbackSolver = daemonFallbackSolver;
+
+    // The GA configuration is parsed once here instead of by every request
+    nlohmann::json geneticConfiguration;
+    std::ifstream geneticFile(GAPath);
+    if (geneticFile.is_open()) {
+        geneticFile >> geneticConfiguration;
+    } else {
+        LOG_WARNING("could not open " << GAPath << "; ga requests must pass their configuration");
+    }
+    for (const std::string& name : SolverRegistry::instance().names()) {
+        nlohmann::json parameters = solverParameters(name);
+        if (parameters.contains("configPath") && !geneticConfiguration.is_null()) {
+            parameters = geneticConfiguration;
+        }
+        if (parameters.contains("ga") && !geneticConfiguration.is_null()) {
+            parameters["ga"] = geneticConfiguration;
+        }
+        options.defaultParameters[name] = parameters;
+    }
+
+    SolverDaemon daemon(options);
+    daemon.run(); // Logs the socket it listens on
+}
+
+
+void runSweep(Matrix& mat) {
+    ParameterSweep sweep(sweepSpecification);
+    displayMatrix ? mat.display() : mat.displaySummary();
+    if (sweep.getSolver() == "bnb") {
+        mat.buildTransposed();
+    }
+    if (candidateListSize > 0) {
+        mat.buildCandidateLists(candidateListSize);
+    }
+    ExperimentScheduler scheduler(schedulerWorkers, schedulerIsolation, schedulerPinThreads);
+    sweep.run(mat, solverParameters(sweep.getSolver()), scheduler, sweepOutputPath, timeLimitSeconds);
+}
+
+
+void runTuner() {
+    RaceTuner tuner(tunerSpecification);
+    ExperimentScheduler scheduler(schedulerWorkers, schedulerIsolation, schedulerPinThreads);
+    nlohmann::json tuned = tuner.run(tunerInstances, solverParameters(tuner.getSolver()), scheduler, timeLimitSeconds, candidateListSize);
+    std::ofstream file(tunerOutputPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not write tuned profiles to " + tunerOutputPath);
+    }
+    file << tuned.dump(4) << std::endl;
+    std::cout << "Tuned profiles written to " << tunerOutputPath << std::endl;
+}
+
+
+void prepareMatrix(Matrix& mat) {
+    displayMatrix ? mat.display() : mat.displaySummary();
+    auto portfolioUses = [](const char* member) {
+        return doPortfolio && std::find(portfolioSolvers.begin(), portfolioSolvers.end(), member) != portfolioSolvers.end();
+    };
+    if (doBNB || portfolioUses("bnb")) {
+        mat.buildTransposed(); // Branch and Bound scans incoming costs column by column
+    }
+    if ((doTabu || doGA || portfolioUses("tabu") || portfolioUses("ga")) && candidateListSize > 0) {
+        mat.buildCandidateLists(candidateListSize); // Restricts the heuristic neighbourhoods
+    }
 }
 
 
@@ -149,6 +420,91 @@ void readConfig(const nlohmann::json& config_json) {
         doGA = config_json.at("configurations").at("doGA").get<bool>();
         GAPath = config_json.at("configurations").at("GA").at("GAPath").get<std::string>();
 
+        // Optional fields
+        candidateListSize = config_json.at("configurations").value("candidateListSize", 0);
+        displayMatrix = config_json.at("configurations").value("displayMatrix", false);
+        timeLimitSeconds = config_json.at("configurations").value("timeLimitSeconds", 0.0);
+        Logger::instance().setLevel(Logger::parseLevel(config_json.at("configurations").value("logLevel", std::string("info"))));
+
+        nlohmann::json implicit = config_json.at("configurations").value("implicitMatrix", nlohmann::json::object());
+        isImplicit = implicit.value("enabled", false);
+        if (isImplicit) {
+            coordinatesPath = implicit.value("coordinatesFilePath", std::string());
+            if (!coordinatesPath.empty()) {
+                coordinatesPath = "../" + coordinatesPath;
+            }
+            implicitSize = implicit.value("size", 1000);
+            implicitMaxCoordinate = implicit.value("maxCoordinate", 10000.0);
+            implicitDirectionPenalty = implicit.value("directionPenalty", 0.5);
+            implicitRowCacheSize = implicit.value("rowCacheSize", 8);
+        }
+
+        nlohmann::json writer = config_json.at("configurations").value("resultsWriter", nlohmann::json::object());
+        ResultsWriter::instance().configure(ResultsWriter::parseFsyncPolicy(writer.value("fsyncPolicy", std::string("close"))),
+                                            writer.value("batchSize", 256), writer.value("flushIntervalMs", 100));
+        std::string resultsFormat = writer.value("format", std::string("csv"));
+        if (resultsFormat != "csv" && resultsFormat != "columnar" && resultsFormat != "both") {
+            throw std::runtime_error("Invalid results format '" + resultsFormat + "'. Must be 'csv', 'columnar' or 'both'.");
+        }
+        ResultsWriter::instance().setFormats(resultsFormat != "columnar", resultsFormat != "csv");
+
+        nlohmann::json cache = config_json.at("configurations").value("resultCache", nlohmann::json::object());
+        if (cache.value("enabled", false)) {
+            resultCache = new ResultCache("../" + cache.value("directory", std::string("cache")),
+                                          static_cast<unsigned long long>(cache.value("maxSizeMB", 64)) * 1024 * 1024);
+        }
+
+        nlohmann::json scheduler = config_json.at("configurations").value("scheduler", nlohmann::json::object());
+        useScheduler = scheduler.value("enabled", false);
+        schedulerWorkers = scheduler.value("workers", 0);
+        schedulerIsolation = ExperimentScheduler::parseIsolation(scheduler.value("isolation", std::string("physical")));
+        schedulerPinThreads = scheduler.value("pinThreads", true);
+        schedulerPriorities = scheduler.value("priorities", std::map<std::string, int>());
+
+        nlohmann::json bnb = config_json.at("configurations").value("branchAndBound", nlohmann::json::object());
+        branchAndBoundParameters = {{"warmStart", bnb.value("warmStart", true)},
+                                    {"warmStartIterations", bnb.value("warmStartIterations", 1000)},
+                                    {"warmStartTabuSize", bnb.value("warmStartTabuSize", 10)}};
+
+        nlohmann::json portfolio = config_json.at("configurations").value("portfolio", nlohmann::json::object());
+        doPortfolio = portfolio.value("enabled", false);
+        portfolioSolvers = portfolio.value("solvers", std::vector<std::string>{"bnb", "tabu", "ga"});
+
+        nlohmann::json daemon = config_json.at("configurations").value("daemon", nlohmann::json::object());
+        daemonSocketPath = "../" + daemon.value("socketPath", std::string("atsp.sock"));
+        daemonWorkers = daemon.value("workers", 0);
+        daemonMaxMatrices = daemon.value("maxMatrices", 16);
+        daemonMinSolveSeconds = daemon.value("minSolveSeconds", 0.01);
+        daemonFallbackSolver = daemon.value("fallbackSolver", std::string("nn"));
+
+        nlohmann::json sweep = config_json.at("configurations").value("sweep", nlohmann::json::object());
+        doSweep = sweep.value("enabled", false);
+        sweepSpecification = sweep;
+        sweepOutputPath = "../" + sweep.value("outputFilePath", std::string("results/sweep.csv"));
+
+        nlohmann::json tuner = config_json.at("configurations").value("tuner", nlohmann::json::object());
+        doTune = tuner.value("enabled", false);
+        tunerSpecification = tuner;
+        for (const std::string& path : tuner.value("instances", std::vector<std::string>{"data/TSPLib_ATSP"})) {
+            tunerInstances.push_back("../" + path);
+        }
+        tunerOutputPath = "../" + tuner.value("outputFilePath", std::string("config/tuned_profiles.json"));
+
+        std::string tabuProfilePath = config_json.at("configurations").at("tabuSearch").value("profilePath", std::string());
+        if (!tabuProfilePath.empty()) {
+            std::ifstream profileFile("../" + tabuProfilePath);
+            if (!profileFile.is_open()) {
+                throw std::runtime_error("Could not open Tabu Search profiles: " + tabuProfilePath);
+            }
+            tabuProfiles = nlohmann::json::parse(profileFile).at("profiles");
+        }
+
+        nlohmann::json checkpoint = config_json.at("configurations").value("checkpoint", nlohmann::json::object());
+        if (checkpoint.value("enabled", false)) {
+            checkpointer = new Checkpointer("../" + checkpoint.value("directory", std::string("checkpoints")),
+                                            checkpoint.value("intervalSeconds", 60.0), checkpoint.value("resume", true));
+        }
+
         // Conditional parsing based on whether the matrix is random or loaded from a file
         if (isRandom) {
             // Ensure that all expected fields for random matrix generation are present
@@ -169,5 +525,8 @@ void readConfig(const nlohmann::json& config_json) {
     } catch (const nlohmann::json::exception& e) {
         std::cerr << "JSON Parsing Error: " << e.what() << std::endl;
         exit(1);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Configuration error: " << e.what() << std::endl;
+        exit(1);
     }
 }
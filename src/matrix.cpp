@@ -1,6 +1,61 @@
 #include "../include/matrix.h"
 
-Matrix::Matrix(int s) : size(s), data(nullptr) {
+#include <atomic>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <vector>
+
+#ifdef ATSP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+// Per-thread LRU cache of materialized rows for provider-backed matrices
+struct RowCache {
+    unsigned long long owner = 0;          // providerId of the matrix the rows belong to
+    std::vector<int> cities;               // City held by each slot (-1 if empty)
+    std::vector<unsigned long long> lastUse; // Access tick of each slot
+    std::vector<int> rows;                 // Slot-major row storage
+    unsigned long long clock = 0;
+};
+
+thread_local RowCache rowCache;
+
+/**
+ * @brief Reads a whole gzip-compressed file.
+ */
+std::string decompressGzip(const std::string& filename) {
+#ifdef ATSP_HAVE_ZLIB
+    gzFile file = gzopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::string contents;
+    char buffer[1 << 16];
+    int count;
+    while ((count = gzread(file, buffer, sizeof(buffer))) > 0) {
+        contents.append(buffer, count);
+    }
+    int error = 0;
+    std::string message = count < 0 ? gzerror(file, &error) : "";
+    gzclose(file);
+    if (count < 0) {
+        throw std::runtime_error("Could not decompress " + filename + ": " + message);
+    }
+    return contents;
+#else
+    throw std::runtime_error("Cannot read " + filename + ": built without zlib");
+#endif
+}
+std::atomic<unsigned long long> nextProviderId{1};
+
+} // namespace
+
+Matrix::Matrix(int s) : size(s), data(nullptr), transposed(nullptr), candidateLists(nullptr),
+      symmetric(false), packed(false), provider(nullptr), providerId(0), rowCacheSize(0),
+      forbiddenEdgeCount(0), adjacencyOffsets(nullptr), adjacencyTargets(nullptr), contentHash(0) {
     // Allocate memory for a size x size matrix
     data = new int[size * size]; // Allocating a contiguous block of memory for the matrix
     // std::fill(data, data + size * size, 0); // Initialize the matrix with zeros
@@ -8,53 +63,156 @@ Matrix::Matrix(int s) : size(s), data(nullptr) {
 
 Matrix::~Matrix() {
     // Deallocate the memory
-    delete[] data;
+    resetStorage();
+}
+
+void Matrix::resetStorage() {
+    if (releaseView) {
+        releaseView();
+        releaseView = nullptr;
+    } else {
+        delete[] data;
+    }
+    data = nullptr;
+    clearDerived();
+    delete provider;
+    provider = nullptr;
+    providerId = 0;
+    symmetric = false;
+    packed = false;
+    delete[] adjacencyOffsets;
+    adjacencyOffsets = nullptr;
+    delete[] adjacencyTargets;
+    adjacencyTargets = nullptr;
+    forbiddenEdgeCount = 0;
+}
+
+void Matrix::clearDerived() {
+    delete[] transposed;
+    transposed = nullptr;
+    delete candidateLists;
+    candidateLists = nullptr;
 }
 
 void Matrix::readFromFile(const std::string& filename) {
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + filename);
     }
+    if (filename.size() > 3 && filename.compare(filename.size() - 3, 3, ".gz") == 0) {
+        std::istringstream contents(decompressGzip(filename));
+        readFromStream(contents);
+    } else {
+        readFromStream(file);
+    }
+}
 
+
+void Matrix::readFromStream(std::istream& input) {
     // Read the matrix size from the first line
     std::string line;
-    if (!std::getline(file, line)) {
+    if (!std::getline(input, line)) {
         throw std::runtime_error("Error: Could not read the size of the matrix from the file.");
     }
-    
-    std::stringstream ss(line);
-    ss >> size;  // Set the matrix size
+
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first != std::string::npos && std::isalpha(static_cast<unsigned char>(line[first]))) {
+        // TSPLIB: "KEY: value" lines up to EDGE_WEIGHT_SECTION, which must hold a full matrix
+        size = 0;
+        bool section = false;
+        do {
+            size_t colon = line.find(':');
+            std::string key = line.substr(0, colon);
+            std::string value = colon == std::string::npos ? "" : line.substr(colon + 1);
+            key.erase(0, key.find_first_not_of(" \t\r"));
+            key.erase(key.find_last_not_of(" \t\r") + 1);
+            value.erase(0, value.find_first_not_of(" \t\r"));
+            value.erase(value.find_last_not_of(" \t\r") + 1);
+            if (key == "DIMENSION") {
+                size = std::atoi(value.c_str());
+            } else if ((key == "EDGE_WEIGHT_TYPE" && value != "EXPLICIT") || (key == "EDGE_WEIGHT_FORMAT" && value != "FULL_MATRIX")) {
+                throw std::runtime_error("Error: Unsupported TSPLIB " + key + " '" + value + "'; only EXPLICIT FULL_MATRIX instances can be read.");
+            } else if (key == "EDGE_WEIGHT_SECTION") {
+                section = true;
+                break;
+            }
+        } while (std::getline(input, line));
+        if (!section) {
+            throw std::runtime_error("Error: TSPLIB file has no EDGE_WEIGHT_SECTION.");
+        }
+    } else {
+        std::stringstream ss(line);
+        ss >> size;  // Set the matrix size
+    }
 
     if (size <= 0) {
         throw std::runtime_error("Error: Invalid matrix size.");
     }
 
     // Allocate memory for the matrix (1D array representation)
+    resetStorage(); // Deallocate previous memory if any
     data = new int[size * size];
 
-    int row = 0;
-// Read the matrix data from the file
-if (file.is_open()) {
+    // Read the matrix data
     int totalElements = size * size; // Total number of elements in the matrix
     int index = 0; // Index for tracking position in the matrix
-
-    while (index < totalElements && file >> data[index]) {
-        // Determine which row we're currently processing
-        int row = index / size;
-        
-        // Modify the first element of the row to 0
-        if (index % size == row) {
+    while (index < totalElements && input >> data[index]) {
+        // The diagonal holds placeholders such as -1 or 9999999; a city has no cost to itself
+        if (index % size == index / size) {
             data[index] = 0;
         }
-
         ++index;
     }
+    if (index < totalElements) {
+        throw std::runtime_error("Error: The file holds " + std::to_string(index) + " of the " + std::to_string(totalElements) + " matrix entries.");
+    }
+
+    detectSymmetry();
+    detectForbiddenEdges();
+    computeFingerprint();
+}
+
+
+void Matrix::setCosts(int s, const std::vector<int>& costs) {
+    if (s <= 0 || costs.size() != static_cast<size_t>(s) * s) {
+        throw std::invalid_argument("Matrix costs must hold size * size values");
+    }
+    resetStorage();
+    size = s;
+    data = new int[size * size];
+    std::copy(costs.begin(), costs.end(), data);
+    for (int i = 0; i < size; ++i) {
+        data[i * size + i] = 0;
+    }
+
+    detectSymmetry();
+    detectForbiddenEdges();
+    computeFingerprint();
 }
 
-    file.close();
+
+void Matrix::setView(int s, const int* costs, std::function<void()> release) {
+    if (s <= 0 || costs == nullptr) {
+        throw std::invalid_argument("Matrix view needs a positive size and costs");
+    }
+    for (int i = 0; i < s; ++i) {
+        if (costs[i * s + i] != 0) {
+            throw std::invalid_argument("Matrix view needs a zero diagonal");
+        }
+    }
+    resetStorage();
+    size = s;
+    data = const_cast<int*>(costs); // Only ever read through getCost(), getRow() and the derived structures
+    releaseView = release ? std::move(release) : [] {};
+
+    detectSymmetry();
+    detectForbiddenEdges();
+    computeFingerprint();
 }
 
+bool Matrix::isView() const {
+    return static_cast<bool>(releaseView);
+}
 
 void Matrix::generateRandomMatrix(int s, int minValue, int maxValue, int symmetricity, int asymRangeMin, int asymRangeMax) {
     // Validate inputs
@@ -73,7 +231,7 @@ void Matrix::generateRandomMatrix(int s, int minValue, int maxValue, int symmetr
 
     // Set matrix size and allocate memory for it
     size = s;
-    delete[] data; // Deallocate previous memory if any
+    resetStorage(); // Deallocate previous memory if any
     data = new int[size * size]; // Allocate new memory
 
     std::random_device rd;
@@ -97,21 +255,322 @@ void Matrix::generateRandomMatrix(int s, int minValue, int maxValue, int symmetr
         }
         data[i * size + i] = -1; // Diagonal elements set to -1 (optional)
     }
+
+    detectSymmetry();
+    detectForbiddenEdges();
+    computeFingerprint();
+}
+
+void Matrix::detectForbiddenEdges() {
+    forbiddenEdgeCount = 0;
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (isForbidden(i, j)) ++forbiddenEdgeCount;
+        }
+    }
+    if (forbiddenEdgeCount == 0) {
+        return; // Dense instance, no index needed
+    }
+
+    // CSR index of the allowed edges so solvers can enumerate feasible successors directly
+    long long allowed = static_cast<long long>(size) * (size - 1) - forbiddenEdgeCount;
+    adjacencyOffsets = new int[size + 1];
+    adjacencyTargets = new int[allowed];
+    int index = 0;
+    for (int i = 0; i < size; ++i) {
+        adjacencyOffsets[i] = index;
+        for (int j = 0; j < size; ++j) {
+            if (j != i && !isForbidden(i, j)) adjacencyTargets[index++] = j;
+        }
+    }
+    adjacencyOffsets[size] = index;
+}
+
+void Matrix::computeFingerprint() {
+    if (provider != nullptr) {
+        contentHash = provider->fingerprint(); // Hashing size * size computed costs would defeat the purpose
+        return;
+    }
+
+    // FNV-1a over the size and every cost in row-major order, independent of the storage layout
+    unsigned long long hash = 14695981039346656037ULL;
+    auto mix = [&hash](int value) {
+        for (int byte = 0; byte < 4; ++byte) {
+            hash ^= static_cast<unsigned char>(value >> (8 * byte));
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(size);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            mix(getCost(i, j));
+        }
+    }
+    contentHash = hash;
+}
+
+std::string Matrix::getFingerprint() const {
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << contentHash;
+    return hex.str();
+}
+
+bool Matrix::hasForbiddenEdges() const {
+    return forbiddenEdgeCount > 0;
+}
+
+bool Matrix::isForbidden(int i, int j) const {
+    return i != j && getCost(i, j) >= FORBIDDEN_COST;
+}
+
+int Matrix::getAllowedSuccessorCount(int city) const {
+    if (adjacencyOffsets == nullptr) {
+        return 0;
+    }
+    return adjacencyOffsets[city + 1] - adjacencyOffsets[city];
+}
+
+const int* Matrix::getAllowedSuccessors(int city) const {
+    if (adjacencyOffsets == nullptr) {
+        return nullptr;
+    }
+    return adjacencyTargets + adjacencyOffsets[city];
+}
+
+int Matrix::saturateCost(long long cost) {
+    if (cost > INT_MAX) return INT_MAX;
+    if (cost < INT_MIN) return INT_MIN;
+    return static_cast<int>(cost);
+}
+
+void Matrix::detectSymmetry() {
+    for (int i = 0; i < size; ++i) {
+        for (int j = i + 1; j < size; ++j) {
+            if (data[i * size + j] != data[j * size + i]) {
+                symmetric = false;
+                return;
+            }
+        }
+    }
+    symmetric = true;
+    if (releaseView) {
+        return; // The costs are not ours to repack
+    }
+
+    // Keep only the upper triangle; row i starts at i * size - i * (i - 1) / 2
+    int* triangle = new int[size * (size + 1) / 2];
+    int index = 0;
+    for (int i = 0; i < size; ++i) {
+        for (int j = i; j < size; ++j) {
+            triangle[index++] = data[i * size + j];
+        }
+    }
+    delete[] data;
+    data = triangle;
+    packed = true;
+}
+
+void Matrix::setCostProvider(CostProvider* costProvider, int cacheRows) {
+    if (costProvider == nullptr || costProvider->getSize() <= 0) {
+        delete costProvider;
+        throw std::invalid_argument("Cost provider must describe at least one city");
+    }
+    resetStorage();
+    provider = costProvider;
+    providerId = nextProviderId++;
+    size = provider->getSize();
+    rowCacheSize = std::max(1, cacheRows);
+    symmetric = provider->isSymmetric();
+    computeFingerprint();
+}
+
+void Matrix::readCoordinatesFromFile(const std::string& filename, double directionPenalty, int cacheRows) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    int count = 0;
+    if (!(file >> count) || count <= 0) {
+        throw std::runtime_error("Error: Invalid number of cities in coordinate file.");
+    }
+
+    std::vector<double> x(count), y(count);
+    for (int i = 0; i < count; ++i) {
+        if (!(file >> x[i] >> y[i])) {
+            throw std::runtime_error("Error: Coordinate file ended after " + std::to_string(i) + " cities.");
+        }
+    }
+
+    setCostProvider(new CoordinateCostProvider(std::move(x), std::move(y), directionPenalty), cacheRows);
+}
+
+void Matrix::generateRandomCoordinates(int s, double maxCoordinate, double directionPenalty, int cacheRows) {
+    if (s < 3) {
+        throw std::invalid_argument("Size must be at least 3");
+    }
+    if (maxCoordinate <= 0) {
+        throw std::invalid_argument("Invalid maximum coordinate");
+    }
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dis(0.0, maxCoordinate);
+
+    std::vector<double> x(s), y(s);
+    for (int i = 0; i < s; ++i) {
+        x[i] = dis(gen);
+        y[i] = dis(gen);
+    }
+
+    setCostProvider(new CoordinateCostProvider(std::move(x), std::move(y), directionPenalty), cacheRows);
+}
+
+bool Matrix::isImplicit() const {
+    return provider != nullptr;
+}
+
+const int* Matrix::cachedRow(int i) const {
+    RowCache& cache = rowCache;
+    size_t rowLength = static_cast<size_t>(size);
+
+    // Rows of a different matrix are useless; start over
+    if (cache.owner != providerId) {
+        cache.owner = providerId;
+        cache.cities.assign(rowCacheSize, -1);
+        cache.lastUse.assign(rowCacheSize, 0);
+        cache.rows.assign(rowCacheSize * rowLength, 0);
+    }
+
+    ++cache.clock;
+    int victim = 0;
+    for (int slot = 0; slot < rowCacheSize; ++slot) {
+        if (cache.cities[slot] == i) {
+            cache.lastUse[slot] = cache.clock;
+            return cache.rows.data() + slot * rowLength;
+        }
+        if (cache.lastUse[slot] < cache.lastUse[victim]) {
+            victim = slot;
+        }
+    }
+
+    // Miss: materialize the row into the least recently used slot
+    int* row = cache.rows.data() + victim * rowLength;
+    for (int j = 0; j < size; ++j) {
+        row[j] = provider->getCost(i, j);
+    }
+    cache.cities[victim] = i;
+    cache.lastUse[victim] = cache.clock;
+    return row;
 }
 
 int Matrix::getCost(int i, int j) const {
+    if (provider != nullptr) {
+        return provider->getCost(i, j);
+    }
+    if (packed) {
+        if (i > j) std::swap(i, j);
+        return data[i * size - i * (i - 1) / 2 + (j - i)];
+    }
     return data[i * size + j]; // Access element in flattened matrix
 }
 
+bool Matrix::isSymmetric() const {
+    return symmetric;
+}
+
 int Matrix::getSize() const {
     return size;
 }
 
+void Matrix::buildTransposed() {
+    if (symmetric || provider != nullptr) {
+        return; // Columns equal rows, or the matrix is never materialized
+    }
+    if (transposed == nullptr) {
+        transposed = new int[size * size];
+    }
+
+    // Transpose in square tiles so both the source rows and destination rows stay in cache
+    const int tile = 32;
+    for (int ii = 0; ii < size; ii += tile) {
+        for (int jj = 0; jj < size; jj += tile) {
+            int iEnd = std::min(ii + tile, size);
+            int jEnd = std::min(jj + tile, size);
+            for (int i = ii; i < iEnd; ++i) {
+                for (int j = jj; j < jEnd; ++j) {
+                    transposed[j * size + i] = data[i * size + j];
+                }
+            }
+        }
+    }
+}
+
+bool Matrix::hasTransposed() const {
+    return transposed != nullptr;
+}
+
+const int* Matrix::getRow(int i) const {
+    if (provider != nullptr) {
+        return cachedRow(i);
+    }
+    if (packed) {
+        return nullptr;
+    }
+    return data + i * size;
+}
+
+const int* Matrix::getColumn(int j) const {
+    if (symmetric) {
+        return getRow(j);
+    }
+    if (transposed == nullptr) {
+        return nullptr;
+    }
+    return transposed + j * size;
+}
+
+void Matrix::buildCandidateLists(int k) {
+    delete candidateLists;
+    candidateLists = nullptr;
+    candidateLists = new CandidateLists(*this, k);
+}
+
+const CandidateLists* Matrix::getCandidateLists() const {
+    return candidateLists;
+}
+
 void Matrix::display() const {
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
-            std::cout << std::setw(5) << data[i * size + j] << " "; // Access element in flattened matrix
+            std::cout << std::setw(5) << getCost(i, j) << " ";
+        }
+        std::cout << '\n';
+    }
+    std::cout << std::flush;
+}
+
+void Matrix::displaySummary() const {
+    std::cout << size << " cities, " << (symmetric ? "symmetric" : "asymmetric") << ", ";
+    if (provider != nullptr) {
+        std::cout << "implicit costs";  // The cost range would require computing every cost
+    } else {
+        int minCost = INT_MAX, maxCost = INT_MIN;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                if (i == j || isForbidden(i, j)) continue;
+                int cost = getCost(i, j);
+                minCost = std::min(minCost, cost);
+                maxCost = std::max(maxCost, cost);
+            }
+        }
+        std::cout << (packed ? "packed" : "dense") << " storage";
+        if (minCost <= maxCost) {
+            std::cout << ", costs " << minCost << ".." << maxCost;
+        }
+        if (forbiddenEdgeCount > 0) {
+            std::cout << ", " << forbiddenEdgeCount << " forbidden edges";
         }
-        std::cout << std::endl;
     }
+    std::cout << ", fingerprint " << getFingerprint() << std::endl;
 }
@@ -0,0 +1,111 @@
+#include "../include/matrix_image.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char MATRIX_IMAGE_MAGIC[8] = {'A', 'T', 'S', 'P', 'M', 'A', 'T', '1'};
+
+#ifdef __linux__
+
+std::unique_ptr<Matrix> mapMatrixImage(int fd) {
+    struct stat file;
+    if (fstat(fd, &file) != 0) {
+        throw std::runtime_error(std::string("Could not inspect matrix image: ") + std::strerror(errno));
+    }
+    size_t length = static_cast<size_t>(file.st_size);
+    if (length < sizeof(MatrixImageHeader)) {
+        throw std::invalid_argument("Matrix image is shorter than its header");
+    }
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error(std::string("Could not map matrix image: ") + std::strerror(errno));
+    }
+
+    std::unique_ptr<Matrix> matrix(new Matrix(0));
+    try {
+        const MatrixImageHeader* header = static_cast<const MatrixImageHeader*>(mapping);
+        if (std::memcmp(header->magic, MATRIX_IMAGE_MAGIC, sizeof(header->magic)) != 0) {
+            throw std::invalid_argument("Not a matrix image");
+        }
+        size_t cities = header->size;
+        if (cities == 0 || cities > 46340 || header->costsOffset < sizeof(MatrixImageHeader) || header->costsOffset % alignof(int) != 0 ||
+            length < header->costsOffset + cities * cities * sizeof(int)) {
+            throw std::invalid_argument("Matrix image header does not match its length");
+        }
+        const int* costs = reinterpret_cast<const int*>(static_cast<const char*>(mapping) + header->costsOffset);
+
+        // F_SEAL_FUTURE_WRITE is not enough: a writable mapping made before it was added keeps working
+        int seals = fcntl(fd, F_GET_SEALS);
+        bool sealed = seals >= 0 && (seals & F_SEAL_SHRINK) && (seals & F_SEAL_WRITE);
+        if (sealed) {
+            matrix->setView(static_cast<int>(cities), costs, [mapping, length] { munmap(mapping, length); });
+            return matrix;
+        }
+        matrix->setCosts(static_cast<int>(cities), std::vector<int>(costs, costs + cities * cities));
+    } catch (...) {
+        if (!matrix->isView()) {
+            munmap(mapping, length);
+        }
+        throw;
+    }
+    munmap(mapping, length);
+    return matrix;
+}
+
+int createMatrixImage(const Matrix& matrix) {
+    size_t cities = static_cast<size_t>(matrix.getSize());
+    size_t length = sizeof(MatrixImageHeader) + cities * cities * sizeof(int);
+    int fd = memfd_create("atsp-matrix", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Could not create matrix image: ") + std::strerror(errno));
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(length)) == 0) {
+        mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mapping == MAP_FAILED) {
+        std::string reason = std::strerror(errno);
+        close(fd);
+        throw std::runtime_error("Could not size matrix image: " + reason);
+    }
+
+    MatrixImageHeader* header = static_cast<MatrixImageHeader*>(mapping);
+    std::memcpy(header->magic, MATRIX_IMAGE_MAGIC, sizeof(header->magic));
+    header->size = static_cast<uint32_t>(cities);
+    header->costsOffset = sizeof(MatrixImageHeader);
+    int* costs = reinterpret_cast<int*>(header + 1);
+    for (size_t i = 0; i < cities; ++i) {
+        for (size_t j = 0; j < cities; ++j) {
+            costs[i * cities + j] = i == j ? 0 : matrix.getCost(static_cast<int>(i), static_cast<int>(j));
+        }
+    }
+    munmap(mapping, length); // Writable mappings would make F_SEAL_WRITE fail
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        std::string reason = std::strerror(errno);
+        close(fd);
+        throw std::runtime_error("Could not seal matrix image: " + reason);
+    }
+    return fd;
+}
+
+#else
+
+std::unique_ptr<Matrix> mapMatrixImage(int) {
+    throw std::runtime_error("Matrix images are only available on Linux");
+}
+
+int createMatrixImage(const Matrix&) {
+    throw std::runtime_error("Matrix images are only available on Linux");
+}
+
+#endif // __linux__
@@ -0,0 +1,123 @@
+#include "../include/phase_timer.h"
+
+#ifdef ATSP_PHASE_TIMERS
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Histograms of one thread; owned by the registry so they outlive the thread
+struct ThreadPhases {
+    PhaseHistogram histograms[static_cast<int>(Phase::Count)];
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadPhases>> registry;
+thread_local ThreadPhases* threadPhases = nullptr;
+
+} // namespace
+
+void PhaseHistogram::merge(const PhaseHistogram& other) {
+    for (int b = 0; b < BUCKETS; ++b) {
+        buckets[b] += other.buckets[b];
+    }
+    count += other.count;
+    total += other.total;
+    maximum = std::max(maximum, other.maximum);
+}
+
+uint64_t PhaseHistogram::upperBoundOf(int bucket) {
+    if (bucket < 16) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int exponent = (bucket - 16) / SUB_BUCKETS + 4;
+    uint64_t sub = static_cast<uint64_t>((bucket - 16) % SUB_BUCKETS);
+    uint64_t width = 1ull << (exponent - 3);
+    return (1ull << exponent) + sub * width + width - 1; // Wraps to the largest value for the last bucket
+}
+
+uint64_t PhaseHistogram::percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * count)));
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return std::min(upperBoundOf(b), maximum);
+        }
+    }
+    return maximum;
+}
+
+PhaseHistogram& PhaseTimers::local(Phase phase) {
+    if (threadPhases == nullptr) {
+        std::unique_ptr<ThreadPhases> phases(new ThreadPhases());
+        threadPhases = phases.get();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(std::move(phases));
+    }
+    return threadPhases->histograms[static_cast<int>(phase)];
+}
+
+const char* PhaseTimers::name(Phase phase) {
+    switch (phase) {
+        case Phase::GaGenerateOffspring: return "ga.generateOffspring";
+        case Phase::GaCrossover: return "ga.crossover";
+        case Phase::GaMutation: return "ga.mutation";
+        case Phase::GaFitness: return "ga.fitness";
+        case Phase::GaSelection: return "ga.selection";
+        case Phase::TabuNeighbourhood: return "tabu.neighbourhood";
+        case Phase::TabuCheck: return "tabu.tabuCheck";
+        default: return "?";
+    }
+}
+
+void PhaseTimers::report(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    PhaseHistogram merged[static_cast<int>(Phase::Count)];
+    for (const std::unique_ptr<ThreadPhases>& phases : registry) {
+        for (int p = 0; p < static_cast<int>(Phase::Count); ++p) {
+            merged[p].merge(phases->histograms[p]);
+        }
+    }
+
+    // Nested phases follow their parent, indented; fitness is printed after the selection that contains it
+    const std::pair<Phase, bool> order[] = {{Phase::GaGenerateOffspring, false}, {Phase::GaCrossover, true}, {Phase::GaMutation, true},
+                                            {Phase::GaSelection, false}, {Phase::GaFitness, true},
+                                            {Phase::TabuNeighbourhood, false}, {Phase::TabuCheck, true}};
+    std::ostringstream table; // Formatted locally so the caller's stream keeps its flags and precision
+    table << "Phase timings over " << registry.size() << " thread(s), percentiles in ns:" << std::endl;
+    table << std::left << std::setw(22) << "phase" << std::right << std::setw(12) << "calls" << std::setw(12) << "total ms"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+        << std::setw(12) << "max" << std::endl;
+    for (const std::pair<Phase, bool>& entry : order) {
+        const PhaseHistogram& histogram = merged[static_cast<int>(entry.first)];
+        if (histogram.count == 0) {
+            continue;
+        }
+        table << std::left << std::setw(22) << (std::string(entry.second ? "  " : "") + name(entry.first)) << std::right << std::setw(12) << histogram.count << std::setw(12)
+            << std::fixed << std::setprecision(2) << histogram.total / 1e6 << std::setw(10) << std::setprecision(0)
+            << static_cast<double>(histogram.total) / histogram.count << std::setw(10) << histogram.percentile(0.5) << std::setw(10)
+            << histogram.percentile(0.9) << std::setw(10) << histogram.percentile(0.99) << std::setw(12) << histogram.maximum << std::endl;
+    }
+    out << table.str() << std::flush;
+}
+
+void PhaseTimers::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ThreadPhases>& phases : registry) {
+        *phases = ThreadPhases();
+    }
+}
+
+#endif // ATSP_PHASE_TIMERS
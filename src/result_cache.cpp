@@ -0,0 +1,213 @@
+#include "../include/result_cache.h"
+#include "../include/logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const ENTRY_MAGIC = "ATSPCACHE 1";
+const char* const ENTRY_EXTENSION = ".res";
+const char* const TEMPORARY_INFIX = ".res.tmp.";
+
+// Writing an entry takes milliseconds, so an older temporary was left behind by a crashed writer
+const std::chrono::hours STALE_TEMPORARY_AGE(1);
+
+// FNV-1a of the parameter string, so that arbitrary parameters map to a short file name
+std::string hashParameters(const std::string& parameters) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char c : parameters) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
+
+// Random suffix that keeps temporary files of concurrent writers apart
+std::string temporarySuffix() {
+    static thread_local std::mt19937_64 gen(std::random_device{}());
+    std::ostringstream hex;
+    hex << ".tmp." << std::hex << gen();
+    return hex.str();
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string& directory, unsigned long long maxBytes)
+    : directory(directory), maxBytes(maxBytes) {
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error || !fs::is_directory(directory)) {
+        throw std::runtime_error("Could not create result cache directory: " + directory);
+    }
+    removeStaleTemporaries();
+}
+
+void ResultCache::removeStaleTemporaries() {
+    fs::file_time_type now = fs::file_time_type::clock::now();
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, error);
+    for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+        if (it->path().filename().string().find(TEMPORARY_INFIX) == std::string::npos) continue;
+        std::error_code ignored;
+        fs::file_time_type modified = it->last_write_time(ignored);
+        if (!ignored && now - modified > STALE_TEMPORARY_AGE) {
+            fs::remove(it->path(), ignored);
+        }
+    }
+}
+
+std::string ResultCache::entryPath(const Matrix& matrix, const std::string& solver, const std::string& parameters) const {
+    return (fs::path(directory) / matrix.getFingerprint() / (solver + "-" + hashParameters(parameters) + ENTRY_EXTENSION)).string();
+}
+
+bool ResultCache::readEntry(const std::string& path, const Matrix& matrix, CachedResult& result) const {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line, fingerprint, exact;
+    int size = 0;
+    CachedResult entry;
+    if (!std::getline(file, line) || line != ENTRY_MAGIC) return false;
+    if (!std::getline(file, fingerprint) || !std::getline(file, entry.solver) || !std::getline(file, entry.parameters)) return false;
+    if (!(file >> exact >> entry.cost >> size)) return false;
+    if (fingerprint != matrix.getFingerprint() || size != matrix.getSize()) return false;
+
+    entry.exact = exact == "exact";
+    entry.tour.resize(size);
+    std::vector<bool> seen(size, false);
+    for (int& city : entry.tour) {
+        // Reject truncated files and anything that is not a permutation
+        if (!(file >> city) || city < 0 || city >= size || seen[city]) return false;
+        seen[city] = true;
+    }
+
+    result = std::move(entry);
+    return true;
+}
+
+bool ResultCache::lookup(const Matrix& matrix, const std::string& solver, const std::string& parameters, CachedResult& result) {
+    std::string path = entryPath(matrix, solver, parameters);
+    CachedResult entry;
+    if (!readEntry(path, matrix, entry) || entry.solver != solver || entry.parameters != parameters) {
+        return false;
+    }
+
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error); // Mark as recently used
+    result = std::move(entry);
+    return true;
+}
+
+void ResultCache::store(const Matrix& matrix, const CachedResult& result) {
+    if (static_cast<int>(result.tour.size()) != matrix.getSize()) {
+        throw std::invalid_argument("Cached tour must visit every city exactly once");
+    }
+
+    std::string path = entryPath(matrix, result.solver, result.parameters);
+    std::string temporary = path + temporarySuffix();
+    std::error_code error;
+    fs::create_directories(fs::path(path).parent_path(), error);
+
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << ENTRY_MAGIC << '\n'
+             << matrix.getFingerprint() << '\n'
+             << result.solver << '\n'
+             << result.parameters << '\n'
+             << (result.exact ? "exact" : "heuristic") << ' ' << result.cost << ' ' << matrix.getSize() << '\n';
+        for (size_t i = 0; i < result.tour.size(); ++i) {
+            file << result.tour[i] << (i + 1 < result.tour.size() ? ' ' : '\n');
+        }
+        file.close();
+        if (!file) {
+            LOG_WARNING("could not write result cache entry " << temporary);
+            fs::remove(temporary, error);
+            return;
+        }
+    }
+
+    // Renaming over an existing entry is atomic, so readers see either the old or the new file
+    fs::rename(temporary, path, error);
+    if (error) {
+        LOG_WARNING("could not store result cache entry " << path << ": " << error.message());
+        fs::remove(temporary, error);
+        return;
+    }
+
+    if (maxBytes > 0) {
+        evict();
+    }
+}
+
+bool ResultCache::bestKnownTour(const Matrix& matrix, CachedResult& result) {
+    std::error_code error;
+    fs::directory_iterator it(fs::path(directory) / matrix.getFingerprint(), error);
+    if (error) {
+        return false;
+    }
+
+    bool found = false;
+    for (; it != fs::directory_iterator(); it.increment(error)) {
+        if (error) break;
+        if (it->path().extension() != ENTRY_EXTENSION) continue;
+        CachedResult entry;
+        if (readEntry(it->path().string(), matrix, entry) && (!found || entry.cost < result.cost)) {
+            result = std::move(entry);
+            found = true;
+        }
+    }
+    return found;
+}
+
+void ResultCache::evict() {
+    struct Entry {
+        fs::path path;
+        unsigned long long bytes;
+        fs::file_time_type lastUse;
+    };
+
+    std::vector<Entry> entries;
+    unsigned long long total = 0;
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, error);
+    for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_regular_file(error) || it->path().extension() != ENTRY_EXTENSION) continue;
+        Entry entry{it->path(), it->file_size(error), it->last_write_time(error)};
+        if (error) {
+            error.clear(); // Removed by a concurrent process in the meantime
+            continue;
+        }
+        total += entry.bytes;
+        entries.push_back(entry);
+    }
+    if (total <= maxBytes) {
+        return;
+    }
+
+    // Evict down to 90% of the bound so that stores near the limit do not evict one entry each
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    unsigned long long target = maxBytes / 10 * 9;
+    for (const Entry& entry : entries) {
+        if (total <= target) break;
+        if (fs::remove(entry.path, error)) {
+            total -= entry.bytes;
+            fs::remove(entry.path.parent_path(), error); // Only succeeds once the instance directory is empty
+        }
+        error.clear();
+    }
+}
@@ -0,0 +1,220 @@
+#include "../include/result_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#define ATSP_FSYNC(fd) _commit(fd)
+#define ATSP_FILENO(file) _fileno(file)
+#else
+#include <unistd.h>
+#define ATSP_FSYNC(fd) fsync(fd)
+#define ATSP_FILENO(file) fileno(file)
+#endif
+
+namespace {
+
+const char FILE_MAGIC[8] = {'A', 'T', 'S', 'P', 'C', 'O', 'L', '1'};
+const char BLOCK_MAGIC[4] = {'B', 'L', 'K', '1'};
+const size_t NAME_LENGTH = 32;
+
+// Schema of the store; numeric() returns the value used for the column data and statistics
+struct ColumnSpec {
+    const char* name;
+    ColumnarResultStore::ColumnType type;
+    double (*numeric)(const ResultRecord&);
+};
+
+const ColumnSpec COLUMNS[] = {
+    {"algoName", ColumnarResultStore::String8, nullptr},
+    {"kind", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.kind); }},
+    {"problemSize", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.problemSize); }},
+    {"time", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.time); }},
+    {"bestCost", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.bestCost); }},
+    {"populationSize", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.populationSize); }},
+    {"mutationRate", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.mutationRate); }},
+    {"randomRate", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.randomRate); }},
+    {"crossoverRate", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.crossoverRate); }},
+    {"mutationType", ColumnarResultStore::Char, [](const ResultRecord& r) { return static_cast<double>(r.mutationType); }},
+    {"iterationNum", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.iterationNum); }},
+    {"crossingSegmentSizeRate", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.crossingSegmentSizeRate); }},
+    {"mutationSegmentSizeRate", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.mutationSegmentSizeRate); }},
+    {"randomRateNewGen", ColumnarResultStore::Float32, [](const ResultRecord& r) { return static_cast<double>(r.randomRateNewGen); }},
+    {"sweepPoint", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.sweepPoint); }},
+    {"tabuSize", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.tabuSize); }},
+    {"maxIterations", ColumnarResultStore::Int32, [](const ResultRecord& r) { return static_cast<double>(r.maxIterations); }},
+    {"nodesExpanded", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.nodesExpanded); }},
+    {"nodesPruned", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.nodesPruned); }},
+    {"movesEvaluated", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.movesEvaluated); }},
+    {"tabuRejected", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.tabuRejected); }},
+    {"crossovers", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.crossovers); }},
+    {"mutations", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.mutations); }},
+    {"duplicateOffspring", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.duplicateOffspring); }},
+    {"diversityRetries", ColumnarResultStore::Int64, [](const ResultRecord& r) { return static_cast<double>(r.counters.diversityRetries); }},
+    {"nodesExpandedPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.nodesExpanded, r.time); }},
+    {"nodesPrunedPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.nodesPruned, r.time); }},
+    {"movesEvaluatedPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.movesEvaluated, r.time); }},
+    {"tabuRejectedPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.tabuRejected, r.time); }},
+    {"crossoversPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.crossovers, r.time); }},
+    {"mutationsPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.mutations, r.time); }},
+    {"duplicateOffspringPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.duplicateOffspring, r.time); }},
+    {"diversityRetriesPerSec", ColumnarResultStore::Float32, [](const ResultRecord& r) { return SearchCounters::perSecond(r.counters.diversityRetries, r.time); }},
+};
+
+const uint32_t COLUMN_COUNT = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+size_t widthOf(ColumnarResultStore::ColumnType type) {
+    switch (type) {
+        case ColumnarResultStore::Int32: return 4;
+        case ColumnarResultStore::Float32: return 4;
+        case ColumnarResultStore::Char: return 1;
+        case ColumnarResultStore::String8: return 8;
+        case ColumnarResultStore::Int64: return 8;
+    }
+    return 0;
+}
+
+// Serialized header for the current schema
+std::vector<unsigned char> schemaHeader() {
+    std::vector<unsigned char> header(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    const unsigned char* count = reinterpret_cast<const unsigned char*>(&COLUMN_COUNT);
+    header.insert(header.end(), count, count + sizeof(COLUMN_COUNT));
+    for (const ColumnSpec& column : COLUMNS) {
+        char name[NAME_LENGTH] = {};
+        std::strncpy(name, column.name, NAME_LENGTH - 1);
+        header.insert(header.end(), name, name + NAME_LENGTH);
+        header.push_back(column.type);
+        header.insert(header.end(), 3, 0);
+    }
+    header.resize((header.size() + 7) & ~static_cast<size_t>(7), 0); // Blocks start 8-byte aligned
+    return header;
+}
+
+void writeBytes(std::FILE* file, const void* bytes, size_t length, const std::string& path) {
+    if (length > 0 && std::fwrite(bytes, 1, length, file) != length) {
+        throw std::runtime_error("Could not write to file: " + path);
+    }
+}
+
+} // namespace
+
+ColumnarResultStore::ColumnarResultStore(const std::string& path) : data(nullptr), index(nullptr), path(path) {
+    std::vector<unsigned char> header = schemaHeader();
+
+    // An existing store must have been written with the same schema
+    if (std::FILE* existing = std::fopen(path.c_str(), "rb")) {
+        std::vector<unsigned char> found(header.size());
+        size_t read = std::fread(found.data(), 1, found.size(), existing);
+        std::fclose(existing);
+        if (read != 0 && (read != found.size() || found != header)) {
+            throw std::runtime_error("Result store has a different schema: " + path);
+        }
+    }
+
+    data = std::fopen(path.c_str(), "ab");
+    if (data == nullptr) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    index = std::fopen((path + ".idx").c_str(), "ab");
+    if (index == nullptr) {
+        std::fclose(data);
+        throw std::runtime_error("Could not open file: " + path + ".idx");
+    }
+
+    std::fseek(data, 0, SEEK_END);
+    if (std::ftell(data) == 0) {
+        writeBytes(data, header.data(), header.size(), path);
+    }
+}
+
+ColumnarResultStore::~ColumnarResultStore() {
+    std::fclose(data);
+    std::fclose(index);
+}
+
+void ColumnarResultStore::append(const std::vector<const ResultRecord*>& records) {
+    if (records.empty()) {
+        return;
+    }
+    uint32_t rows = static_cast<uint32_t>(records.size());
+
+    // Build the whole block in memory so it is written with a single call
+    std::vector<unsigned char> block(BLOCK_MAGIC, BLOCK_MAGIC + sizeof(BLOCK_MAGIC));
+    const unsigned char* rowBytes = reinterpret_cast<const unsigned char*>(&rows);
+    block.insert(block.end(), rowBytes, rowBytes + sizeof(rows));
+
+    size_t statsOffset = block.size();
+    block.resize(block.size() + COLUMN_COUNT * 2 * sizeof(double));
+
+    for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+        const ColumnSpec& column = COLUMNS[c];
+        double minimum = 0, maximum = 0;
+        size_t start = block.size();
+        block.resize(start + rows * widthOf(column.type));
+        unsigned char* out = block.data() + start;
+
+        if (column.numeric == nullptr) {
+            // Strings carry no statistics (min = max = 0); readers must not prune blocks on them
+            for (uint32_t r = 0; r < rows; ++r) {
+                std::strncpy(reinterpret_cast<char*>(out + r * 8), records[r]->algoName.c_str(), 8);
+            }
+        } else {
+            minimum = std::numeric_limits<double>::max();
+            maximum = std::numeric_limits<double>::lowest();
+            for (uint32_t r = 0; r < rows; ++r) {
+                double value = column.numeric(*records[r]);
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+                if (column.type == Int32) {
+                    int32_t v = static_cast<int32_t>(value);
+                    std::memcpy(out + r * 4, &v, 4);
+                } else if (column.type == Float32) {
+                    float v = static_cast<float>(value);
+                    std::memcpy(out + r * 4, &v, 4);
+                } else if (column.type == Int64) {
+                    int64_t v = static_cast<int64_t>(value);
+                    std::memcpy(out + r * 8, &v, 8);
+                } else {
+                    out[r] = static_cast<unsigned char>(value);
+                }
+            }
+        }
+        std::memcpy(block.data() + statsOffset + c * 2 * sizeof(double), &minimum, sizeof(double));
+        std::memcpy(block.data() + statsOffset + (c * 2 + 1) * sizeof(double), &maximum, sizeof(double));
+
+        // Keep every column 8-byte aligned relative to the block start
+        block.resize((block.size() + 7) & ~static_cast<size_t>(7), 0);
+    }
+
+    std::fseek(data, 0, SEEK_END);
+    uint64_t offset = static_cast<uint64_t>(std::ftell(data));
+    writeBytes(data, block.data(), block.size(), path);
+
+    uint32_t reserved = 0;
+    unsigned char entry[16];
+    std::memcpy(entry, &offset, 8);
+    std::memcpy(entry + 8, &rows, 4);
+    std::memcpy(entry + 12, &reserved, 4);
+    writeBytes(index, entry, sizeof(entry), path + ".idx");
+}
+
+void ColumnarResultStore::flush(bool sync) {
+    std::fflush(data);
+    std::fflush(index);
+    if (sync) {
+        ATSP_FSYNC(ATSP_FILENO(data));
+        ATSP_FSYNC(ATSP_FILENO(index));
+    }
+}
+
+std::string ColumnarResultStore::storePathFor(const std::string& csvPath) {
+    const std::string extension = ".csv";
+    if (csvPath.size() >= extension.size() &&
+        csvPath.compare(csvPath.size() - extension.size(), extension.size(), extension) == 0) {
+        return csvPath.substr(0, csvPath.size() - extension.size()) + ".atspcol";
+    }
+    return csvPath + ".atspcol";
+}
@@ -0,0 +1,226 @@
+#include "../include/results_writer.h"
+#include "../include/result_store.h"
+
+#include <chrono>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#define ATSP_FSYNC(fd) _commit(fd)
+#define ATSP_FILENO(file) _fileno(file)
+#else
+#include <unistd.h>
+#define ATSP_FSYNC(fd) fsync(fd)
+#define ATSP_FILENO(file) fileno(file)
+#endif
+
+std::string ResultRecord::toCsv() const {
+    std::ostringstream line;
+    line << algoName << "," << problemSize << "," << time;
+    if (kind == Kind::Tabu) {
+        line << "," << bestCost;
+    } else if (kind == Kind::Genetic || kind == Kind::Sweep) {
+        line << "," << bestCost;
+        if (kind == Kind::Sweep) {
+            line << "," << sweepPoint;
+        }
+        line << "," << populationSize << "," << mutationRate << "," << randomRate << ","
+             << crossoverRate << "," << mutationType << "," << iterationNum << "," << crossingSegmentSizeRate << ","
+             << mutationSegmentSizeRate << "," << randomRateNewGen;
+        if (kind == Kind::Sweep) {
+            line << "," << tabuSize << "," << maxIterations;
+        }
+    }
+    return line.str();
+}
+
+ResultsWriter& ResultsWriter::instance() {
+    static ResultsWriter writer;
+    return writer;
+}
+
+ResultsWriter::ResultsWriter()
+    : stopping(false), pending(0), maxBatchSize(256), flushIntervalMs(100),
+      fsyncPolicy(FsyncPolicy::OnClose), csvOutput(true), columnarOutput(false) {
+    worker = std::thread(&ResultsWriter::run, this);
+}
+
+ResultsWriter::~ResultsWriter() {
+    stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake.notify_one();
+    }
+    worker.join();
+
+    // Everything is drained; close the files
+    for (auto& entry : files) {
+        std::fflush(entry.second);
+        if (fsyncPolicy.load() != FsyncPolicy::Never) {
+            ATSP_FSYNC(ATSP_FILENO(entry.second));
+        }
+        std::fclose(entry.second);
+    }
+    for (auto& entry : stores) {
+        entry.second->flush(fsyncPolicy.load() != FsyncPolicy::Never);
+    }
+}
+
+void ResultsWriter::configure(FsyncPolicy policy, int batchSize, int intervalMs) {
+    fsyncPolicy.store(policy);
+    maxBatchSize.store(batchSize > 0 ? batchSize : 1);
+    flushIntervalMs.store(intervalMs > 0 ? intervalMs : 1);
+}
+
+void ResultsWriter::setFormats(bool csv, bool columnar) {
+    csvOutput.store(csv);
+    columnarOutput.store(columnar);
+}
+
+ResultsWriter::FsyncPolicy ResultsWriter::parseFsyncPolicy(const std::string& name) {
+    if (name == "never") return FsyncPolicy::Never;
+    if (name == "batch") return FsyncPolicy::EveryBatch;
+    if (name == "close") return FsyncPolicy::OnClose;
+    throw std::runtime_error("Invalid fsync policy '" + name + "'. Must be 'never', 'batch' or 'close'.");
+}
+
+void ResultsWriter::write(ResultRecord record) {
+    Entry entry;
+    entry.record = std::move(record);
+    queue.push(std::move(entry));
+
+    // Only wake the writer early once a full batch is waiting; otherwise it wakes on its interval
+    if (pending.fetch_add(1, std::memory_order_relaxed) + 1 == maxBatchSize.load(std::memory_order_relaxed)) {
+        wake.notify_one();
+    }
+}
+
+void ResultsWriter::flush() {
+    // A marker follows every record pushed before it. Tickets are taken and markers pushed under the mutex, so
+    // markers are queued in ticket order and reaching one ticket means every earlier marker was passed as well.
+    std::unique_lock<std::mutex> lock(mutex);
+    Entry marker;
+    marker.flushTicket = ++flushTickets;
+    unsigned long long ticket = marker.flushTicket;
+    queue.push(std::move(marker));
+    wake.notify_one();
+    progress.wait(lock, [this, ticket] { return flushedTicket >= ticket; });
+
+    if (!lastError.empty()) {
+        std::string error = lastError;
+        lastError.clear();
+        throw std::runtime_error(error);
+    }
+}
+
+void ResultsWriter::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, std::chrono::milliseconds(flushIntervalMs.load()));
+        }
+        bool finalPass = stopping.load();
+        pending.store(0, std::memory_order_relaxed);
+
+        unsigned long long ticket = drain();
+        if (ticket > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushedTicket = ticket;
+            progress.notify_all();
+        }
+
+        // Records pushed before stopping was observed are drained by this last pass
+        if (finalPass) {
+            break;
+        }
+    }
+}
+
+unsigned long long ResultsWriter::drain() {
+    std::vector<ResultRecord> batch;
+    unsigned long long ticket = 0;
+    Entry entry;
+    while (queue.pop(entry)) {
+        if (entry.flushTicket > 0) {
+            ticket = entry.flushTicket; // Confirmed once the records before it are written below
+        } else {
+            batch.push_back(std::move(entry.record));
+        }
+    }
+
+    if (!batch.empty() && csvOutput.load()) {
+        writeCsv(batch);
+    }
+    if (!batch.empty() && columnarOutput.load()) {
+        writeColumnar(batch);
+    }
+    return ticket;
+}
+
+void ResultsWriter::writeCsv(const std::vector<ResultRecord>& batch) {
+    std::set<std::FILE*> touched;
+    for (const ResultRecord& record : batch) {
+        std::FILE* file = fileFor(record.resultPath);
+        if (file == nullptr) {
+            continue;
+        }
+        std::string line = record.toCsv();
+        line += '\n';
+        if (std::fwrite(line.data(), 1, line.size(), file) != line.size()) {
+            reportError("Could not write to file: " + record.resultPath);
+        }
+        touched.insert(file);
+    }
+
+    // One flush (and optionally fsync) per file per batch instead of one per record
+    for (std::FILE* file : touched) {
+        std::fflush(file);
+        if (fsyncPolicy.load() == FsyncPolicy::EveryBatch) {
+            ATSP_FSYNC(ATSP_FILENO(file));
+        }
+    }
+}
+
+void ResultsWriter::writeColumnar(const std::vector<ResultRecord>& batch) {
+    // Group the batch by store so each store receives one block
+    std::map<std::string, std::vector<const ResultRecord*>> groups;
+    for (const ResultRecord& record : batch) {
+        groups[ColumnarResultStore::storePathFor(record.resultPath)].push_back(&record);
+    }
+
+    for (auto& group : groups) {
+        try {
+            auto it = stores.find(group.first);
+            if (it == stores.end()) {
+                it = stores.emplace(group.first, std::unique_ptr<ColumnarResultStore>(new ColumnarResultStore(group.first))).first;
+            }
+            it->second->append(group.second);
+            it->second->flush(fsyncPolicy.load() == FsyncPolicy::EveryBatch);
+        } catch (const std::exception& e) {
+            reportError(e.what());
+        }
+    }
+}
+
+void ResultsWriter::reportError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lastError.empty()) lastError = error;
+}
+
+std::FILE* ResultsWriter::fileFor(const std::string& path) {
+    auto it = files.find(path);
+    if (it != files.end()) {
+        return it->second;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "a");
+    if (file == nullptr) {
+        reportError("Could not open file: " + path);
+        return nullptr;
+    }
+    files[path] = file;
+    return file;
+}
@@ -0,0 +1,177 @@
+#include "../include/scheduler.h"
+#include "../include/logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// Reads one integer from a sysfs topology file, -1 if unavailable
+int readTopology(int cpu, const char* name) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+    int value = -1;
+    file >> value;
+    return file ? value : -1;
+}
+#endif
+
+} // namespace
+
+ExperimentScheduler::ExperimentScheduler(int workers, Isolation isolation, bool pinThreads) {
+    int physicalCores = 0;
+    std::vector<int> available = detectCpus(physicalCores);
+    if (isolation == Isolation::Physical) {
+        available.resize(physicalCores); // Leave the sibling hyper-threads idle
+    }
+
+    int limit = static_cast<int>(available.size());
+    workerCount = workers > 0 ? workers : limit;
+    if (workerCount > limit) {
+        LOG_WARNING("requested " << workers << " workers but only " << limit << " CPUs are available in "
+                    << (isolation == Isolation::Physical ? "physical" : "throughput") << " mode, using " << limit);
+        workerCount = limit;
+    }
+    if (pinThreads) {
+        cpus.assign(available.begin(), available.begin() + workerCount);
+    }
+}
+
+ExperimentScheduler::Isolation ExperimentScheduler::parseIsolation(const std::string& name) {
+    if (name == "physical") return Isolation::Physical;
+    if (name == "throughput") return Isolation::Throughput;
+    throw std::runtime_error("Invalid scheduler isolation '" + name + "'. Must be 'physical' or 'throughput'.");
+}
+
+int ExperimentScheduler::getWorkerCount() const {
+    return workerCount;
+}
+
+std::vector<int> ExperimentScheduler::detectCpus(int& physicalCores) {
+    std::vector<int> logical;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) logical.push_back(cpu);
+        }
+    }
+#endif
+    if (logical.empty()) {
+        int count = std::max(1u, std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < count; ++cpu) logical.push_back(cpu);
+    }
+
+    // Group hyper-thread siblings by (package, core); without topology information every CPU is its own core
+    std::map<std::pair<int, int>, std::vector<int>> cores;
+    std::vector<std::pair<int, int>> coreOrder;
+    for (int cpu : logical) {
+        std::pair<int, int> key(-1, cpu);
+#ifdef __linux__
+        int package = readTopology(cpu, "physical_package_id");
+        int core = readTopology(cpu, "core_id");
+        if (package >= 0 && core >= 0) key = std::make_pair(package, core);
+#endif
+        if (cores[key].empty()) coreOrder.push_back(key);
+        cores[key].push_back(cpu);
+    }
+    physicalCores = static_cast<int>(coreOrder.size());
+
+    // First thread of every core, then the second of every core, ...
+    std::vector<int> ordered;
+    for (size_t sibling = 0; ordered.size() < logical.size(); ++sibling) {
+        for (const auto& key : coreOrder) {
+            if (sibling < cores[key].size()) ordered.push_back(cores[key][sibling]);
+        }
+    }
+    return ordered;
+}
+
+void ExperimentScheduler::submit(ExperimentJob job) {
+    jobs.push_back(std::move(job));
+}
+
+void ExperimentScheduler::run() {
+    std::stable_sort(jobs.begin(), jobs.end(), [](const ExperimentJob& a, const ExperimentJob& b) { return a.priority > b.priority; });
+    nextJob = 0;
+    finishedJobs = 0;
+    failed = false;
+    firstError = nullptr;
+    startTime = std::chrono::steady_clock::now();
+
+#ifdef __linux__
+    // The calling thread is pinned while it works as worker 0 and gets its old affinity back afterwards
+    cpu_set_t callerCpus;
+    bool restoreAffinity = !cpus.empty() && pthread_getaffinity_np(pthread_self(), sizeof(callerCpus), &callerCpus) == 0;
+#endif
+
+    LOG_INFO("Scheduling " << jobs.size() << " jobs on " << workerCount << " workers" << (cpus.empty() ? "" : " (pinned)"));
+    std::vector<std::thread> workers;
+    for (int worker = 1; worker < workerCount; ++worker) {
+        workers.emplace_back(&ExperimentScheduler::work, this, worker);
+    }
+    work(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+#ifdef __linux__
+    if (restoreAffinity) {
+        pthread_setaffinity_np(pthread_self(), sizeof(callerCpus), &callerCpus);
+    }
+#endif
+
+    jobs.clear();
+    Logger::instance().flush();
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+void ExperimentScheduler::work(int worker) {
+#ifdef __linux__
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[worker], &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            LOG_WARNING("could not pin worker " << worker << " to CPU " << cpus[worker]);
+        }
+    }
+#endif
+
+    for (;;) {
+        size_t index = nextJob.fetch_add(1);
+        if (index >= jobs.size() || failed.load()) {
+            break;
+        }
+        try {
+            std::string summary = jobs[index].run();
+            reportProgress(jobs[index], summary);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            if (!firstError) firstError = std::current_exception();
+            failed = true;
+        }
+    }
+}
+
+void ExperimentScheduler::reportProgress(const ExperimentJob& job, const std::string& summary) {
+    std::lock_guard<std::mutex> lock(progressMutex);
+    ++finishedJobs;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    double remaining = elapsed / finishedJobs * (jobs.size() - finishedJobs);
+    LOG_INFO("[" << finishedJobs << "/" << jobs.size() << "] " << job.label << ": " << summary << std::fixed << std::setprecision(1)
+             << " (elapsed " << elapsed << " s, remaining ~" << remaining << " s)");
+}
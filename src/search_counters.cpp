@@ -0,0 +1,62 @@
+#include "../include/search_counters.h"
+
+namespace {
+
+// Name of every counter in SolveResult::stats
+struct CounterField {
+    const char* name;
+    unsigned long long SearchCounters::*field;
+};
+
+const CounterField FIELDS[] = {
+    {"nodesExpanded", &SearchCounters::nodesExpanded},
+    {"nodesPruned", &SearchCounters::nodesPruned},
+    {"movesEvaluated", &SearchCounters::movesEvaluated},
+    {"tabuRejected", &SearchCounters::tabuRejected},
+    {"crossovers", &SearchCounters::crossovers},
+    {"mutations", &SearchCounters::mutations},
+    {"duplicateOffspring", &SearchCounters::duplicateOffspring},
+    {"diversityRetries", &SearchCounters::diversityRetries},
+};
+
+} // namespace
+
+SearchCounters& SearchCounters::operator+=(const SearchCounters& other) {
+    for (const CounterField& counter : FIELDS) {
+        this->*counter.field += other.*counter.field;
+    }
+    return *this;
+}
+
+void SearchCounters::writeTo(std::map<std::string, unsigned long long>& stats) const {
+    for (const CounterField& counter : FIELDS) {
+        if (this->*counter.field != 0) {
+            stats[counter.name] = this->*counter.field;
+        }
+    }
+}
+
+SearchCounters SearchCounters::fromStats(const std::map<std::string, unsigned long long>& stats) {
+    SearchCounters counters;
+    for (const CounterField& counter : FIELDS) {
+        auto it = stats.find(counter.name);
+        if (it != stats.end()) {
+            counters.*counter.field = it->second;
+        }
+    }
+    return counters;
+}
+
+bool SearchCounters::isCounter(const std::string& stat) {
+    std::string name = stat.substr(stat.rfind('.') + 1); // npos + 1 == 0 keeps unprefixed names whole
+    for (const CounterField& counter : FIELDS) {
+        if (name == counter.name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double SearchCounters::perSecond(unsigned long long count, double milliseconds) {
+    return milliseconds > 0 ? count * 1000.0 / milliseconds : 0;
+}
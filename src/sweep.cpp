@@ -0,0 +1,233 @@
+#include "../include/sweep.h"
+#include "../include/Algorithms/GeneticAlgo.h"
+#include "../include/logger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+ParameterSweep::ParameterSweep(const nlohmann::json& specification)
+    : solver(specification.value("solver", std::string("ga"))),
+      method(parseMethod(specification.value("method", std::string("grid")))),
+      samples(specification.value("samples", 1)),
+      seed(specification.value("seed", 0u)) {
+    if (!SolverRegistry::instance().contains(solver)) {
+        throw std::runtime_error("Sweep solver '" + solver + "' is not registered");
+    }
+    if (samples < 1) {
+        throw std::runtime_error("Sweep 'samples' must be at least 1");
+    }
+    nlohmann::json parameters = specification.value("parameters", nlohmann::json::object());
+    if (!parameters.is_object() || parameters.empty()) {
+        throw std::runtime_error("Sweep needs a non-empty 'parameters' object");
+    }
+
+    for (const auto& item : parameters.items()) {
+        SweepDimension dimension;
+        dimension.name = item.key();
+        const nlohmann::json& value = item.value();
+        if (value.is_array()) {
+            dimension.values.assign(value.begin(), value.end());
+        } else if (value.is_object() && value.contains("min") && value.contains("max")) {
+            const nlohmann::json& low = value.at("min");
+            const nlohmann::json& high = value.at("max");
+            dimension.low = low.get<double>();
+            dimension.high = high.get<double>();
+            dimension.integer = value.value("integer", low.is_number_integer() && high.is_number_integer());
+            if (dimension.high < dimension.low) {
+                throw std::runtime_error("Sweep range of '" + dimension.name + "' has max < min");
+            }
+            if (method == Method::Grid) {
+                double step = value.value("step", 0.0);
+                if (step <= 0) {
+                    throw std::runtime_error("Grid sweep range of '" + dimension.name + "' needs a positive 'step'");
+                }
+                // The tolerance keeps the upper end despite rounding in the accumulated steps
+                for (double x = dimension.low; x <= dimension.high + step * 1e-9; x += step) {
+                    dimension.values.push_back(dimension.integer ? nlohmann::json(static_cast<long long>(std::llround(x))) : nlohmann::json(x));
+                }
+            } else {
+                dimension.range = true;
+            }
+        } else {
+            throw std::runtime_error("Sweep parameter '" + dimension.name + "' must be a list of values or a {\"min\", \"max\"} range");
+        }
+        if (!dimension.range && dimension.values.empty()) {
+            throw std::runtime_error("Sweep parameter '" + dimension.name + "' has no values");
+        }
+        dimensions.push_back(std::move(dimension));
+    }
+
+    if (method == Method::Grid) {
+        expandGrid();
+    } else {
+        int count = specification.value("points", 10);
+        if (count < 1) {
+            throw std::runtime_error("Sweep 'points' must be at least 1");
+        }
+        sample(count);
+    }
+}
+
+ParameterSweep::Method ParameterSweep::parseMethod(const std::string& name) {
+    if (name == "grid") return Method::Grid;
+    if (name == "random") return Method::Random;
+    if (name == "lhs") return Method::LatinHypercube;
+    throw std::runtime_error("Invalid sweep method '" + name + "'. Must be 'grid', 'random' or 'lhs'.");
+}
+
+const std::vector<nlohmann::json>& ParameterSweep::getPoints() const {
+    return points;
+}
+
+const std::string& ParameterSweep::getSolver() const {
+    return solver;
+}
+
+int ParameterSweep::getSamples() const {
+    return samples;
+}
+
+void ParameterSweep::expandGrid() {
+    // Odometer over the value lists; the last parameter changes fastest
+    std::vector<size_t> digits(dimensions.size(), 0);
+    while (true) {
+        nlohmann::json point = nlohmann::json::object();
+        for (size_t d = 0; d < dimensions.size(); ++d) {
+            point[dimensions[d].name] = dimensions[d].values[digits[d]];
+        }
+        points.push_back(std::move(point));
+
+        size_t d = dimensions.size();
+        while (d > 0 && ++digits[d - 1] == dimensions[d - 1].values.size()) {
+            digits[--d] = 0;
+        }
+        if (d == 0) {
+            break;
+        }
+    }
+}
+
+void ParameterSweep::sample(int count) {
+    std::mt19937 rng(seed != 0 ? seed : std::random_device{}());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    points.assign(count, nlohmann::json::object());
+    for (const SweepDimension& dimension : dimensions) {
+        std::vector<int> strata(count);
+        std::iota(strata.begin(), strata.end(), 0);
+        if (method == Method::LatinHypercube) {
+            std::shuffle(strata.begin(), strata.end(), rng);
+        }
+        for (int i = 0; i < count; ++i) {
+            double position = method == Method::LatinHypercube ? (strata[i] + unit(rng)) / count : unit(rng);
+            points[i][dimension.name] = valueAt(dimension, position);
+        }
+    }
+}
+
+nlohmann::json ParameterSweep::valueAt(const SweepDimension& dimension, double position) {
+    if (!dimension.range) {
+        size_t index = std::min(dimension.values.size() - 1, static_cast<size_t>(position * dimension.values.size()));
+        return dimension.values[index];
+    }
+    if (dimension.integer) {
+        // Every integer in [low, high] gets an equal share of [0, 1)
+        long long low = std::llround(dimension.low), high = std::llround(dimension.high);
+        return std::min(high, low + static_cast<long long>(position * static_cast<double>(high - low + 1)));
+    }
+    return dimension.low + position * (dimension.high - dimension.low);
+}
+
+nlohmann::json ParameterSweep::parametersFor(const nlohmann::json& base, const nlohmann::json& point) const {
+    nlohmann::json parameters = base;
+    parameters.erase("profiles"); // Tuned profiles would override the swept values
+    bool genetic = parameters.contains("geneticAlgorithmConfiguration") && parameters["geneticAlgorithmConfiguration"].is_object();
+    for (const auto& item : point.items()) {
+        if (genetic) {
+            parameters["geneticAlgorithmConfiguration"][item.key()] = item.value();
+        } else {
+            parameters[item.key()] = item.value();
+        }
+    }
+    return parameters;
+}
+
+void ParameterSweep::run(const Matrix& matrix, nlohmann::json base, ExperimentScheduler& scheduler, const std::string& resultPath,
+                         double timeLimitSeconds) {
+    if (base.contains("configPath")) {
+        base = GeneticAlgorithm::readConfigFile(base.at("configPath").get<std::string>()); // Read once, not once per run
+    }
+    std::vector<nlohmann::json> parameters;
+    for (const nlohmann::json& point : points) {
+        parameters.push_back(parametersFor(base, point));
+    }
+    std::cout << "Sweep of " << solver << ": " << points.size() << " points x " << samples << " samples on "
+              << scheduler.getWorkerCount() << " workers" << std::endl;
+    for (size_t p = 0; p < points.size(); ++p) {
+        LOG_DEBUG("sweep point " << p << ": " << points[p].dump());
+    }
+
+    SolverPool pool(solver); // At most one solver per worker is ever created
+    int size = matrix.getSize();
+    std::string label = solver + " " + std::to_string(size) + "x" + std::to_string(size);
+    for (size_t p = 0; p < points.size(); ++p) {
+        for (int s = 0; s < samples; ++s) {
+            unsigned int runSeed = seed != 0 ? seed + static_cast<unsigned int>(p * samples + s) + 1 : 0;
+            ExperimentJob job;
+            job.label = label + " point " + std::to_string(p + 1) + "/" + std::to_string(points.size()) + " sample " +
+                        std::to_string(s + 1) + "/" + std::to_string(samples);
+            job.run = [&, p, runSeed] {
+                SolveRequest request;
+                request.matrix = &matrix;
+                request.parameters = parameters[p];
+                request.seed = runSeed;
+                if (timeLimitSeconds > 0) {
+                    request.deadline = std::chrono::steady_clock::now() +
+                                       std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+                }
+                SolveResult result = pool.solve(request);
+                ResultsWriter::instance().write(recordFor(result, static_cast<int>(p), size, resultPath));
+
+                std::ostringstream summary;
+                summary << "cost " << (result.cost == INT_MAX ? std::string("none") : std::to_string(result.cost)) << ", "
+                        << std::fixed << std::setprecision(3) << result.timings.solveMs << " ms";
+                return summary.str();
+            };
+            scheduler.submit(job);
+        }
+    }
+    scheduler.run();
+}
+
+ResultRecord ParameterSweep::recordFor(const SolveResult& result, int point, int size, const std::string& resultPath) {
+    ResultRecord record;
+    record.kind = ResultRecord::Kind::Sweep;
+    record.resultPath = resultPath;
+    record.algoName = result.solver;
+    record.problemSize = size;
+    record.time = static_cast<float>(result.timings.solveMs);
+    record.bestCost = result.cost;
+    record.sweepPoint = point;
+    record.counters = SearchCounters::fromStats(result.stats);
+    if (result.parameters.contains("geneticAlgorithmConfiguration")) {
+        const nlohmann::json& ga = result.parameters.at("geneticAlgorithmConfiguration");
+        record.populationSize = ga.value("populationSize", 0);
+        record.mutationRate = ga.value("mutationRate", 0.0f);
+        record.randomRate = ga.value("randomRate", 0.0f);
+        record.crossoverRate = 100 - record.mutationRate - record.randomRate;
+        record.mutationType = ga.value("mutationType", std::string("i"))[0];
+        record.iterationNum = ga.value("iterationNum", 0);
+        record.crossingSegmentSizeRate = ga.value("crossingSegmentSizeRate", 0.0f);
+        record.mutationSegmentSizeRate = ga.value("mutationSegmentSizeRate", 0.0f);
+        record.randomRateNewGen = ga.value("randomRateNewGen", 0.0f);
+    }
+    record.tabuSize = result.parameters.value("tabuSize", 0);
+    record.maxIterations = result.parameters.value("maxIterations", 0);
+    return record;
+}
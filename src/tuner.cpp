@@ -0,0 +1,359 @@
+#include "../include/tuner.h"
+#include "../include/Algorithms/GeneticAlgo.h"
+#include "../include/Algorithms/Solver.h"
+#include "../include/logger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Quantile of the standard normal distribution (Acklam's rational approximation).
+ */
+double normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+    const double low = 0.02425;
+    if (p < low) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) {
+        return -normalQuantile(1 - p);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+/**
+ * @brief Quantile of the chi-square distribution (Wilson-Hilferty approximation).
+ */
+double chiSquareQuantile(double p, double degrees) {
+    double h = 2 / (9 * degrees);
+    double cube = 1 - h + normalQuantile(p) * std::sqrt(h);
+    return degrees * cube * cube * cube;
+}
+
+/**
+ * @brief Quantile of Student's t distribution (Cornish-Fisher expansion, Abramowitz and Stegun 26.7.5).
+ */
+double tQuantile(double p, double degrees) {
+    double z = normalQuantile(p);
+    double z2 = z * z;
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + g1 / degrees + g2 / (degrees * degrees) + g3 / std::pow(degrees, 3) + g4 / std::pow(degrees, 4);
+}
+
+/**
+ * @brief Ranks of the alive candidates in one block, 1 for the cheapest; tied candidates share their mean rank.
+ */
+std::vector<double> blockRanks(const std::vector<double>& costs, const std::vector<int>& alive) {
+    std::vector<size_t> order(alive.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return costs[alive[a]] < costs[alive[b]]; });
+    std::vector<double> ranks(alive.size());
+    for (size_t first = 0; first < order.size();) {
+        size_t last = first;
+        while (last + 1 < order.size() && costs[alive[order[last + 1]]] == costs[alive[order[first]]]) {
+            ++last;
+        }
+        for (size_t i = first; i <= last; ++i) {
+            ranks[order[i]] = (first + last) / 2.0 + 1;
+        }
+        first = last + 1;
+    }
+    return ranks;
+}
+
+/**
+ * @brief Rank sums of the alive candidates over all blocks.
+ */
+std::vector<double> rankSums(const std::vector<std::vector<double>>& costs, const std::vector<int>& alive) {
+    std::vector<double> sums(alive.size(), 0.0);
+    for (const std::vector<double>& block : costs) {
+        std::vector<double> ranks = blockRanks(block, alive);
+        for (size_t i = 0; i < alive.size(); ++i) {
+            sums[i] += ranks[i];
+        }
+    }
+    return sums;
+}
+
+} // namespace
+
+RaceTuner::RaceTuner(const nlohmann::json& specification)
+    : includeBase(specification.value("includeBase", true)),
+      sizeClasses(specification.value("sizeClasses", std::vector<int>())),
+      firstTest(specification.value("firstTest", 5)),
+      maxBlocks(specification.value("maxBlocks", 50)),
+      maxRuns(specification.value("maxRuns", 1000)),
+      alpha(specification.value("alpha", 0.05)),
+      runTimeLimit(specification.value("timeLimitSeconds", 0.0)),
+      seed(specification.value("seed", 0u)) {
+    nlohmann::json sweep = specification;
+    sweep["method"] = specification.value("method", std::string("lhs"));
+    sweep["samples"] = 1;
+    candidates.reset(new ParameterSweep(sweep));
+
+    if (firstTest < 2 || maxBlocks < 1 || maxRuns < 1) {
+        throw std::runtime_error("Tuner needs firstTest >= 2, maxBlocks >= 1 and maxRuns >= 1");
+    }
+    if (!(alpha > 0 && alpha < 0.5)) {
+        throw std::runtime_error("Tuner 'alpha' must be between 0 and 0.5");
+    }
+    if (!std::is_sorted(sizeClasses.begin(), sizeClasses.end()) ||
+        std::adjacent_find(sizeClasses.begin(), sizeClasses.end()) != sizeClasses.end()) {
+        throw std::runtime_error("Tuner 'sizeClasses' must be strictly increasing");
+    }
+}
+
+const std::string& RaceTuner::getSolver() const {
+    return candidates->getSolver();
+}
+
+nlohmann::json RaceTuner::run(const std::vector<std::string>& instancePaths, nlohmann::json base, ExperimentScheduler& scheduler,
+                              double timeLimitSeconds, int candidateListSize) {
+    if (base.contains("configPath")) {
+        base = GeneticAlgorithm::readConfigFile(base.at("configPath").get<std::string>());
+    }
+    base.erase("profiles"); // Tuned again from scratch
+
+    std::vector<std::string> names;
+    std::vector<nlohmann::json> parameters;
+    if (includeBase) {
+        names.push_back("base");
+        parameters.push_back(candidates->parametersFor(base, nlohmann::json::object()));
+    }
+    const std::vector<nlohmann::json>& points = candidates->getPoints();
+    for (size_t i = 0; i < points.size(); ++i) {
+        names.push_back("c" + std::to_string(i + 1));
+        parameters.push_back(candidates->parametersFor(base, points[i]));
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        LOG_DEBUG("tuner candidate " << names[i] << ": " << (i == 0 && includeBase ? std::string("configured") : points[i - includeBase].dump()));
+    }
+
+    // The training set, loaded and prepared once
+    std::vector<std::string> files;
+    for (const std::string& path : instancePaths) {
+        if (std::filesystem::is_directory(path)) {
+            std::vector<std::string> entries;
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.is_regular_file()) entries.push_back(entry.path().string());
+            }
+            std::sort(entries.begin(), entries.end());
+            files.insert(files.end(), entries.begin(), entries.end());
+        } else {
+            files.push_back(path);
+        }
+    }
+    std::vector<std::unique_ptr<Matrix>> matrices;
+    std::vector<std::string> instanceNames;
+    for (const std::string& file : files) {
+        std::unique_ptr<Matrix> matrix(new Matrix(0));
+        try {
+            matrix->readFromFile(file);
+        } catch (const std::exception& e) {
+            LOG_WARNING("tuner skips " << file << ": " << e.what());
+            continue;
+        }
+        if (getSolver() == "bnb") {
+            matrix->buildTransposed();
+        }
+        if (candidateListSize > 0) {
+            matrix->buildCandidateLists(candidateListSize);
+        }
+        matrices.push_back(std::move(matrix));
+        instanceNames.push_back(file.substr(file.find_last_of("/\\") + 1));
+    }
+    if (matrices.empty()) {
+        throw std::runtime_error("Tuner could not load any training instance");
+    }
+
+    // The swept names of the winner are written to its profile, nested like the solver's parameters
+    std::vector<std::string> swept;
+    for (const auto& item : points.front().items()) {
+        swept.push_back(item.key());
+    }
+
+    nlohmann::json tuned = base;
+    tuned["profiles"] = nlohmann::json::array();
+    double limit = runTimeLimit > 0 ? runTimeLimit : timeLimitSeconds;
+    for (size_t c = 0; c <= sizeClasses.size(); ++c) {
+        int lower = c == 0 ? 0 : sizeClasses[c - 1];
+        int upper = c < sizeClasses.size() ? sizeClasses[c] : INT_MAX;
+        std::vector<const Matrix*> instances;
+        nlohmann::json used = nlohmann::json::array();
+        for (size_t i = 0; i < matrices.size(); ++i) {
+            if (matrices[i]->getSize() > lower && matrices[i]->getSize() <= upper) {
+                instances.push_back(matrices[i].get());
+                used.push_back(instanceNames[i]);
+            }
+        }
+        std::string range = upper == INT_MAX ? "more than " + std::to_string(lower) + " cities"
+                                             : std::to_string(lower + 1) + "-" + std::to_string(upper) + " cities";
+        if (instances.empty()) {
+            std::cout << "Size class " << range << ": no training instances, not tuned" << std::endl;
+            continue;
+        }
+        std::cout << "Racing " << names.size() << " " << getSolver() << " candidates on " << instances.size()
+                  << " instances of " << range << std::endl;
+        RaceOutcome outcome = race(instances, names, parameters, scheduler, limit);
+
+        const nlohmann::json& winner = parameters[outcome.winner];
+        bool genetic = winner.contains("geneticAlgorithmConfiguration");
+        const nlohmann::json& source = genetic ? winner.at("geneticAlgorithmConfiguration") : winner;
+        nlohmann::json values = nlohmann::json::object();
+        for (const std::string& name : swept) {
+            if (source.contains(name)) values[name] = source.at(name);
+        }
+        nlohmann::json profile = nlohmann::json::object();
+        if (upper != INT_MAX) {
+            profile["maxSize"] = upper;
+        }
+        if (genetic) {
+            profile["geneticAlgorithmConfiguration"] = values;
+        } else {
+            profile.update(values);
+        }
+        nlohmann::json survivors = nlohmann::json::array();
+        for (int candidate : outcome.survivors) {
+            survivors.push_back(names[candidate]);
+        }
+        profile["race"] = {{"instances", used}, {"candidates", names.size()}, {"blocks", outcome.blocks},
+                           {"runs", outcome.runs}, {"winner", names[outcome.winner]}, {"survivors", survivors}};
+        tuned["profiles"].push_back(profile);
+        std::cout << "Size class " << range << ": " << names[outcome.winner] << " " << values.dump() << " ("
+                  << outcome.survivors.size() << " of " << names.size() << " candidates left after " << outcome.blocks
+                  << " blocks, " << outcome.runs << " runs)" << std::endl;
+    }
+    return tuned;
+}
+
+RaceTuner::RaceOutcome RaceTuner::race(const std::vector<const Matrix*>& instances, const std::vector<std::string>& names,
+                                       const std::vector<nlohmann::json>& parameters, ExperimentScheduler& scheduler,
+                                       double timeLimitSeconds) {
+    RaceOutcome outcome;
+    std::vector<int> alive(parameters.size());
+    std::iota(alive.begin(), alive.end(), 0);
+    std::vector<std::vector<double>> costs;
+    std::mt19937 seeds(seed != 0 ? seed : std::random_device{}());
+    SolverPool pool(getSolver());
+
+    while (alive.size() > 1 && outcome.blocks < maxBlocks && outcome.runs + static_cast<int>(alive.size()) <= maxRuns) {
+        // Every candidate of a block gets the same instance and seed, so their costs differ only by the parameters
+        const Matrix& matrix = *instances[outcome.blocks % instances.size()];
+        unsigned int blockSeed = std::max(1u, static_cast<unsigned int>(seeds()));
+        std::vector<double> block(parameters.size(), std::numeric_limits<double>::quiet_NaN());
+        std::string label = getSolver() + " " + std::to_string(matrix.getSize()) + "x" + std::to_string(matrix.getSize()) +
+                            " block " + std::to_string(outcome.blocks + 1) + " ";
+        for (int candidate : alive) {
+            ExperimentJob job;
+            job.label = label + names[candidate];
+            job.run = [&, candidate, blockSeed] {
+                SolveRequest request;
+                request.matrix = &matrix;
+                request.parameters = parameters[candidate];
+                request.seed = blockSeed;
+                if (timeLimitSeconds > 0) {
+                    request.deadline = std::chrono::steady_clock::now() +
+                                       std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+                }
+                try {
+                    SolveResult result = pool.solve(request);
+                    block[candidate] = result.cost == INT_MAX ? std::numeric_limits<double>::infinity() : result.cost;
+                    std::ostringstream summary;
+                    summary << "cost " << (result.cost == INT_MAX ? std::string("none") : std::to_string(result.cost)) << ", "
+                            << std::fixed << std::setprecision(3) << result.timings.solveMs << " ms";
+                    return summary.str();
+                } catch (const std::exception& e) {
+                    block[candidate] = std::numeric_limits<double>::infinity(); // An invalid configuration ranks last
+                    return std::string("failed: ") + e.what();
+                }
+            };
+            scheduler.submit(job);
+        }
+        scheduler.run();
+        costs.push_back(block);
+        outcome.runs += static_cast<int>(alive.size());
+        ++outcome.blocks;
+
+        if (outcome.blocks >= firstTest) {
+            size_t before = alive.size();
+            alive = friedmanSurvivors(costs, alive, alpha);
+            if (alive.size() < before) {
+                LOG_INFO("tuner block " << outcome.blocks << ": dropped " << before - alive.size() << " candidates, " << alive.size() << " left");
+            }
+        }
+    }
+
+    std::vector<double> sums = rankSums(costs, alive);
+    outcome.winner = alive[std::min_element(sums.begin(), sums.end()) - sums.begin()];
+    outcome.survivors = alive;
+    return outcome;
+}
+
+std::vector<int> RaceTuner::friedmanSurvivors(const std::vector<std::vector<double>>& costs, const std::vector<int>& alive, double alpha) {
+    double k = static_cast<double>(alive.size());
+    double b = static_cast<double>(costs.size());
+    if (alive.size() < 2 || costs.size() < 2) {
+        return alive;
+    }
+
+    std::vector<double> sums(alive.size(), 0.0);
+    double squares = 0; // Sum of the squared ranks
+    for (const std::vector<double>& block : costs) {
+        std::vector<double> ranks = blockRanks(block, alive);
+        for (size_t i = 0; i < alive.size(); ++i) {
+            sums[i] += ranks[i];
+            squares += ranks[i] * ranks[i];
+        }
+    }
+    double tied = b * k * (k + 1) * (k + 1) / 4; // squares if every block were a complete tie
+    if (squares - tied <= 0) {
+        return alive;
+    }
+
+    // Friedman statistic, corrected for ties
+    double spread = 0, sumSquares = 0;
+    for (double sum : sums) {
+        spread += (sum - b * (k + 1) / 2) * (sum - b * (k + 1) / 2);
+        sumSquares += sum * sum;
+    }
+    double statistic = (k - 1) * spread / (squares - tied);
+    if (statistic <= chiSquareQuantile(1 - alpha, k - 1)) {
+        return alive;
+    }
+
+    // Conover's post-hoc test against the best rank sum
+    double degrees = (b - 1) * (k - 1);
+    double critical = tQuantile(1 - alpha / 2, degrees) * std::sqrt(2 * (b * squares - sumSquares) / degrees);
+    double best = *std::min_element(sums.begin(), sums.end());
+    std::vector<int> survivors;
+    for (size_t i = 0; i < alive.size(); ++i) {
+        if (sums[i] - best <= critical) {
+            survivors.push_back(alive[i]);
+        }
+    }
+    return survivors;
+}
@@ -31,30 +31,58 @@ float Util::returnElapsedTimeSeconds() {
     return duration.count() / 1e9;
 }
 
+// Function to queue a result record for the asynchronous results writer
+void Util::saveResultRecord(const ResultRecord& record) {
+    ResultsWriter::instance().write(record);
+}
+
+// Function to set the search counters of the records saved next
+void Util::setSearchCounters(const SearchCounters& counters) {
+    searchCounters = counters;
+}
+
 // Function to save the results to a file
 void Util::saveResults(std::string resultPath, std::string algoName, int problemSize, float time) {
-    std::ofstream file(resultPath, std::ios::app);
-    if (!file) {
-        throw std::runtime_error("Could not open file");
-    }
-    file << algoName << "," << problemSize << "," << time << std::endl;
-    file.close();
+    ResultRecord record;
+    record.kind = ResultRecord::Kind::Timing;
+    record.resultPath = std::move(resultPath);
+    record.algoName = std::move(algoName);
+    record.problemSize = problemSize;
+    record.time = time;
+    record.counters = searchCounters;
+    saveResultRecord(record);
 }
 
 // Function to save the results to a file
 void Util::saveResultsTabuSearch(std::string resultPath, std::string algoName, int problemSize, float time, int bestCost) {
-    std::ofstream file(resultPath, std::ios::app);
-    if (!file) {
-        throw std::runtime_error("Could not open file");
-    }
-    file << algoName << "," << problemSize << "," << time << "," << bestCost << std::endl;
-    file.close();
+    ResultRecord record;
+    record.kind = ResultRecord::Kind::Tabu;
+    record.resultPath = std::move(resultPath);
+    record.algoName = std::move(algoName);
+    record.problemSize = problemSize;
+    record.time = time;
+    record.bestCost = bestCost;
+    record.counters = searchCounters;
+    saveResultRecord(record);
 }
+
 void Util::saveResultsGA(std::string resultPath, std::string algoName, int problemSize, float time, int bestCost, int populationSize, float mutationRate, float crossoverRate, char mutationType, float randomRateNewGen, int iterationNum, float crossingSegmentSizeRate, float mutationSegmentSizeRate,  float randomRate) {
-    std::ofstream file(resultPath, std::ios::app);
-    if (!file) {
-        throw std::runtime_error("Could not open file");
-    }
-    file << algoName << "," << problemSize << "," << time << "," << bestCost << "," << populationSize << "," << mutationRate << "," << randomRate << "," <<  crossoverRate << "," << mutationType << "," << iterationNum  << "," << crossingSegmentSizeRate << "," << mutationSegmentSizeRate << "," << randomRateNewGen << std::endl;
-    file.close();
-}
\ No newline at end of file
+    ResultRecord record;
+    record.kind = ResultRecord::Kind::Genetic;
+    record.resultPath = std::move(resultPath);
+    record.algoName = std::move(algoName);
+    record.problemSize = problemSize;
+    record.time = time;
+    record.bestCost = bestCost;
+    record.populationSize = populationSize;
+    record.mutationRate = mutationRate;
+    record.crossoverRate = crossoverRate;
+    record.mutationType = mutationType;
+    record.randomRateNewGen = randomRateNewGen;
+    record.iterationNum = iterationNum;
+    record.crossingSegmentSizeRate = crossingSegmentSizeRate;
+    record.mutationSegmentSizeRate = mutationSegmentSizeRate;
+    record.randomRate = randomRate;
+    record.counters = searchCounters;
+    saveResultRecord(record);
+}